@@ -2,9 +2,11 @@
 
 #include "base/dfa_helpers.hpp"
 #include "base/levenshtein_dfa.hpp"
+#include "base/levenshtein_dfa_cache.hpp"
 
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace levenshtein_dfa_test
@@ -298,4 +300,53 @@ UNIT_TEST(LevenshteinDFA_PrefixDFASmoke)
     }
   }
 }
+
+UNIT_TEST(LevenshteinDFA_Cache)
+{
+  vector<UniString> const misprints = {MakeUniString("ao")};
+  LevenshteinDFACache cache(1 /* prefixSize */, misprints, 2 /* maxCacheSize */);
+
+  vector<string> const queries = {"xyz", "mosco", "mosca", "oscow", "moscow", "moscowa", "mascow"};
+  for (auto const & pattern : {"moscow", "x"})
+  {
+    for (size_t maxErrors = 0; maxErrors <= 2; ++maxErrors)
+    {
+      auto const s = MakeUniString(pattern);
+      LevenshteinDFA const expected(s, 1 /* prefixSize */, misprints, maxErrors);
+      LevenshteinDFA const missed = cache.Get(s, maxErrors);
+      LevenshteinDFA const hit = cache.Get(s, maxErrors);
+      TEST_EQUAL(missed.GetNumStates(), expected.GetNumStates(), ());
+      TEST_EQUAL(hit.GetNumStates(), expected.GetNumStates(), ());
+      for (auto const & query : queries)
+      {
+        TEST_EQUAL(GetResult(missed, query), GetResult(expected, query), (pattern, maxErrors, query));
+        TEST_EQUAL(GetResult(hit, query), GetResult(expected, query), (pattern, maxErrors, query));
+      }
+    }
+  }
+  TEST_EQUAL(cache.GetHitsCount(), 6, ());
+  TEST_EQUAL(cache.GetMissesCount(), 6, ());
+
+  // The least recently used automata are evicted.
+  cache.Get(MakeUniString("moscow"), 0 /* maxErrors */);
+  TEST_EQUAL(cache.GetMissesCount(), 7, ());
+  cache.Get(MakeUniString("x"), 2 /* maxErrors */);
+  TEST_EQUAL(cache.GetHitsCount(), 7, ());
+
+  // Concurrent access.
+  vector<thread> threads;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    threads.emplace_back([&cache, i]() {
+      for (size_t j = 0; j < 100; ++j)
+      {
+        auto const dfa = cache.Get(MakeUniString(j % 2 == 0 ? "moscow" : "mosco"), 1 + (i + j) % 2);
+        TEST(Accepts(dfa, "mosco"), ());
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+  TEST_EQUAL(cache.GetHitsCount() + cache.GetMissesCount(), 7 + 7 + 400, ());
+}
 }  // namespace levenshtein_dfa_test
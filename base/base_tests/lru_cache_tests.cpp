@@ -15,6 +15,8 @@ public:
   {
   }
 
+  Value const * GetCached(Key const & key) { return m_cache.Get(key); }
+
   Value const & GetValue(Key const & key)
   {
     bool found;
@@ -174,3 +176,25 @@ UNIT_TEST(LruCacheLoaderCallsTest)
   cache.GetValue(1);
   TEST(cache.IsValid(), ());
 }
+
+UNIT_TEST(LruCacheGetTest)
+{
+  using Key = int;
+  using Value = int;
+
+  LruCacheTest<Key, Value> cache(2 /* maxCacheSize */, [](Key k, Value & v) { v = k; } /* loader */);
+  TEST_EQUAL(cache.GetValue(1), 1, ());
+  TEST_EQUAL(cache.GetValue(2), 2, ());
+
+  // A miss neither inserts the key nor evicts the cached ones.
+  TEST(!cache.GetCached(3), ());
+  TEST(cache.IsValid(), ());
+
+  // A hit updates the age, so 2 is evicted instead of 1.
+  TEST(cache.GetCached(1), ());
+  TEST_EQUAL(*cache.GetCached(1), 1, ());
+  TEST_EQUAL(cache.GetValue(4), 4, ());
+  TEST(cache.GetCached(1), ());
+  TEST(!cache.GetCached(2), ());
+  TEST(cache.IsValid(), ());
+}
@@ -1021,6 +1021,17 @@ UNIT_TEST(IsUtf8Test)
 
   TEST(strings::IsASCIIString("YES"), ());
   TEST(strings::IsASCIIString("Nice places in Zhodino.kml"), ());
+  TEST(strings::IsASCIIString(""), ());
+
+  // Non-ASCII symbol in every position of the words and of the tail.
+  std::string const ascii = "0123456789abcdefghij";
+  for (size_t i = 0; i < ascii.size(); ++i)
+  {
+    std::string s = ascii;
+    s[i] = '\xD0';
+    TEST(!strings::IsASCIIString(s), (i));
+    TEST(strings::IsASCIIString(std::string_view(s).substr(i + 1)), (i));
+  }
 }
 
 UNIT_TEST(IsASCIINumericTest)
@@ -94,7 +94,10 @@ public:
   };
 
   LevenshteinDFA() = default;
-  LevenshteinDFA(LevenshteinDFA const &) = delete;
+  // Copying is cheap comparing to the construction: the automaton is stored in a few flat
+  // vectors, so the automata may be cached and copied to the search requests.
+  LevenshteinDFA(LevenshteinDFA const &) = default;
+  LevenshteinDFA & operator=(LevenshteinDFA const &) = default;
   LevenshteinDFA(LevenshteinDFA &&) = default;
   LevenshteinDFA & operator=(LevenshteinDFA &&) = default;
 
@@ -108,7 +111,7 @@ public:
 
   Iterator Begin() const { return Iterator(*this); }
 
-  size_t GetNumStates() const { return m_transitions.size(); }
+  size_t GetNumStates() const { return m_accepting.size(); }
   size_t GetAlphabetSize() const { return m_alphabet.size(); }
 
 private:
@@ -137,12 +140,13 @@ private:
 
   size_t Move(size_t s, UniChar c) const;
 
-  size_t m_size;
-  size_t m_maxErrors;
+  size_t m_size = 0;
+  size_t m_maxErrors = 0;
 
   std::vector<UniChar> m_alphabet;
 
-  std::vector<std::vector<size_t>> m_transitions;
+  // Transitions of the state s are [s * m_alphabet.size(), (s + 1) * m_alphabet.size()).
+  std::vector<size_t> m_transitions;
   std::vector<bool> m_accepting;
   std::vector<size_t> m_errorsMade;
   std::vector<size_t> m_prefixErrorsMade;
@@ -0,0 +1,58 @@
+#include "base/levenshtein_dfa_cache.hpp"
+
+#include <algorithm>
+
+namespace strings
+{
+LevenshteinDFACache::LevenshteinDFACache(size_t prefixSize,
+                                         std::vector<UniString> const & prefixMisprints,
+                                         size_t maxCacheSize)
+  : m_prefixSize(prefixSize), m_prefixMisprints(prefixMisprints), m_cache(maxCacheSize)
+{
+}
+
+LevenshteinDFA LevenshteinDFACache::Get(UniString const & s, size_t maxErrors)
+{
+  LevenshteinDFACacheKey key;
+  key.m_s = s;
+  key.m_maxErrors = maxErrors;
+
+  DFAPtr dfa;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool found = false;
+    // LruCache inserts an empty value for a missing key, it is filled below.
+    dfa = m_cache.Find(key, found);
+    if (dfa)
+      ++m_hitsCount;
+    else
+      ++m_missesCount;
+  }
+
+  if (!dfa)
+  {
+    dfa = std::make_shared<LevenshteinDFA const>(s, std::min(m_prefixSize, s.size()),
+                                                 m_prefixMisprints, maxErrors);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool found = false;
+    auto & value = m_cache.Find(key, found);
+    if (!value)
+      value = dfa;
+  }
+
+  return *dfa;
+}
+
+uint64_t LevenshteinDFACache::GetHitsCount() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_hitsCount;
+}
+
+uint64_t LevenshteinDFACache::GetMissesCount() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_missesCount;
+}
+}  // namespace strings
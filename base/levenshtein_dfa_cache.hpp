@@ -0,0 +1,83 @@
+#pragma once
+
+#include "base/levenshtein_dfa.hpp"
+#include "base/lru_cache.hpp"
+#include "base/string_utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace strings
+{
+struct LevenshteinDFACacheKey
+{
+  bool operator==(LevenshteinDFACacheKey const & rhs) const
+  {
+    return m_maxErrors == rhs.m_maxErrors && m_s == rhs.m_s;
+  }
+
+  UniString m_s;
+  size_t m_maxErrors = 0;
+};
+}  // namespace strings
+
+namespace std
+{
+template <>
+struct hash<strings::LevenshteinDFACacheKey>
+{
+  size_t operator()(strings::LevenshteinDFACacheKey const & key) const
+  {
+    // FNV-1a.
+    uint64_t h = 14695981039346656037ULL;
+    auto const add = [&h](uint64_t v) {
+      h ^= v;
+      h *= 1099511628211ULL;
+    };
+    for (auto const c : key.m_s)
+      add(c);
+    add(key.m_maxErrors);
+    return static_cast<size_t>(h);
+  }
+};
+}  // namespace std
+
+namespace strings
+{
+// Bounded cache of LevenshteinDFA automata built with the same prefix size and prefix misprints.
+// The automata are keyed by the pattern and the number of allowed errors. Search builds an
+// automaton for every query token and the same tokens come again and again, e.g. all the tokens
+// but the last one are the same for the successive queries while the user types.
+// The automaton does not depend on the way it is used, so the same automaton serves full and
+// prefix (wrapped into PrefixDFAModifier) tokens.
+//
+// *NOTE* The class *IS* thread-safe. Automata are built out of the lock.
+class LevenshteinDFACache
+{
+public:
+  LevenshteinDFACache(size_t prefixSize, std::vector<UniString> const & prefixMisprints,
+                      size_t maxCacheSize);
+
+  // Returns the automaton for |s| which is the same as
+  // LevenshteinDFA(s, min(prefixSize, s.size()), prefixMisprints, maxErrors).
+  LevenshteinDFA Get(UniString const & s, size_t maxErrors);
+
+  uint64_t GetHitsCount() const;
+  uint64_t GetMissesCount() const;
+
+private:
+  using DFAPtr = std::shared_ptr<LevenshteinDFA const>;
+
+  size_t const m_prefixSize;
+  std::vector<UniString> const m_prefixMisprints;
+
+  mutable std::mutex m_mutex;
+  LruCache<LevenshteinDFACacheKey, DFAPtr> m_cache;
+  uint64_t m_hitsCount = 0;
+  uint64_t m_missesCount = 0;
+};
+}  // namespace strings
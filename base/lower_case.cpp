@@ -4,6 +4,8 @@
 
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+
 namespace strings
 {
 
@@ -176,6 +178,17 @@ static size_t w(UniChar c, UniChar * buf)
 
 void MakeLowerCaseInplace(UniString & s)
 {
+  // ASCII fast path: no table lookups and no reallocation.
+  if (std::all_of(s.begin(), s.end(), [](UniChar c) { return c < 0x80; }))
+  {
+    for (auto & c : s)
+    {
+      if (c >= 'A' && c <= 'Z')
+        c += 'a' - 'A';
+    }
+    return;
+  }
+
   size_t const size = s.size();
 
   UniString r;
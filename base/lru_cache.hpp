@@ -45,6 +45,17 @@ public:
     return value;
   }
 
+  // Find value by @key without inserting it on a miss. Returns nullptr if there is no @key.
+  Value * Get(Key const & key)
+  {
+    auto const it = m_cache.find(key);
+    if (it == m_cache.end())
+      return nullptr;
+
+    m_keyAge.UpdateAge(key);
+    return &it->second;
+  }
+
   void Clear()
   {
     m_cache.clear();
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <iterator>
 
@@ -285,9 +286,21 @@ std::u16string ToUtf16(std::string_view utf8)
 
 bool IsASCIIString(std::string_view sv)
 {
-  for (auto c : sv)
+  // Check 8 bytes at once, the loop is vectorized by the compiler.
+  uint64_t constexpr kHighBits = 0x8080808080808080ULL;
+  size_t const size = sv.size();
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+  {
+    uint64_t word;
+    std::memcpy(&word, sv.data() + i, sizeof(word));
+    if (word & kHighBits)
+      return false;
+  }
+
+  for (; i < size; ++i)
   {
-    if (c & 0x80)
+    if (sv[i] & 0x80)
       return false;
   }
   return true;
@@ -5,6 +5,8 @@
 #include "coding/varint.hpp"
 #include "coding/writer.hpp"
 
+#include <atomic>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -105,4 +107,77 @@ UNIT_TEST(MapUint32Val_Smoke)
     }
   }
 }
+
+UNIT_TEST(MapUint32Val_GetManyAndBoundedCache)
+{
+  // Sparse ids to check that ids without values are skipped.
+  uint32_t const kCount = 1000;
+  BufferT buffer;
+  {
+    BuilderT builder;
+    for (uint32_t i = 0; i < kCount; ++i)
+      builder.Put(i * 3, i * 7);
+
+    MemWriter writer(buffer);
+    builder.Freeze(writer, [](Writer & w, BuilderT::Iter begin, BuilderT::Iter end)
+    {
+      for (auto it = begin; it != end; ++it)
+        WriteToSink(w, *it);
+    }, 16 /* blockSize */);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  atomic<uint32_t> decodedBlocks{0};
+  auto table = MapT::Load(reader, [&decodedBlocks](NonOwningReaderSource & source, uint32_t blockSize,
+                                                   ValuesT & values)
+  {
+    ++decodedBlocks;
+    values.reserve(blockSize);
+    while (source.Size() > 0 && values.size() < blockSize)
+      values.push_back(ReadPrimitiveFromSource<uint32_t>(source));
+  }, 4 /* maxCachedBlocks */);
+  TEST(table.get(), ());
+
+  vector<uint32_t> ids;
+  for (uint32_t id = 0; id < 3 * kCount; ++id)
+    ids.push_back(id);
+
+  uint32_t found = 0;
+  table->GetMany(ids, [&](uint32_t id, uint32_t value)
+  {
+    TEST_EQUAL(id % 3, 0, ());
+    TEST_EQUAL(value, id / 3 * 7, ());
+    ++found;
+  });
+  TEST_EQUAL(found, kCount, ());
+  // Every block is decoded once.
+  TEST_EQUAL(decodedBlocks, (kCount + 15) / 16, ());
+
+  // Only the last 4 blocks are in the cache.
+  decodedBlocks = 0;
+  uint32_t value;
+  TEST(table->Get((kCount - 1) * 3, value), ());
+  TEST_EQUAL(decodedBlocks, 0, ());
+  TEST(table->Get(0, value), ());
+  TEST_EQUAL(value, 0, ());
+  TEST_EQUAL(decodedBlocks, 1, ());
+
+  vector<thread> threads;
+  atomic<uint32_t> errors{0};
+  for (uint32_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&table, &errors, t]()
+    {
+      for (uint32_t i = t; i < kCount; i += 2)
+      {
+        uint32_t res;
+        if (!table->Get(i * 3, res) || res != i * 7)
+          ++errors;
+      }
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+  TEST_EQUAL(errors, 0, ());
+}
 } // namespace map_uint32_tests
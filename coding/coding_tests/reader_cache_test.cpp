@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace std;
@@ -46,3 +47,74 @@ UNIT_TEST(CacheReaderRandomTest)
     TEST_EQUAL(readMem, readCache, (pos, len, i));
   }
 }
+
+UNIT_TEST(CacheReaderStatsTest)
+{
+  vector<char> data(1 << 14);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  MemReader memReader(&data[0], data.size());
+
+  // 8 pages of 1kb.
+  ReaderCache<MemReader const> cache(10, 3);
+  string buffer(100, '0');
+
+  cache.Read(memReader, 0, &buffer[0], buffer.size());
+  cache.Read(memReader, 100, &buffer[0], buffer.size());
+  TEST_EQUAL(cache.GetStats().m_readCalls, 2, ());
+  TEST_EQUAL(cache.GetStats().m_bytesRequested, 200, ());
+  TEST_EQUAL(cache.GetStats().m_pageMisses, 1, ());
+  TEST_EQUAL(cache.GetStats().m_pageHits, 1, ());
+  TEST_ALMOST_EQUAL_ULPS(cache.GetStats().GetHitRate(), 0.5, ());
+
+  // The read crosses the page boundary.
+  cache.Read(memReader, 1000, &buffer[0], buffer.size());
+  TEST_EQUAL(cache.GetStats().m_pageMisses, 2, ());
+  TEST_EQUAL(cache.GetStats().m_pageHits, 2, ());
+  TEST_EQUAL(buffer, string(data.begin() + 1000, data.begin() + 1100), ());
+}
+
+UNIT_TEST(SharedReaderCacheTest)
+{
+  vector<char> data(100000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 253);
+
+  auto const cache = SharedReaderCache::Get("SharedReaderCacheTest", data.size(), 10, 6);
+  TEST_EQUAL(cache, SharedReaderCache::Get("SharedReaderCacheTest", data.size(), 10, 6), ());
+  TEST_NOT_EQUAL(cache, SharedReaderCache::Get("SharedReaderCacheTest", data.size(), 12, 6), ());
+  TEST_NOT_EQUAL(cache, SharedReaderCache::Get("SharedReaderCacheTest", data.size(), 10, 8), ());
+
+  size_t constexpr kThreadsCount = 4;
+  size_t constexpr kReadsCount = 20000;
+  vector<thread> threads;
+  vector<uint8_t> results(kThreadsCount, 0);
+  for (size_t t = 0; t < kThreadsCount; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      MemReader memReader(&data[0], data.size());
+      mt19937 rng(static_cast<uint32_t>(t));
+      bool ok = true;
+      for (size_t i = 0; i < kReadsCount; ++i)
+      {
+        size_t const pos = rng() % data.size();
+        size_t const len = min(static_cast<size_t>(1 + (rng() % 2000)), data.size() - pos);
+        string read(len, '0');
+        cache->Read(memReader, pos, &read[0], len);
+        ok = ok && equal(read.begin(), read.end(), data.begin() + pos);
+      }
+      results[t] = ok ? 1 : 0;
+    });
+  }
+  for (auto & t : threads)
+    t.join();
+
+  for (size_t t = 0; t < kThreadsCount; ++t)
+    TEST_EQUAL(results[t], 1, (t));
+
+  auto const stats = cache->GetStats();
+  TEST_EQUAL(stats.m_readCalls, kThreadsCount * kReadsCount, ());
+  TEST_GREATER(stats.m_pageHits, 0, ());
+  TEST_GREATER(stats.m_pageMisses, 0, ());
+}
@@ -31,10 +31,11 @@ string GenerateRandomString(Engine & engine)
   return s;
 }
 
-void DumpStrings(vector<string> const & strings, uint64_t blockSize, vector<uint8_t> & buffer)
+void DumpStrings(vector<string> const & strings, uint64_t blockSize, vector<uint8_t> & buffer,
+                 TextStorageCodec codec = TextStorageCodec::BWT, string const & dictionary = {})
 {
   MemWriter<vector<uint8_t>> writer(buffer);
-  BlockedTextStorageWriter<decltype(writer)> ts(writer, blockSize);
+  BlockedTextStorageWriter<decltype(writer)> ts(writer, blockSize, codec, dictionary);
   for (auto const & s : strings)
     ts.Append(s);
 }
@@ -129,4 +130,36 @@ UNIT_TEST(TextStorage_Random)
   for (size_t i = ts.GetNumStrings() - 1; i < ts.GetNumStrings(); --i)
     TEST_EQUAL(ts.ExtractString(i), strings[i], ());
 }
+
+UNIT_TEST(TextStorage_Deflate)
+{
+  int const kSeed = 42;
+  int const kNumStrings = 1000;
+  int const kBlockSize = 100;
+  mt19937 engine(kSeed);
+
+  vector<string> strings;
+  for (int i = 0; i < kNumStrings; ++i)
+    strings.push_back(i % 3 == 0 ? GenerateRandomString(engine) : "Mo-Fr 09:00-18:00");
+
+  auto const dictionary = MakeTextStorageDictionary(strings);
+  TEST_EQUAL(dictionary, "Mo-Fr 09:00-18:00", ());
+
+  for (auto const & dict : {string(), dictionary})
+  {
+    vector<uint8_t> buffer;
+    DumpStrings(strings, kBlockSize, buffer, TextStorageCodec::Deflate, dict);
+
+    MemReader reader(buffer.data(), buffer.size());
+    BlockedTextStorageIndex index;
+    index.Read(reader);
+    TEST_EQUAL(index.GetCodec(), TextStorageCodec::Deflate, ());
+    TEST_EQUAL(index.GetDictionary(), dict, ());
+
+    BlockedTextStorage<decltype(reader)> ts(reader);
+    TEST_EQUAL(ts.GetNumStrings(), strings.size(), ());
+    for (size_t i = ts.GetNumStrings() - 1; i < ts.GetNumStrings(); --i)
+      TEST_EQUAL(ts.ExtractString(i), strings[i], ());
+  }
+}
 }  // namespace
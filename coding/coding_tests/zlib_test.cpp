@@ -104,4 +104,33 @@ UNIT_TEST(GZip_ExtraDataInBuffer)
   // inflate should decompress everything but the last byte.
   TEST_EQUAL(s, "Hello, World!", ());
 }
+
+UNIT_TEST(ZLib_Dictionary)
+{
+  string const dictionary = "opening_hours=Mo-Fr 09:00-18:00; Sa 10:00-16:00";
+  string const original = "Mo-Fr 09:00-18:00; Sa 10:00-16:00; Su off";
+
+  Deflate const deflate(Deflate::Format::ZLib, Deflate::Level::BestSpeed, dictionary);
+  Deflate const deflateNoDict(Deflate::Format::ZLib, Deflate::Level::BestSpeed);
+
+  string compressed;
+  TEST(deflate(original, back_inserter(compressed)), ());
+  string compressedNoDict;
+  TEST(deflateNoDict(original, back_inserter(compressedNoDict)), ());
+  TEST_LESS(compressed.size(), compressedNoDict.size(), ());
+
+  {
+    string decompressed;
+    Inflate const inflate(Inflate::Format::ZLib, dictionary);
+    TEST(inflate(compressed, back_inserter(decompressed)), ());
+    TEST_EQUAL(original, decompressed, ());
+  }
+
+  {
+    // Dictionary is required.
+    string decompressed;
+    Inflate const inflate(Inflate::Format::ZLib);
+    TEST(!inflate(compressed, back_inserter(decompressed)), ());
+  }
+}
 }  // namespace
@@ -1,10 +1,12 @@
 #include "coding/file_reader.hpp"
 
-#include "coding/reader_cache.hpp"
 #include "coding/internal/file_data.hpp"
 
 #include "base/logging.hpp"
 
+#include <algorithm>
+#include <memory>
+
 #ifndef LOG_FILE_READER_STATS
 #define LOG_FILE_READER_STATS 0
 #endif // LOG_FILE_READER_STATS
@@ -21,18 +23,25 @@ uint32_t const FileReader::kDefaultLogPageCount = 4; // page count is 2^4 = 16,
 class FileReader::FileReaderData
 {
 public:
-  FileReaderData(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
-    : m_fileData(fileName), m_readerCache(logPageSize, logPageCount)
+  FileReaderData(std::string const & fileName, CacheParams const & params)
+    : m_fileData(fileName)
   {
-#if LOG_FILE_READER_STATS
-    m_readCallCount = 0;
-#endif
+    if (params.m_shared)
+    {
+      m_sharedCache = SharedReaderCache::Get(fileName, m_fileData.Size(), params.m_logPageSize,
+                                             params.m_logPageCount);
+    }
+    else
+    {
+      m_readerCache = std::make_unique<ReaderCache<FileDataWithCachedSize>>(params.m_logPageSize,
+                                                                            params.m_logPageCount);
+    }
   }
 
   ~FileReaderData()
   {
 #if LOG_FILE_READER_STATS
-    LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache.GetStatsStr()));
+    LOG(LINFO, ("FileReader", m_fileData.GetName(), GetCacheStats()));
 #endif
   }
 
@@ -43,11 +52,21 @@ public:
 #if LOG_FILE_READER_STATS
     if (((++m_readCallCount) & LOG_FILE_READER_EVERY_N_READS_MASK) == 0)
     {
-      LOG(LINFO, ("FileReader", m_fileData.GetName(), m_readerCache.GetStatsStr()));
+      LOG(LINFO, ("FileReader", m_fileData.GetName(), GetCacheStats()));
     }
 #endif
 
-    return m_readerCache.Read(m_fileData, pos, p, size);
+    if (m_sharedCache)
+      m_sharedCache->Read(m_fileData, pos, p, size);
+    else
+      m_readerCache->Read(m_fileData, pos, p, size);
+  }
+
+  void Prefetch(uint64_t pos, size_t size) { m_fileData.Prefetch(pos, size); }
+
+  ReaderCacheStats GetCacheStats() const
+  {
+    return m_sharedCache ? m_sharedCache->GetStats() : m_readerCache->GetStats();
   }
 
 private:
@@ -66,10 +85,11 @@ private:
   };
 
   FileDataWithCachedSize m_fileData;
-  ReaderCache<FileDataWithCachedSize, LOG_FILE_READER_STATS> m_readerCache;
+  std::unique_ptr<ReaderCache<FileDataWithCachedSize>> m_readerCache;
+  std::shared_ptr<SharedReaderCache> m_sharedCache;
 
 #if LOG_FILE_READER_STATS
-  uint32_t m_readCallCount;
+  uint32_t m_readCallCount = 0;
 #endif
 };
 
@@ -79,10 +99,15 @@ FileReader::FileReader(std::string const & fileName)
 }
 
 FileReader::FileReader(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount)
+  : FileReader(fileName, CacheParams{logPageSize, logPageCount, false /* shared */})
+{
+}
+
+FileReader::FileReader(std::string const & fileName, CacheParams const & params)
   : ModelReader(fileName)
-  , m_logPageSize(logPageSize)
-  , m_logPageCount(logPageCount)
-  , m_fileData(std::make_shared<FileReaderData>(fileName, logPageSize, logPageCount))
+  , m_logPageSize(params.m_logPageSize)
+  , m_logPageCount(params.m_logPageCount)
+  , m_fileData(std::make_shared<FileReaderData>(fileName, params))
   , m_offset(0)
   , m_size(m_fileData->Size())
 {
@@ -105,6 +130,18 @@ void FileReader::Read(uint64_t pos, void * p, size_t size) const
   m_fileData->Read(m_offset + pos, p, size);
 }
 
+void FileReader::Prefetch(uint64_t pos, size_t size) const
+{
+  if (size == 0 || pos >= Size())
+    return;
+  m_fileData->Prefetch(m_offset + pos, static_cast<size_t>(std::min<uint64_t>(size, Size() - pos)));
+}
+
+ReaderCacheStats FileReader::GetCacheStats() const
+{
+  return m_fileData->GetCacheStats();
+}
+
 FileReader FileReader::SubReader(uint64_t pos, uint64_t size) const
 {
   CheckPosAndSize(pos, size);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "coding/reader.hpp"
+#include "coding/reader_cache.hpp"
 
 #include "base/base.hpp"
 
@@ -18,17 +19,31 @@ public:
   static uint32_t const kDefaultLogPageSize;
   static uint32_t const kDefaultLogPageCount;
 
+  struct CacheParams
+  {
+    uint32_t m_logPageSize = kDefaultLogPageSize;
+    uint32_t m_logPageCount = kDefaultLogPageCount;
+    // When true, cached pages are shared with all readers of the same file
+    // which use shared cache too, see SharedReaderCache.
+    bool m_shared = false;
+  };
+
   explicit FileReader(std::string const & fileName);
   FileReader(std::string const & fileName, uint32_t logPageSize, uint32_t logPageCount);
+  FileReader(std::string const & fileName, CacheParams const & params);
 
   // Reader overrides:
   uint64_t Size() const override { return m_size; }
   void Read(uint64_t pos, void * p, size_t size) const override;
   std::unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
+  void Prefetch(uint64_t pos, size_t size) const override;
 
   FileReader SubReader(uint64_t pos, uint64_t size) const;
   uint64_t GetOffset() const { return m_offset; }
 
+  // Returns stats of the page cache, which is common for the reader and all its subreaders.
+  ReaderCacheStats GetCacheStats() const;
+
 protected:
   // Used in special derived readers.
   void SetOffsetAndSize(uint64_t offset, uint64_t size);
@@ -21,6 +21,7 @@
 #ifdef OMIM_OS_WINDOWS
 #include <io.h>
 #else
+#include <fcntl.h>   // posix_fadvise
 #include <unistd.h>  // ftruncate
 #endif
 
@@ -114,6 +115,18 @@ void FileData::Read(uint64_t pos, void * p, size_t size)
     MYTHROW(Reader::ReadException, (GetErrorProlog(), bytesRead, pos, size));
 }
 
+void FileData::Prefetch(uint64_t pos, size_t size)
+{
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_ANDROID)
+  // Do not spam the log: it's only a hint and it is called on hot paths.
+  UNUSED_VALUE(posix_fadvise(fileno(m_File), static_cast<off_t>(pos), static_cast<off_t>(size),
+                             POSIX_FADV_WILLNEED));
+#else
+  UNUSED_VALUE(pos);
+  UNUSED_VALUE(size);
+#endif
+}
+
 uint64_t FileData::Pos() const
 {
   int64_t const pos = ftell64(m_File);
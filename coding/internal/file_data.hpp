@@ -29,6 +29,8 @@ public:
   void Seek(uint64_t pos);
 
   void Read(uint64_t pos, void * p, size_t size);
+  /// Asks OS to read [pos, pos + size) into the page cache in background. Errors are ignored.
+  void Prefetch(uint64_t pos, size_t size);
   void Write(void const * p, size_t size);
 
   void Flush();
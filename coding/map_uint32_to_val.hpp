@@ -10,6 +10,7 @@
 #include "base/assert.hpp"
 #include "base/checked_cast.hpp"
 #include "base/logging.hpp"
+#include "base/lru_cache.hpp"
 
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -26,9 +27,10 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <type_traits>
-#include <unordered_map>
 #include <vector>
 
 // A data structure that allows storing a map from small 32-bit integers (the main use
@@ -58,6 +60,7 @@
 // encoded by block encoding callback.
 //
 // On Get call m_blockSize consecutive variables are decoded and cached in RAM.
+// The cache is bounded by the number of blocks and is shared by all threads.
 
 template <typename Value>
 class MapUint32ToValue
@@ -69,6 +72,8 @@ class MapUint32ToValue
 public:
   using ReadBlockCallback = std::function<void(NonOwningReaderSource &, uint32_t, std::vector<Value> &)>;
 
+  static size_t constexpr kDefaultMaxCachedBlocks = 256;
+
   struct Header
   {
     uint16_t Read(Reader & reader)
@@ -100,31 +105,27 @@ public:
     uint32_t m_endOffset = 0;
   };
 
-  MapUint32ToValue(Reader & reader, ReadBlockCallback const & readBlockCallback)
-    : m_reader(reader), m_readBlockCallback(readBlockCallback)
+  MapUint32ToValue(Reader & reader, ReadBlockCallback const & readBlockCallback,
+                   size_t maxCachedBlocks = kDefaultMaxCachedBlocks)
+    : m_reader(reader), m_readBlockCallback(readBlockCallback), m_cache(maxCachedBlocks)
   {
   }
 
-  /// @name Tries to get |value| for key identified by |id|.
+  /// @name Tries to get |value| for key identified by |id|. Both methods are thread-safe.
   /// @returns false if table does not have entry for this id.
   /// @{
+  /// Decodes and caches the whole block of |id|.
   [[nodiscard]] bool Get(uint32_t id, Value & value)
   {
     if (id >= m_ids.size() || !m_ids[id])
       return false;
 
     uint32_t const rank = static_cast<uint32_t>(m_ids.rank(id));
-    uint32_t const base = rank / m_header.m_blockSize;
-    uint32_t const offset = rank % m_header.m_blockSize;
-
-    auto & entry = m_cache[base];
-    if (entry.empty())
-      entry = GetImpl(rank, m_header.m_blockSize);
-
-    value = entry[offset];
+    value = (*GetBlock(rank / m_header.m_blockSize))[rank % m_header.m_blockSize];
     return true;
   }
 
+  /// Decodes the block up to |id| and doesn't touch the cache.
   [[nodiscard]] bool GetThreadsafe(uint32_t id, Value & value) const
   {
     if (id >= m_ids.size() || !m_ids[id])
@@ -140,13 +141,41 @@ public:
   }
   /// @}
 
+  /// Calls |fn(id, value)| for all |sortedIds| which have values in the table.
+  /// Every block is decoded (or taken from cache) once per call, so it's much cheaper
+  /// than a sequence of Get calls for a batch of ids. Thread-safe.
+  template <typename Fn>
+  void GetMany(std::vector<uint32_t> const & sortedIds, Fn && fn)
+  {
+    ASSERT(std::is_sorted(sortedIds.begin(), sortedIds.end()), ());
+
+    BlockPtr block;
+    uint32_t blockIx = std::numeric_limits<uint32_t>::max();
+    for (auto const id : sortedIds)
+    {
+      if (id >= m_ids.size() || !m_ids[id])
+        continue;
+
+      uint32_t const rank = static_cast<uint32_t>(m_ids.rank(id));
+      uint32_t const base = rank / m_header.m_blockSize;
+      if (!block || base != blockIx)
+      {
+        block = GetBlock(base);
+        blockIx = base;
+      }
+      fn(id, (*block)[rank % m_header.m_blockSize]);
+    }
+  }
+
   // Loads MapUint32ToValue instance. Note that |reader| must be alive
   // until the destruction of loaded table. Returns nullptr if
   // MapUint32ToValue can't be loaded.
   // It's guaranteed that |readBlockCallback| will not be called for empty block.
-  static std::unique_ptr<MapUint32ToValue> Load(Reader & reader, ReadBlockCallback const & readBlockCallback)
+  // |maxCachedBlocks| limits the number of decoded blocks kept in RAM.
+  static std::unique_ptr<MapUint32ToValue> Load(Reader & reader, ReadBlockCallback const & readBlockCallback,
+                                                size_t maxCachedBlocks = kDefaultMaxCachedBlocks)
   {
-    auto table = std::make_unique<MapUint32ToValue>(reader, readBlockCallback);
+    auto table = std::make_unique<MapUint32ToValue>(reader, readBlockCallback, maxCachedBlocks);
     if (!table->Init())
       return {};
     return table;
@@ -167,6 +196,26 @@ public:
   uint64_t Count() const { return m_ids.num_ones(); }
 
 private:
+  using BlockPtr = std::shared_ptr<std::vector<Value> const>;
+
+  BlockPtr GetBlock(uint32_t base)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_cacheMutex);
+      if (auto const * block = m_cache.Get(base))
+        return *block;
+    }
+
+    // Decode without the lock, concurrent decoding of the same block is harmless.
+    auto block = std::make_shared<std::vector<Value> const>(
+        GetImpl(base * m_header.m_blockSize, m_header.m_blockSize));
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    bool found;
+    m_cache.Find(base, found) = block;
+    return block;
+  }
+
   /// @param[in] upperSize Read until this size. Can be one of: \n
   /// - m_header.m_blockSize for the regular Get version with cache \n
   /// - index + 1 for the GetThreadsafe version without cache, to break when needed element is readed \n
@@ -227,7 +276,8 @@ private:
 
   ReadBlockCallback m_readBlockCallback;
 
-  std::unordered_map<uint32_t, std::vector<Value>> m_cache;
+  LruCache<uint32_t, BlockPtr> m_cache;
+  std::mutex m_cacheMutex;
 };
 
 template <typename Value>
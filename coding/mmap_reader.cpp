@@ -4,6 +4,7 @@
 
 #include "std/target_os.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 #ifdef OMIM_OS_WINDOWS
@@ -136,6 +137,24 @@ std::unique_ptr<Reader> MmapReader::CreateSubReader(uint64_t pos, uint64_t size)
   return std::unique_ptr<Reader>(new MmapReader(*this, m_offset + pos, size));
 }
 
+void MmapReader::Prefetch(uint64_t pos, size_t size) const
+{
+#ifndef OMIM_OS_WINDOWS
+  if (size == 0 || pos >= Size())
+    return;
+  size = static_cast<size_t>(std::min<uint64_t>(size, Size() - pos));
+
+  // madvise requires a page-aligned address.
+  static uintptr_t const pageMask = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1;
+  auto const beg = reinterpret_cast<uintptr_t>(m_data->m_memory + m_offset + pos);
+  auto const alignedBeg = beg & ~pageMask;
+  UNUSED_VALUE(madvise(reinterpret_cast<void *>(alignedBeg), size + (beg - alignedBeg), MADV_WILLNEED));
+#else
+  UNUSED_VALUE(pos);
+  UNUSED_VALUE(size);
+#endif
+}
+
 uint8_t * MmapReader::Data() const
 {
   return m_data->m_memory;
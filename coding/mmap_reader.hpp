@@ -23,6 +23,7 @@ public:
   uint64_t Size() const override;
   void Read(uint64_t pos, void * p, size_t size) const override;
   std::unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const override;
+  void Prefetch(uint64_t pos, size_t size) const override;
 
   /// Direct file/memory access
   uint8_t * Data() const;
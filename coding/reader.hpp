@@ -28,6 +28,10 @@ public:
   virtual void Read(uint64_t pos, void * p, size_t size) const = 0;
   virtual std::unique_ptr<Reader> CreateSubReader(uint64_t pos, uint64_t size) const = 0;
 
+  /// Hint that [pos, pos + size) is going to be read soon, so the data may be fetched
+  /// from the storage asynchronously. Does nothing by default.
+  virtual void Prefetch(uint64_t /* pos */, size_t /* size */) const {}
+
   void ReadAsString(std::string & s) const;
 };
 
@@ -119,6 +123,8 @@ public:
     m_p->Read(pos, p, size);
   }
 
+  void Prefetch(uint64_t pos, size_t size) const { m_p->Prefetch(pos, size); }
+
   void ReadAsString(std::string & s) const { m_p->ReadAsString(s); }
 
   ReaderPtr<Reader> SubReader(uint64_t pos, uint64_t size) const
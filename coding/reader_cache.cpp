@@ -0,0 +1,147 @@
+#include "coding/reader_cache.hpp"
+
+#include <limits>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+namespace
+{
+uint64_t constexpr kEmptyKey = std::numeric_limits<uint64_t>::max();
+
+uint32_t Hash(uint64_t key)
+{
+  uint32_t x = static_cast<uint32_t>(key) ^ static_cast<uint32_t>(key >> 32);
+  x = (x ^ 61) ^ (x >> 16);
+  x = x + (x << 3);
+  x = x ^ (x >> 4);
+  x = x * 0x27d4eb2d;
+  x = x ^ (x >> 15);
+  return x;
+}
+}  // namespace
+
+std::string DebugPrint(ReaderCacheStats const & stats)
+{
+  std::ostringstream out;
+  out << "ReaderCacheStats [ ReadCalls: " << stats.m_readCalls
+      << " BytesRequested: " << stats.m_bytesRequested
+      << " PageHits: " << stats.m_pageHits
+      << " PageMisses: " << stats.m_pageMisses
+      << " HitRate: " << stats.GetHitRate() << " ]";
+  return out.str();
+}
+
+namespace impl
+{
+PageCache::PageCache(uint32_t logPageSize, uint32_t logPageCount) : m_logPageSize(logPageSize)
+{
+  ASSERT_LESS(logPageSize, 32, ());
+  ASSERT_LESS(logPageCount, 32, ());
+
+  m_logWays = std::min(kLogWays, logPageCount);
+  uint32_t const setCount = 1U << (logPageCount - m_logWays);
+  m_setMask = setCount - 1;
+
+  size_t const pageCount = size_t{1} << logPageCount;
+  m_keys.assign(pageCount, kEmptyKey);
+  m_referenced.assign(pageCount, false);
+  m_hands.assign(setCount, 0);
+  m_pages.resize(pageCount);
+}
+
+size_t PageCache::SetBegin(uint64_t pageNum) const
+{
+  return static_cast<size_t>(Hash(pageNum) & m_setMask) << m_logWays;
+}
+
+char const * PageCache::Find(uint64_t pageNum)
+{
+  size_t const beg = SetBegin(pageNum);
+  size_t const end = beg + (size_t{1} << m_logWays);
+  for (size_t i = beg; i < end; ++i)
+  {
+    if (m_keys[i] == pageNum)
+    {
+      m_referenced[i] = true;
+      return m_pages[i].get();
+    }
+  }
+  return nullptr;
+}
+
+char * PageCache::Insert(uint64_t pageNum)
+{
+  size_t const beg = SetBegin(pageNum);
+  uint32_t const waysMask = (1U << m_logWays) - 1;
+  uint8_t & hand = m_hands[beg >> m_logWays];
+
+  // CLOCK: skip recently used slots clearing their reference bits.
+  while (m_referenced[beg + hand])
+  {
+    m_referenced[beg + hand] = false;
+    hand = static_cast<uint8_t>((hand + 1) & waysMask);
+  }
+
+  size_t const victim = beg + hand;
+  hand = static_cast<uint8_t>((hand + 1) & waysMask);
+
+  m_keys[victim] = pageNum;
+  m_referenced[victim] = true;
+  if (!m_pages[victim])
+    m_pages[victim] = std::make_unique<char[]>(PageSize());
+  return m_pages[victim].get();
+}
+}  // namespace impl
+
+SharedReaderCache::SharedReaderCache(uint32_t logPageSize, uint32_t logPageCount)
+  : m_logPageSize(logPageSize)
+{
+  uint32_t const logShardCount = std::min(kLogShardCount, logPageCount);
+  m_shardMask = (uint64_t{1} << logShardCount) - 1;
+  for (uint64_t i = 0; i <= m_shardMask; ++i)
+    m_shards.push_back(std::make_unique<Shard>(logPageSize, logPageCount - logShardCount));
+}
+
+// static
+std::shared_ptr<SharedReaderCache> SharedReaderCache::Get(std::string const & fileName,
+                                                          uint64_t fileSize, uint32_t logPageSize,
+                                                          uint32_t logPageCount)
+{
+  // File size is a part of the key to not mix up pages of the replaced file with the new one.
+  // Page count is a part of the key to give every reader the capacity it asks for.
+  using Key = std::tuple<std::string, uint64_t, uint32_t, uint32_t>;
+  static std::mutex mutex;
+  static std::map<Key, std::weak_ptr<SharedReaderCache>> caches;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Drop expired entries to not grow unlimitedly when files are opened and closed.
+  for (auto it = caches.begin(); it != caches.end();)
+  {
+    if (it->second.expired())
+      it = caches.erase(it);
+    else
+      ++it;
+  }
+
+  auto & weak = caches[Key(fileName, fileSize, logPageSize, logPageCount)];
+  auto cache = weak.lock();
+  if (!cache)
+  {
+    cache = std::make_shared<SharedReaderCache>(logPageSize, logPageCount);
+    weak = cache;
+  }
+  return cache;
+}
+
+ReaderCacheStats SharedReaderCache::GetStats() const
+{
+  ReaderCacheStats stats;
+  for (auto const & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard->m_mutex);
+    stats += shard->m_stats;
+  }
+  return stats;
+}
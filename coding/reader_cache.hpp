@@ -1,54 +1,104 @@
 #pragma once
 
+#include "base/assert.hpp"
 #include "base/base.hpp"
-#include "base/cache.hpp"
-#include "base/stats.hpp"
+#include "base/buffer_vector.hpp"
+#include "base/macros.hpp"
 
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
-#include <sstream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+struct ReaderCacheStats
+{
+  double GetHitRate() const
+  {
+    uint64_t const total = m_pageHits + m_pageMisses;
+    return total == 0 ? 0.0 : static_cast<double>(m_pageHits) / static_cast<double>(total);
+  }
+
+  ReaderCacheStats & operator+=(ReaderCacheStats const & rhs)
+  {
+    m_readCalls += rhs.m_readCalls;
+    m_bytesRequested += rhs.m_bytesRequested;
+    m_pageHits += rhs.m_pageHits;
+    m_pageMisses += rhs.m_pageMisses;
+    return *this;
+  }
+
+  uint64_t m_readCalls = 0;
+  uint64_t m_bytesRequested = 0;
+  uint64_t m_pageHits = 0;
+  uint64_t m_pageMisses = 0;
+};
+
+std::string DebugPrint(ReaderCacheStats const & stats);
+
 namespace impl
 {
-template <bool Enable>
-struct ReaderCacheStats
+// Set-associative storage of file pages. Every page is mapped to a set of (up to) kWays slots,
+// the victim inside of the set is chosen with CLOCK (second chance) policy. Not thread-safe.
+class PageCache
 {
-  std::string GetStatsStr(uint32_t, uint32_t) const { return ""; }
-  base::NoopStats<uint32_t> m_ReadSize;
-  base::NoopStats<uint32_t> m_CacheHit;
+public:
+  static uint32_t constexpr kLogWays = 2;
+
+  PageCache(uint32_t logPageSize, uint32_t logPageCount);
+
+  size_t PageSize() const { return size_t{1} << m_logPageSize; }
+  uint32_t GetPageCount() const { return static_cast<uint32_t>(m_keys.size()); }
+
+  /// @returns cached page data or nullptr if |pageNum| is not cached.
+  char const * Find(uint64_t pageNum);
+
+  /// Evicts some page from the set of |pageNum| and assigns the slot to |pageNum|.
+  /// @returns buffer of PageSize() bytes which should be filled by the caller.
+  char * Insert(uint64_t pageNum);
+
+private:
+  size_t SetBegin(uint64_t pageNum) const;
+
+  uint32_t const m_logPageSize;
+  uint32_t m_logWays = 0;
+  uint32_t m_setMask = 0;
+  std::vector<uint64_t> m_keys;
+  std::vector<bool> m_referenced;
+  std::vector<uint8_t> m_hands;
+  // Pages are allocated on first use, as most of the files are read only partially.
+  std::vector<std::unique_ptr<char[]>> m_pages;
 };
 
-template <>
-struct ReaderCacheStats<true>
+// Calls |fn(pageNum, pageOffset, copySize, dst)| for each page intersecting with [pos, pos + size).
+template <typename Fn>
+void ForEachPagePart(uint32_t logPageSize, uint64_t pos, void * p, size_t size, Fn && fn)
 {
-  std::string GetStatsStr(uint32_t logPageSize, uint32_t pageCount) const
+  char * pDst = static_cast<char *>(p);
+  size_t const pageSize = size_t{1} << logPageSize;
+  uint64_t pageNum = pos >> logPageSize;
+  size_t pageOffset = static_cast<size_t>(pos - (pageNum << logPageSize));
+  while (size > 0)
   {
-    std::ostringstream out;
-    out << "LogPageSize: " << logPageSize << " PageCount: " << pageCount;
-    out << " ReadSize(" << m_ReadSize.ToString() << ")";
-    out << " CacheHit(" << m_CacheHit.ToString() << ")";
-    double const bytesAsked = m_ReadSize.GetAverage() * m_ReadSize.GetCount();
-    double const callsMade = (1.0 - m_CacheHit.GetAverage()) * m_CacheHit.GetCount();
-    double const bytesRead = callsMade * (1 << logPageSize);
-    out << " RatioBytesRead: " << (bytesRead + 1) / (bytesAsked + 1);
-    out << " RatioCallsMade: " << (callsMade + 1) / (m_ReadSize.GetCount() + 1);
-    return out.str();
+    size_t const copySize = std::min(size, pageSize - pageOffset);
+    ASSERT_GREATER(copySize, 0, ());
+    fn(pageNum, pageOffset, copySize, pDst);
+    size -= copySize;
+    pDst += copySize;
+    pageOffset = 0;
+    ++pageNum;
   }
-
-  base::AverageStats<uint32_t> m_ReadSize;
-  base::AverageStats<uint32_t> m_CacheHit;
-};
+}
 }  // namespace impl
 
-template <class ReaderT, bool bStats = false>
+template <class ReaderT>
 class ReaderCache
 {
 public:
   ReaderCache(uint32_t logPageSize, uint32_t logPageCount)
-    : m_Cache(logPageCount), m_LogPageSize(logPageSize)
+    : m_Cache(logPageSize, logPageCount), m_LogPageSize(logPageSize)
   {
   }
 
@@ -57,52 +107,120 @@ public:
     if (size == 0)
       return;
     ASSERT_LESS_OR_EQUAL(pos + size, reader.Size(), (pos, size, reader.Size()));
-    m_Stats.m_ReadSize(static_cast<uint32_t>(size));
-    char * pDst = static_cast<char *>(p);
-    uint64_t pageNum = pos >> m_LogPageSize;
-    size_t const firstPageOffset = static_cast<size_t>(pos - (pageNum << m_LogPageSize));
-    size_t const firstCopySize = std::min(size, PageSize() - firstPageOffset);
-    ASSERT_GREATER(firstCopySize, 0, ());
-    memcpy(pDst, ReadPage(reader, pageNum) + firstPageOffset, firstCopySize);
-    size -= firstCopySize;
-    pos += firstCopySize;
-    pDst += firstCopySize;
-    ++pageNum;
-    while (size > 0)
+    ++m_Stats.m_readCalls;
+    m_Stats.m_bytesRequested += size;
+    impl::ForEachPagePart(m_LogPageSize, pos, p, size,
+                          [&](uint64_t pageNum, size_t pageOffset, size_t copySize, char * pDst)
     {
-      size_t const copySize = std::min(size, PageSize());
-      memcpy(pDst, ReadPage(reader, pageNum), copySize);
-      size -= copySize;
-      pos += copySize;
-      pDst += copySize;
-      ++pageNum;
-    }
+      memcpy(pDst, ReadPage(reader, pageNum) + pageOffset, copySize);
+    });
   }
 
+  ReaderCacheStats const & GetStats() const { return m_Stats; }
+
   std::string GetStatsStr() const
   {
-    return m_Stats.GetStatsStr(m_LogPageSize, m_Cache.GetCacheSize());
+    return "LogPageSize: " + std::to_string(m_LogPageSize) +
+           " PageCount: " + std::to_string(m_Cache.GetPageCount()) + " " + DebugPrint(m_Stats);
   }
 
 private:
-  inline size_t PageSize() const { return 1 << m_LogPageSize; }
-
-  inline char const * ReadPage(ReaderT & reader, uint64_t pageNum)
+  char const * ReadPage(ReaderT & reader, uint64_t pageNum)
   {
-    bool cached;
-    std::vector<char> & v = m_Cache.Find(pageNum, cached);
-    m_Stats.m_CacheHit(cached ? 1 : 0);
-    if (!cached)
+    if (char const * page = m_Cache.Find(pageNum))
     {
-      if (v.empty())
-        v.resize(PageSize());
-      uint64_t const pos = pageNum << m_LogPageSize;
-      reader.Read(pos, &v[0], std::min(PageSize(), static_cast<size_t>(reader.Size() - pos)));
+      ++m_Stats.m_pageHits;
+      return page;
     }
-    return &v[0];
+
+    ++m_Stats.m_pageMisses;
+    char * page = m_Cache.Insert(pageNum);
+    uint64_t const pos = pageNum << m_LogPageSize;
+    reader.Read(pos, page, std::min(m_Cache.PageSize(), static_cast<size_t>(reader.Size() - pos)));
+    return page;
   }
 
-  base::Cache<uint64_t, std::vector<char> > m_Cache;
+  impl::PageCache m_Cache;
   uint32_t const m_LogPageSize;
-  impl::ReaderCacheStats<bStats> m_Stats;
+  ReaderCacheStats m_Stats;
+};
+
+/// Thread-safe page cache, which may be shared by several readers of the same file.
+/// Pages are distributed among shards by their numbers and every shard has its own lock,
+/// so concurrent readers rarely wait for each other. Pages are read by the reader passed
+/// to Read(), therefore every thread should use its own reader.
+class SharedReaderCache
+{
+public:
+  static uint32_t constexpr kLogShardCount = 4;
+
+  SharedReaderCache(uint32_t logPageSize, uint32_t logPageCount);
+
+  /// @returns cache which is shared by all readers of |fileName| having the same page size and
+  /// the same page count.
+  /// The cache is alive while at least one of the readers holds it.
+  static std::shared_ptr<SharedReaderCache> Get(std::string const & fileName, uint64_t fileSize,
+                                                uint32_t logPageSize, uint32_t logPageCount);
+
+  template <class ReaderT>
+  void Read(ReaderT & reader, uint64_t pos, void * p, size_t size)
+  {
+    if (size == 0)
+      return;
+    ASSERT_LESS_OR_EQUAL(pos + size, reader.Size(), (pos, size, reader.Size()));
+
+    bool firstPage = true;
+    impl::ForEachPagePart(m_logPageSize, pos, p, size,
+                          [&](uint64_t pageNum, size_t pageOffset, size_t copySize, char * pDst)
+    {
+      Shard & shard = *m_shards[pageNum & m_shardMask];
+      {
+        std::lock_guard<std::mutex> lock(shard.m_mutex);
+        if (firstPage)
+        {
+          ++shard.m_stats.m_readCalls;
+          shard.m_stats.m_bytesRequested += size;
+          firstPage = false;
+        }
+
+        if (char const * page = shard.m_pages.Find(pageNum))
+        {
+          ++shard.m_stats.m_pageHits;
+          memcpy(pDst, page + pageOffset, copySize);
+          return;
+        }
+        ++shard.m_stats.m_pageMisses;
+      }
+
+      // Do not hold the lock during I/O.
+      uint64_t const pagePos = pageNum << m_logPageSize;
+      size_t const pageSize = size_t{1} << m_logPageSize;
+      size_t const readSize = std::min(pageSize, static_cast<size_t>(reader.Size() - pagePos));
+      buffer_vector<char, 4096> buffer(readSize);
+      reader.Read(pagePos, buffer.data(), readSize);
+      memcpy(pDst, buffer.data() + pageOffset, copySize);
+
+      std::lock_guard<std::mutex> lock(shard.m_mutex);
+      if (shard.m_pages.Find(pageNum) == nullptr)
+        memcpy(shard.m_pages.Insert(pageNum), buffer.data(), readSize);
+    });
+  }
+
+  ReaderCacheStats GetStats() const;
+
+private:
+  struct Shard
+  {
+    explicit Shard(uint32_t logPageSize, uint32_t logPageCount) : m_pages(logPageSize, logPageCount) {}
+
+    std::mutex mutable m_mutex;
+    impl::PageCache m_pages;
+    ReaderCacheStats m_stats;
+  };
+
+  uint32_t const m_logPageSize;
+  uint64_t m_shardMask = 0;
+  std::vector<std::unique_ptr<Shard>> m_shards;
+
+  DISALLOW_COPY_AND_MOVE(SharedReaderCache);
 };
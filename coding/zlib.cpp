@@ -56,7 +56,8 @@ bool ZLib::Processor::BufferIsFull() const
 
 // ZLib::Deflate -----------------------------------------------------------------------------------
 ZLib::DeflateProcessor::DeflateProcessor(Deflate::Format format, Deflate::Level level,
-                                         void const * data, size_t size) noexcept
+                                         std::string_view dictionary, void const * data,
+                                         size_t size) noexcept
   : Processor(data, size)
 {
   auto bits = MAX_WBITS;
@@ -70,6 +71,16 @@ ZLib::DeflateProcessor::DeflateProcessor(Deflate::Format format, Deflate::Level
       deflateInit2(&m_stream, ToInt(level) /* level */, Z_DEFLATED /* method */,
                    bits /* windowBits */, 8 /* memLevel */, Z_DEFAULT_STRATEGY /* strategy */);
   m_init = (ret == Z_OK);
+
+  if (m_init && !dictionary.empty())
+  {
+    auto const * dict = reinterpret_cast<Bytef const *>(dictionary.data());
+    if (deflateSetDictionary(&m_stream, dict, static_cast<uInt>(dictionary.size())) != Z_OK)
+    {
+      deflateEnd(&m_stream);
+      m_init = false;
+    }
+  }
 }
 
 ZLib::DeflateProcessor::~DeflateProcessor() noexcept
@@ -85,9 +96,9 @@ int ZLib::DeflateProcessor::Process(int flush)
 }
 
 // ZLib::Inflate -----------------------------------------------------------------------------------
-ZLib::InflateProcessor::InflateProcessor(Inflate::Format format, void const * data,
-                                         size_t size) noexcept
-  : Processor(data, size)
+ZLib::InflateProcessor::InflateProcessor(Inflate::Format format, std::string_view dictionary,
+                                         void const * data, size_t size) noexcept
+  : Processor(data, size), m_dictionary(dictionary)
 {
   auto bits = MAX_WBITS;
   switch (format)
@@ -109,6 +120,13 @@ ZLib::InflateProcessor::~InflateProcessor() noexcept
 int ZLib::InflateProcessor::Process(int flush)
 {
   ASSERT(IsInit(), ());
+  int const ret = inflate(&m_stream, flush);
+  if (ret != Z_NEED_DICT || m_dictionary.empty())
+    return ret;
+
+  auto const * dict = reinterpret_cast<Bytef const *>(m_dictionary.data());
+  if (inflateSetDictionary(&m_stream, dict, static_cast<uInt>(m_dictionary.size())) != Z_OK)
+    return Z_DATA_ERROR;
   return inflate(&m_stream, flush);
 }
 }  // namespace coding
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <string>
+#include <string_view>
 
 #include "zlib.h"
 
@@ -17,6 +18,9 @@ namespace coding
 // of errors. In this case the output sequence may be already
 // partially formed, so the user needs to implement their own
 // roll-back strategy.
+//
+// Optional |dictionary| is a preset dictionary (see deflateSetDictionary()), the same dictionary
+// must be passed to Deflate and Inflate. It's not copied and should outlive the wrappers.
 class ZLib
 {
 public:
@@ -30,14 +34,17 @@ public:
       Both
     };
 
-    explicit Inflate(Format format) noexcept : m_format(format) {}
+    explicit Inflate(Format format, std::string_view dictionary = {}) noexcept
+      : m_format(format), m_dictionary(dictionary)
+    {
+    }
 
     template <typename OutIt>
     bool operator()(void const * data, size_t size, OutIt out) const
     {
       if (data == nullptr)
         return false;
-      InflateProcessor processor(m_format, data, size);
+      InflateProcessor processor(m_format, m_dictionary, data, size);
       return Process(processor, out);
     }
 
@@ -49,6 +56,7 @@ public:
 
   private:
     Format const m_format;
+    std::string_view const m_dictionary;
   };
 
   class Deflate
@@ -68,14 +76,17 @@ public:
       DefaultCompression
     };
 
-    Deflate(Format format, Level level) noexcept : m_format(format), m_level(level) {}
+    Deflate(Format format, Level level, std::string_view dictionary = {}) noexcept
+      : m_format(format), m_level(level), m_dictionary(dictionary)
+    {
+    }
 
     template <typename OutIt>
     bool operator()(void const * data, size_t size, OutIt out) const
     {
       if (data == nullptr)
         return false;
-      DeflateProcessor processor(m_format, m_level, data, size);
+      DeflateProcessor processor(m_format, m_level, m_dictionary, data, size);
       return Process(processor, out);
     }
 
@@ -88,6 +99,7 @@ public:
   private:
     Format const m_format;
     Level const m_level;
+    std::string_view const m_dictionary;
   };
 
 private:
@@ -123,8 +135,8 @@ private:
   class DeflateProcessor final : public Processor
   {
   public:
-    DeflateProcessor(Deflate::Format format, Deflate::Level level, void const * data,
-                     size_t size) noexcept;
+    DeflateProcessor(Deflate::Format format, Deflate::Level level, std::string_view dictionary,
+                     void const * data, size_t size) noexcept;
     virtual ~DeflateProcessor() noexcept override;
 
     int Process(int flush);
@@ -135,11 +147,15 @@ private:
   class InflateProcessor final : public Processor
   {
   public:
-    InflateProcessor(Inflate::Format format, void const * data, size_t size) noexcept;
+    InflateProcessor(Inflate::Format format, std::string_view dictionary, void const * data,
+                     size_t size) noexcept;
     virtual ~InflateProcessor() noexcept override;
 
     int Process(int flush);
 
+  private:
+    std::string_view const m_dictionary;
+
     DISALLOW_COPY_AND_MOVE(InflateProcessor);
   };
 
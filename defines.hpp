@@ -59,6 +59,8 @@
 #define DESCRIPTIONS_FILE_TAG "descriptions"
 #define MAXSPEEDS_FILE_TAG "maxspeeds"
 #define ROUTING_WORLD_FILE_TAG "routing_world"
+#define ROAD_SEGMENTS_INDEX_FILE_TAG "road_segments_index"
+#define SPEED_PROFILES_FILE_TAG "speed_profiles"
 
 #define READY_FILE_EXTENSION ".ready"
 #define RESUME_FILE_EXTENSION ".resume"
@@ -6,6 +6,7 @@
 #include "editor/xml_feature.hpp"
 
 #include "indexer/fake_feature_ids.hpp"
+#include "indexer/feature_cache.hpp"
 #include "indexer/feature_decl.hpp"
 #include "indexer/feature_meta.hpp"
 #include "indexer/feature_source.hpp"
@@ -318,6 +319,7 @@ void Editor::DeleteFeature(FeatureID const & fid)
 
   MarkFeatureWithStatus(*editableFeatures, fid, FeatureStatus::Deleted);
   SaveTransaction(editableFeatures);
+  FeatureCache::Instance().DropFeature(fid);
   Invalidate();
 }
 
@@ -428,6 +430,7 @@ Editor::SaveResult Editor::SaveEditedFeature(EditableMapObject const & emo)
 
   bool const savedSuccessfully = SaveTransaction(editableFeatures);
 
+  FeatureCache::Instance().DropFeature(fid);
   Invalidate();
   return savedSuccessfully ? SaveResult::SavedSuccessfully : SaveResult::NoFreeSpaceError;
 }
@@ -898,6 +901,7 @@ bool Editor::MarkFeatureAsObsolete(FeatureID const & fid)
 
   MarkFeatureWithStatus(*editableFeatures, fid, FeatureStatus::Obsolete);
   auto const result = SaveTransaction(editableFeatures);
+  FeatureCache::Instance().DropFeature(fid);
   Invalidate();
 
   return result;
@@ -910,7 +914,10 @@ bool Editor::RemoveFeature(FeatureID const & fid)
   auto const result = RemoveFeatureIfExists(fid);
 
   if (result)
+  {
+    FeatureCache::Instance().DropFeature(fid);
     Invalidate();
+  }
 
   return result;
 }
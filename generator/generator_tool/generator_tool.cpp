@@ -25,6 +25,7 @@
 #include "generator/routing_index_generator.hpp"
 #include "generator/routing_world_roads_generator.hpp"
 #include "generator/search_index_builder.hpp"
+#include "generator/speed_profiles_builder.hpp"
 #include "generator/statistics.hpp"
 #include "generator/traffic_generator.hpp"
 #include "generator/transit_generator.hpp"
@@ -148,6 +149,11 @@ DEFINE_bool(
     make_city_roads, false,
     "Calculates which roads lie inside cities and makes a section with ids of these roads.");
 DEFINE_bool(generate_maxspeed, false, "Generate section with maxspeed of road features.");
+DEFINE_string(speed_profiles_path, "",
+              "Path to csv file with historical weekly speed profiles of ways. If set, section with "
+              "speed profiles of road features is generated.");
+DEFINE_int32(speed_profiles_utc_offset, 0,
+             "UTC offset in minutes of the local time which speed profiles are given in.");
 
 // Sponsored-related.
 DEFINE_string(complex_hierarchy_data, "", "Path to complex hierarchy in csv format.");
@@ -506,6 +512,7 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
       string const roadAccessFilename = genInfo.GetIntermediateFileName(ROAD_ACCESS_FILENAME);
 
       BuildRoutingIndex(dataFile, country, *countryParentGetter);
+      BuildRoadSegmentIndex(dataFile, country, *countryParentGetter);
       auto routingGraph = CreateIndexGraph(dataFile, country, *countryParentGetter);
       CHECK(routingGraph, ());
 
@@ -524,6 +531,15 @@ MAIN_WITH_ERROR_HANDLING([](int argc, char ** argv)
         LOG(LINFO, ("Generating maxspeeds section for", dataFile, "using", maxspeedsFilename));
         BuildMaxspeedsSection(routingGraph.get(), dataFile, osmToFeatureFilename, maxspeedsFilename);
       }
+
+      if (!FLAGS_speed_profiles_path.empty())
+      {
+        LOG(LINFO, ("Generating", SPEED_PROFILES_FILE_TAG, "section for", dataFile, "using",
+                    FLAGS_speed_profiles_path));
+        if (!BuildSpeedProfilesSection(dataFile, osmToFeatureFilename, FLAGS_speed_profiles_path,
+                                       FLAGS_speed_profiles_utc_offset))
+          LOG(LERROR, ("Generating speed profiles error."));
+      }
     }
 
     if (FLAGS_make_cross_mwm || FLAGS_make_transit_cross_mwm || FLAGS_make_transit_cross_mwm_experimental)
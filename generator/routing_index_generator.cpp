@@ -14,6 +14,7 @@
 #include "routing/index_graph_serialization.hpp"
 #include "routing/index_graph_starter_joints.hpp"
 #include "routing/joint_segment.hpp"
+#include "routing/road_segment_index.hpp"
 #include "routing/vehicle_mask.hpp"
 #include "routing/world_graph.hpp"
 
@@ -662,6 +663,47 @@ bool BuildRoutingIndex(string const & filename, string const & country,
   }
 }
 
+bool BuildRoadSegmentIndex(string const & filename, string const & country,
+                           CountryParentNameGetterFn const & countryParentNameGetterFn)
+{
+  LOG(LINFO, ("Building road segments index for", filename));
+  try
+  {
+    VehicleMaskBuilder const maskMaker(country, countryParentNameGetterFn);
+    RoadSegmentIndexBuilder builder;
+    ForEachFeature(filename, [&](FeatureType & f, uint32_t featureId) {
+      VehicleMask const mask = maskMaker.CalcRoadMask(f);
+      if (mask == 0)
+        return;
+
+      f.ParseGeometry(FeatureType::BEST_GEOMETRY);
+      size_t const pointsCount = f.GetPointsCount();
+      for (size_t i = 0; i + 1 < pointsCount; ++i)
+      {
+        builder.Add(featureId, base::checked_cast<uint32_t>(i), mask, f.GetPoint(i),
+                    f.GetPoint(i + 1));
+      }
+    });
+
+    FilesContainerW cont(filename, FileWriter::OP_WRITE_EXISTING);
+    auto writer = cont.GetWriter(ROAD_SEGMENTS_INDEX_FILE_TAG);
+
+    auto const startPos = writer->Pos();
+    builder.Serialize(*writer);
+    auto const sectionSize = writer->Pos() - startPos;
+
+    LOG(LINFO, ("Road segments index created:", sectionSize, "bytes,", builder.GetCount(),
+                "segments"));
+    return true;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("An exception happened while creating", ROAD_SEGMENTS_INDEX_FILE_TAG, "section:",
+                 e.what()));
+    return false;
+  }
+}
+
 /// \brief Serializes all the cross mwm information to |sectionName| of |mwmFile| including:
 /// * header
 /// * transitions
@@ -13,6 +13,12 @@ using CountryParentNameGetterFn = std::function<std::string(std::string const &)
 bool BuildRoutingIndex(std::string const & filename, std::string const & country,
                        CountryParentNameGetterFn const & countryParentNameGetterFn);
 
+/// \brief Builds ROAD_SEGMENTS_INDEX_FILE_TAG section with all the road segments of the mwm
+/// packed for nearest segment queries.
+/// \note Before call of this method all features and feature geometry should be generated.
+bool BuildRoadSegmentIndex(std::string const & filename, std::string const & country,
+                           CountryParentNameGetterFn const & countryParentNameGetterFn);
+
 /// \brief Builds CROSS_MWM_FILE_TAG section.
 /// \note Before call of this method
 /// * all features and feature geometry should be generated
@@ -3,6 +3,7 @@
 #include "search/common.hpp"
 #include "search/house_to_street_table.hpp"
 #include "search/mwm_context.hpp"
+#include "search/nearby_objects_index.hpp"
 #include "search/reverse_geocoder.hpp"
 #include "search/search_index_header.hpp"
 #include "search/search_index_values.hpp"
@@ -487,6 +488,20 @@ void BuildAddressTable(FilesContainerR & container, std::string const & addressD
   std::vector<uint32_t> streets(featuresCount, kInvalidFeatureId);
   std::vector<uint32_t> places(featuresCount, kInvalidFeatureId);
 
+  // Streets and places are indexed once for the whole mwm instead of reading them around
+  // every address. Indexes are immutable and are shared between threads.
+  std::unique_ptr<search::NearbyObjectsIndex> streetsIndex, placesIndex;
+  {
+    search::MwmContext const context(dataSource.GetMwmHandleById(mwmId));
+    auto const & rect = context.GetInfo()->m_bordersRect;
+    streetsIndex = std::make_unique<search::NearbyObjectsIndex>(
+        context, rect, &search::ReverseGeocoder::IsStreetFeature, kStreetRadiusM);
+    placesIndex = std::make_unique<search::NearbyObjectsIndex>(
+        context, rect, &search::ReverseGeocoder::IsPlaceFeature, kPlaceRadiusM);
+    LOG(LINFO, ("Nearby objects indexes are built, streets:", streetsIndex->GetObjectsCount(),
+                "places:", placesIndex->GetObjectsCount()));
+  }
+
   // Thread working function.
   auto const fn = [&](uint32_t threadIdx)
   {
@@ -511,7 +526,7 @@ void BuildAddressTable(FilesContainerR & container, std::string const & addressD
 
       if (!street.empty())
       {
-        auto const streets = search::ReverseGeocoder::GetNearbyStreets(*contexts[threadIdx], center, kStreetRadiusM);
+        auto const streets = streetsIndex->GetNearbyObjects(center, kStreetRadiusM);
         streetId = MatchObjectByName(street, streets, [](std::string_view name)
         {
           return search::GetStreetNameAsKey(name, false /* ignoreStreetSynonyms */);
@@ -528,7 +543,7 @@ void BuildAddressTable(FilesContainerR & container, std::string const & addressD
 
       if (!place.empty())
       {
-        auto const places = search::ReverseGeocoder::GetNearbyPlaces(*contexts[threadIdx], center, kPlaceRadiusM);
+        auto const places = placesIndex->GetNearbyObjects(center, kPlaceRadiusM);
         placeId = MatchObjectByName(place, places, [](std::string_view name)
         {
           return strings::MakeUniString(name);
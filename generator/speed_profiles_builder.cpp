@@ -0,0 +1,140 @@
+#include "generator/speed_profiles_builder.hpp"
+
+#include "routing/speed_profiles_serialization.hpp"
+
+#include "coding/files_container.hpp"
+#include "coding/file_writer.hpp"
+
+#include "base/geo_object_id.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "defines.hpp"
+
+namespace routing_builder
+{
+using namespace routing;
+using std::string;
+
+namespace
+{
+bool ParseProfile(std::vector<string> const & tokens, size_t first, SpeedProfiles::Profile & profile)
+{
+  if (tokens.size() != first + SpeedProfiles::kBucketsCount)
+    return false;
+
+  for (size_t i = 0; i < SpeedProfiles::kBucketsCount; ++i)
+  {
+    auto const & token = tokens[first + i];
+    if (token.empty())
+    {
+      profile[i] = SpeedProfiles::kNoData;
+      continue;
+    }
+
+    double percent = 0.0;
+    if (!strings::to_double(token, percent) || percent < 0.0)
+      return false;
+    profile[i] = SpeedProfiles::Quantize(percent / SpeedProfiles::kFreeFlow);
+  }
+  return true;
+}
+}  // namespace
+
+bool ParseSpeedProfiles(string const & filePath, OsmIdToFeatureIds const & osmIdToFeatureIds,
+                        SpeedProfilesBuilder & builder)
+{
+  std::ifstream stream(filePath);
+  if (!stream)
+    return false;
+
+  size_t lineNumber = 0;
+  size_t skipped = 0;
+  string line;
+  std::vector<string> tokens;
+  SpeedProfiles::Profile profile;
+  while (std::getline(stream, line))
+  {
+    ++lineNumber;
+    strings::Trim(line);
+    if (line.empty())
+      continue;
+
+    tokens.clear();
+    std::istringstream lineStream(line);
+    string token;
+    while (std::getline(lineStream, token, ','))
+    {
+      strings::Trim(token);
+      tokens.push_back(token);
+    }
+    // Trailing empty value.
+    if (line.back() == ',')
+      tokens.emplace_back();
+
+    uint64_t osmId = 0;
+    if (tokens.size() < 3 || !strings::to_uint64(tokens[0], osmId) ||
+        (tokens[1] != "F" && tokens[1] != "B") || !ParseProfile(tokens, 3, profile))
+    {
+      LOG(LWARNING, ("Wrong line", lineNumber, "in", filePath));
+      return false;
+    }
+
+    uint32_t segmentIdx = SpeedProfiles::kAllSegments;
+    if (tokens[2] != "*" && !strings::to_uint32(tokens[2], segmentIdx))
+    {
+      LOG(LWARNING, ("Wrong segment index in line", lineNumber, "in", filePath));
+      return false;
+    }
+
+    auto const it = osmIdToFeatureIds.find(base::MakeOsmWay(osmId));
+    if (it == osmIdToFeatureIds.cend() ||
+        (segmentIdx != SpeedProfiles::kAllSegments && it->second.size() != 1))
+    {
+      ++skipped;
+      continue;
+    }
+
+    bool const forward = tokens[1] == "F";
+    for (uint32_t const featureId : it->second)
+      builder.Add(featureId, segmentIdx, forward, profile);
+  }
+
+  LOG(LINFO, ("Speed profiles of", builder.GetSegmentsCount(), "segments are parsed,", skipped,
+              "lines are skipped. Unique profiles:", builder.GetProfilesCount()));
+  return true;
+}
+
+bool BuildSpeedProfilesSection(string const & dataPath, string const & osmToFeaturePath,
+                               string const & speedProfilesPath, int32_t utcOffsetMinutes)
+{
+  OsmIdToFeatureIds osmIdToFeatureIds;
+  ParseWaysOsmIdToFeatureIdMapping(osmToFeaturePath, osmIdToFeatureIds);
+
+  SpeedProfilesBuilder builder;
+  if (!ParseSpeedProfiles(speedProfilesPath, osmIdToFeatureIds, builder))
+  {
+    LOG(LERROR, ("Can't parse speed profiles from", speedProfilesPath));
+    return false;
+  }
+
+  SpeedProfiles speedProfiles = builder.Build();
+  speedProfiles.SetUtcOffsetMinutes(utcOffsetMinutes);
+  if (speedProfiles.IsEmpty())
+  {
+    LOG(LINFO, ("No speed profiles for", dataPath));
+    return true;
+  }
+
+  FilesContainerW cont(dataPath, FileWriter::OP_WRITE_EXISTING);
+  auto writer = cont.GetWriter(SPEED_PROFILES_FILE_TAG);
+  SpeedProfilesSerializer::Serialize(*writer, speedProfiles);
+
+  LOG(LINFO, ("Serialized", speedProfiles, "for", dataPath));
+  return true;
+}
+}  // namespace routing_builder
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "generator/routing_helpers.hpp"
+
+#include "routing/speed_profiles.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace routing_builder
+{
+/// \brief Parses csv file with historical speed profiles of ways and adds them to |builder|.
+/// Every line of the file is:
+/// osm way id, direction (F or B), segment index of the feature or * for all its segments,
+/// and SpeedProfiles::kBucketsCount percents of the free flow speed for every 15 minutes
+/// of a week starting from Sunday midnight. Empty value means no data.
+/// Segment indexes are used for the ways which are not split into several features only.
+/// \returns false if the file can't be opened or has a wrong line.
+bool ParseSpeedProfiles(std::string const & filePath,
+                        routing::OsmIdToFeatureIds const & osmIdToFeatureIds,
+                        routing::SpeedProfilesBuilder & builder);
+
+/// \brief Builds speed_profiles section in mwm with |dataPath| from |speedProfilesPath| csv file.
+/// Profiles are given in the local time of the region, which is UTC + |utcOffsetMinutes|.
+bool BuildSpeedProfilesSection(std::string const & dataPath, std::string const & osmToFeaturePath,
+                               std::string const & speedProfilesPath, int32_t utcOffsetMinutes);
+}  // namespace routing_builder
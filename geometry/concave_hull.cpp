@@ -0,0 +1,334 @@
+#include "geometry/concave_hull.hpp"
+
+#include "geometry/convex_hull.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/rect2d.hpp"
+#include "geometry/segment2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/math.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace m2
+{
+namespace
+{
+// Uniform grid of square cells over the rect of the points.
+class Grid
+{
+public:
+  Grid(RectD const & rect, size_t pointsCount) : m_origin(rect.LeftBottom())
+  {
+    // About one point per cell.
+    m_cellSize = std::sqrt(rect.SizeX() * rect.SizeY() / std::max<size_t>(pointsCount, 1));
+    if (!(m_cellSize > 0.0))
+      m_cellSize = std::max({rect.SizeX(), rect.SizeY(), 1.0});
+
+    m_cellsX = static_cast<size_t>(rect.SizeX() / m_cellSize) + 1;
+    m_cellsY = static_cast<size_t>(rect.SizeY() / m_cellSize) + 1;
+    m_eps = m_cellSize * 1e-9;
+  }
+
+  size_t CellsCount() const { return m_cellsX * m_cellsY; }
+  double CellSize() const { return m_cellSize; }
+
+  size_t GetCell(PointD const & p) const { return ToIndex(ToCellX(p.x), ToCellY(p.y)); }
+
+  // Calls |fn(cell)| for all the cells which segment (p1, p2) may cross.
+  template <typename Fn>
+  void ForEachCellOnSegment(PointD p1, PointD p2, Fn && fn) const
+  {
+    if (p1.x > p2.x)
+      std::swap(p1, p2);
+
+    size_t const x1 = ToCellX(p1.x - m_eps);
+    size_t const x2 = ToCellX(p2.x + m_eps);
+    for (size_t x = x1; x <= x2; ++x)
+    {
+      // The part of the segment in the column.
+      double const left = base::Clamp(m_origin.x + x * m_cellSize, p1.x, p2.x);
+      double const right = base::Clamp(m_origin.x + (x + 1) * m_cellSize, p1.x, p2.x);
+      double y1 = p1.x == p2.x ? p1.y : GetY(p1, p2, left);
+      double y2 = p1.x == p2.x ? p2.y : GetY(p1, p2, right);
+      if (y1 > y2)
+        std::swap(y1, y2);
+
+      size_t const cellY2 = ToCellY(y2 + m_eps);
+      for (size_t y = ToCellY(y1 - m_eps); y <= cellY2; ++y)
+        fn(ToIndex(x, y));
+    }
+  }
+
+  // Calls |fn(cell)| for the cells around |cell|.
+  template <typename Fn>
+  void ForEachNeighbour(size_t cell, Fn && fn) const
+  {
+    size_t const cx = cell % m_cellsX;
+    size_t const cy = cell / m_cellsX;
+    for (size_t y = (cy == 0 ? 0 : cy - 1); y <= std::min(cy + 1, m_cellsY - 1); ++y)
+    {
+      for (size_t x = (cx == 0 ? 0 : cx - 1); x <= std::min(cx + 1, m_cellsX - 1); ++x)
+        fn(ToIndex(x, y));
+    }
+  }
+
+private:
+  static double GetY(PointD const & p1, PointD const & p2, double x)
+  {
+    return p1.y + (p2.y - p1.y) * (x - p1.x) / (p2.x - p1.x);
+  }
+
+  size_t ToCell(double coord, double origin, size_t cellsCount) const
+  {
+    double const cell = std::floor((coord - origin) / m_cellSize);
+    return static_cast<size_t>(base::Clamp(cell, 0.0, static_cast<double>(cellsCount - 1)));
+  }
+
+  size_t ToCellX(double x) const { return ToCell(x, m_origin.x, m_cellsX); }
+  size_t ToCellY(double y) const { return ToCell(y, m_origin.y, m_cellsY); }
+  size_t ToIndex(size_t x, size_t y) const { return y * m_cellsX + x; }
+
+  PointD m_origin;
+  double m_cellSize = 0.0;
+  double m_eps = 0.0;
+  size_t m_cellsX = 0;
+  size_t m_cellsY = 0;
+};
+
+class Digger
+{
+public:
+  Digger(std::vector<PointD> const & convex, std::vector<PointD> && inner)
+    : m_grid(GetRect(convex), convex.size() + inner.size())
+    , m_inner(std::move(inner))
+    , m_removed(m_inner.size(), false)
+    , m_innerCells(m_grid.CellsCount())
+    , m_edgeCells(m_grid.CellsCount())
+    , m_visited(m_grid.CellsCount(), 0)
+  {
+    for (uint32_t i = 0; i < m_inner.size(); ++i)
+      m_innerCells[m_grid.GetCell(m_inner[i])].push_back(i);
+
+    m_nodes = convex;
+    m_next.resize(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+      m_next[i] = (i + 1) % m_nodes.size();
+      AddEdge(i);
+    }
+  }
+
+  // Digs into the hull while it's possible, see ConcaveHull.
+  void Dig(double concavity, double minEdgeLength)
+  {
+    // Edges which are still may be dug are identified by their first node.
+    std::vector<size_t> edges;
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+      edges.push_back(i);
+
+    size_t innerCount = m_inner.size();
+    while (!edges.empty())
+    {
+      size_t const edge = edges.back();
+      edges.pop_back();
+
+      PointD const a = m_nodes[edge];
+      PointD const b = m_nodes[m_next[edge]];
+      double const length = a.Length(b);
+      if (length <= minEdgeLength || innerCount == 0)
+        continue;
+
+      // The edge can't be dug through a point which is farther than length / concavity from it.
+      size_t best;
+      if (!FindNearest(a, b, length / concavity, best))
+        continue;
+
+      PointD const p = m_inner[best];
+      if (length <= concavity * std::min(p.Length(a), p.Length(b)))
+        continue;
+
+      if (CrossesHull(a, p) || CrossesHull(p, b))
+        continue;
+
+      // Triangle (a, p, b) which is cut off the polygon doesn't contain other points: the distance
+      // to the edge is convex, so any point strictly inside the triangle is closer to the edge
+      // than |p|.
+
+      m_removed[best] = true;
+      --innerCount;
+
+      size_t const node = m_nodes.size();
+      m_nodes.push_back(p);
+      m_next.push_back(m_next[edge]);
+      m_next[edge] = node;
+      AddEdge(edge);
+      AddEdge(node);
+
+      edges.push_back(edge);
+      edges.push_back(node);
+    }
+  }
+
+  std::vector<PointD> GetHull() const
+  {
+    std::vector<PointD> hull;
+    hull.reserve(m_nodes.size());
+    size_t node = 0;
+    do
+    {
+      hull.push_back(m_nodes[node]);
+      node = m_next[node];
+    } while (node != 0);
+    return hull;
+  }
+
+private:
+  static RectD GetRect(std::vector<PointD> const & convex)
+  {
+    RectD rect;
+    for (auto const & p : convex)
+      rect.Add(p);
+    return rect;
+  }
+
+  void AddEdge(size_t node)
+  {
+    size_t const next = m_next[node];
+    m_grid.ForEachCellOnSegment(m_nodes[node], m_nodes[next], [&](size_t cell)
+    {
+      m_edgeCells[cell].emplace_back(node, next);
+    });
+  }
+
+  // Finds the closest to segment (a, b) inner point. Points which are farther than |maxDist|
+  // may be skipped. Ties are broken by the points order.
+  bool FindNearest(PointD const & a, PointD const & b, double maxDist, size_t & best)
+  {
+    ParametrizedSegment<PointD> const segment(a, b);
+    double bestDist = std::numeric_limits<double>::max();
+    bool found = false;
+    best = 0;
+
+    ++m_visitedStamp;
+    std::vector<size_t> cells;
+    m_grid.ForEachCellOnSegment(a, b, [&](size_t cell)
+    {
+      if (m_visited[cell] != m_visitedStamp)
+      {
+        m_visited[cell] = m_visitedStamp;
+        cells.push_back(cell);
+      }
+    });
+
+    // Cells are visited by layers around the cells of the segment, points of the cells which
+    // are not visited after the layer |layer| are farther than layer * cellSize from the segment.
+    std::vector<size_t> nextCells;
+    for (size_t layer = 0; !cells.empty(); ++layer)
+    {
+      for (size_t cell : cells)
+      {
+        for (uint32_t i : m_innerCells[cell])
+        {
+          if (m_removed[i])
+            continue;
+
+          double const dist = segment.SquaredDistanceToPoint(m_inner[i]);
+          if (dist < bestDist || (dist == bestDist && i < best))
+          {
+            bestDist = dist;
+            best = i;
+            found = true;
+          }
+        }
+      }
+
+      double const coveredDist = layer * m_grid.CellSize();
+      if (coveredDist >= maxDist || (found && bestDist < coveredDist * coveredDist))
+        break;
+
+      nextCells.clear();
+      for (size_t cell : cells)
+      {
+        m_grid.ForEachNeighbour(cell, [&](size_t neighbour)
+        {
+          if (m_visited[neighbour] != m_visitedStamp)
+          {
+            m_visited[neighbour] = m_visitedStamp;
+            nextCells.push_back(neighbour);
+          }
+        });
+      }
+      cells.swap(nextCells);
+    }
+
+    return found;
+  }
+
+  // Checks whether segment (p1, p2) crosses any edge of the hull which has no common ends with it.
+  bool CrossesHull(PointD const & p1, PointD const & p2) const
+  {
+    bool crosses = false;
+    m_grid.ForEachCellOnSegment(p1, p2, [&](size_t cell)
+    {
+      for (auto const & [from, to] : m_edgeCells[cell])
+      {
+        // The edge has been dug already.
+        if (crosses || m_next[from] != to)
+          continue;
+
+        PointD const & a = m_nodes[from];
+        PointD const & b = m_nodes[to];
+        if (a == p1 || a == p2 || b == p1 || b == p2)
+          continue;
+        if (SegmentsIntersect(p1, p2, a, b))
+          crosses = true;
+      }
+    });
+    return crosses;
+  }
+
+  Grid const m_grid;
+
+  // Inner points sorted and unique, and the cells of them.
+  std::vector<PointD> const m_inner;
+  std::vector<bool> m_removed;
+  std::vector<std::vector<uint32_t>> m_innerCells;
+
+  // The hull is a cyclic list of nodes. Edges are stored in the cells as pairs of the nodes,
+  // an edge is a part of the hull iff m_next[from] == to.
+  std::vector<PointD> m_nodes;
+  std::vector<size_t> m_next;
+  std::vector<std::vector<std::pair<size_t, size_t>>> m_edgeCells;
+
+  std::vector<uint32_t> m_visited;
+  uint32_t m_visitedStamp = 0;
+};
+}  // namespace
+
+ConcaveHull::ConcaveHull(std::vector<PointD> const & points, double concavity,
+                         double minEdgeLength, double eps)
+{
+  CHECK_GREATER(concavity, 0.0, ());
+
+  auto const convex = ConvexHull(points, eps).Points();
+  if (convex.size() < 3)
+  {
+    m_hull = convex;
+    return;
+  }
+
+  std::vector<PointD> inner = points;
+  base::SortUnique(inner);
+  base::EraseIf(inner, [&convex](PointD const & p) { return base::IsExist(convex, p); });
+
+  Digger digger(convex, std::move(inner));
+  digger.Dig(concavity, minEdgeLength);
+  m_hull = digger.GetHull();
+}
+}  // namespace m2
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "geometry/point2d.hpp"
+
+#include <vector>
+
+namespace m2
+{
+class ConcaveHull
+{
+public:
+  // Builds a concave hull around |points| by "digging" into the convex hull: an edge of the
+  // hull is replaced by two edges through the closest inner point while the edge is longer
+  // than |minEdgeLength| and longer than |concavity| times the distance from the point to
+  // the nearest end of the edge. The hull stays simple and contains all the |points|.
+  // The hull polygon points are listed in the order of a counterclockwise traversal.
+  //
+  // The inner points and the hull edges are kept in a uniform grid, so a dig step looks only
+  // at the points and the edges near the dug edge.
+  ConcaveHull(std::vector<PointD> const & points, double concavity, double minEdgeLength,
+              double eps);
+
+  size_t Size() const { return m_hull.size(); }
+  bool Empty() const { return m_hull.empty(); }
+
+  std::vector<PointD> const & Points() const { return m_hull; }
+
+private:
+  std::vector<PointD> m_hull;
+};
+}  // namespace m2
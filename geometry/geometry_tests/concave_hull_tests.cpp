@@ -0,0 +1,78 @@
+#include "testing/testing.hpp"
+
+#include "geometry/concave_hull.hpp"
+#include "geometry/convex_hull.hpp"
+#include "geometry/point2d.hpp"
+#include "geometry/region2d.hpp"
+
+#include <vector>
+
+namespace concave_hull_tests
+{
+using namespace m2;
+using namespace std;
+
+double constexpr kEps = 1e-12;
+
+UNIT_TEST(ConcaveHull_Smoke)
+{
+  TEST_EQUAL(ConcaveHull({}, 2.0 /* concavity */, 0.0 /* minEdgeLength */, kEps).Points(),
+             vector<PointD>{}, ());
+  TEST_EQUAL(ConcaveHull({PointD(0, 0), PointD(1, 1)}, 2.0, 0.0, kEps).Points(),
+             vector<PointD>({PointD(0, 0), PointD(1, 1)}), ());
+
+  // Inner point is too far from the edges to dig.
+  vector<PointD> const square = {PointD(0, 0), PointD(4, 0), PointD(4, 4), PointD(0, 4), PointD(2, 2)};
+  TEST_EQUAL(ConcaveHull(square, 2.0, 0.0, kEps).Points(), ConvexHull(square, kEps).Points(), ());
+}
+
+UNIT_TEST(ConcaveHull_Notch)
+{
+  // Grid 11 x 11 with the notch [3, 10] x [4, 6] cut from the right side.
+  vector<PointD> points;
+  for (int x = 0; x <= 10; ++x)
+  {
+    for (int y = 0; y <= 10; ++y)
+    {
+      if (x < 3 || y < 4 || y > 6)
+        points.emplace_back(x, y);
+    }
+  }
+
+  auto const & hull = ConcaveHull(points, 2.0 /* concavity */, 1.5 /* minEdgeLength */, kEps).Points();
+  Region<PointD> const region(hull.begin(), hull.end());
+
+  for (auto const & p : points)
+    TEST(region.Contains(p) || region.AtBorder(p, kEps), (p, hull));
+
+  for (int x = 4; x <= 10; ++x)
+    TEST(!region.Contains(PointD(x, 5)), (x, hull));
+
+  // Counterclockwise.
+  TEST_GREATER(region.CalculateArea(), 0.0, ());
+  TEST_LESS(region.CalculateArea(), 100.0, ());
+}
+
+UNIT_TEST(ConcaveHull_Large)
+{
+  // Grid 300 x 300 with the notch [100, 299] x [140, 160] cut from the right side.
+  vector<PointD> points;
+  for (int x = 0; x < 300; ++x)
+  {
+    for (int y = 0; y < 300; ++y)
+    {
+      if (x < 100 || y < 140 || y > 160)
+        points.emplace_back(x, y);
+    }
+  }
+
+  auto const & hull = ConcaveHull(points, 2.0 /* concavity */, 1.5 /* minEdgeLength */, kEps).Points();
+  Region<PointD> const region(hull.begin(), hull.end());
+
+  for (auto const & p : points)
+    TEST(region.Contains(p) || region.AtBorder(p, kEps), (p));
+
+  for (int x = 110; x < 300; x += 10)
+    TEST(!region.Contains(PointD(x, 150)), (x));
+}
+}  // namespace concave_hull_tests
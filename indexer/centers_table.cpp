@@ -34,14 +34,17 @@ bool CentersTable::Get(uint32_t id, m2::PointD & center)
   if (!m_map->Get(id, pointu))
     return false;
 
+  center = Decode(pointu);
+  return true;
+}
+
+m2::PointD CentersTable::Decode(m2::PointU const & pointu) const
+{
   if (m_version == Version::V0)
-    center = PointUToPointD(pointu, m_codingParams.GetCoordBits());
-  else if (m_version == Version::V1)
-    center = PointUToPointD(pointu, m_codingParams.GetCoordBits(), m_limitRect);
-  else
-    CHECK(false, ("Unknown CentersTable format."));
+    return PointUToPointD(pointu, m_codingParams.GetCoordBits());
 
-  return true;
+  CHECK(m_version == Version::V1, ("Unknown CentersTable format."));
+  return PointUToPointD(pointu, m_codingParams.GetCoordBits(), m_limitRect);
 }
 
 // CentersTable ------------------------------------------------------------------------------------
@@ -94,7 +94,7 @@ void ReadFeatureType(std::function<void(FeatureType &)> const & fn, FeatureSourc
   }
   case FeatureStatus::Untouched:
   {
-    ft = src.GetOriginalFeature(index);
+    ft = src.GetCachedOriginalFeature(index, FeatureCache::kDefaultParts);
     break;
   }
   }
@@ -129,7 +129,8 @@ std::unique_ptr<FeatureType> FeaturesLoaderGuard::GetOriginalOrEditedFeatureByIn
   return GetFeatureByIndex(index);
 }
 
-std::unique_ptr<FeatureType> FeaturesLoaderGuard::GetFeatureByIndex(uint32_t index) const
+std::unique_ptr<FeatureType> FeaturesLoaderGuard::GetFeatureByIndex(uint32_t index, uint8_t parts,
+                                                                    int scale) const
 {
   ASSERT(m_handle.IsAlive(), ());
   ASSERT_NOT_EQUAL(FeatureStatus::Deleted, m_source->GetFeatureStatus(index),
@@ -139,7 +140,7 @@ std::unique_ptr<FeatureType> FeaturesLoaderGuard::GetFeatureByIndex(uint32_t ind
   if (ft)
     return ft;
 
-  return GetOriginalFeatureByIndex(index);
+  return m_handle.IsAlive() ? m_source->GetCachedOriginalFeature(index, parts, scale) : nullptr;
 }
 
 std::unique_ptr<FeatureType> FeaturesLoaderGuard::GetOriginalFeatureByIndex(uint32_t index) const
@@ -302,7 +303,7 @@ void DataSource::ReadFeatures(FeatureCallback const & fn, std::vector<FeatureID>
         if (fts == FeatureStatus::Modified || fts == FeatureStatus::Created)
           ft = src->GetModifiedFeature(fidIter->m_index);
         else
-          ft = src->GetOriginalFeature(fidIter->m_index);
+          ft = src->GetCachedOriginalFeature(fidIter->m_index, FeatureCache::kDefaultParts);
 
         CHECK(ft, ());
         fn(*ft);
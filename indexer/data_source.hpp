@@ -103,7 +103,13 @@ public:
   std::unique_ptr<FeatureType> GetOriginalFeatureByIndex(uint32_t index) const;
   std::unique_ptr<FeatureType> GetOriginalOrEditedFeatureByIndex(uint32_t index) const;
   /// Everyone, except Editor core, should use this method.
-  std::unique_ptr<FeatureType> GetFeatureByIndex(uint32_t index) const;
+  std::unique_ptr<FeatureType> GetFeatureByIndex(uint32_t index) const
+  {
+    return GetFeatureByIndex(index, FeatureCache::kDefaultParts);
+  }
+  /// Original features are taken from FeatureCache (when it's enabled) with |parts| already parsed.
+  std::unique_ptr<FeatureType> GetFeatureByIndex(uint32_t index, uint8_t parts,
+                                                 int scale = FeatureCache::kNoScale) const;
   size_t GetNumFeatures() const { return m_source->GetNumFeatures(); }
 
 private:
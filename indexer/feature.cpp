@@ -254,6 +254,44 @@ std::unique_ptr<FeatureType> FeatureType::CreateFromMapObject(osm::MapObject con
   return ft;
 }
 
+std::unique_ptr<FeatureType> FeatureType::Clone(SharedLoadInfo const * loadInfo,
+                                                indexer::MetadataDeserializer * metadataDeserializer) const
+{
+  auto ft = std::unique_ptr<FeatureType>(new FeatureType());
+
+  ft->m_header = m_header;
+  ft->m_types = m_types;
+  ft->m_id = m_id;
+  ft->m_params = m_params;
+  ft->m_center = m_center;
+  ft->m_limitRect = m_limitRect;
+  ft->m_points = m_points;
+  ft->m_triangles = m_triangles;
+  ft->m_metadata = m_metadata;
+  ft->m_metaIds = m_metaIds;
+  // Features created from MapObjects don't have load info and are fully parsed.
+  ft->m_loadInfo = m_loadInfo ? loadInfo : nullptr;
+  ft->m_data = m_data;
+  ft->m_metadataDeserializer = metadataDeserializer;
+  ft->m_parsed = m_parsed;
+  ft->m_offsets = m_offsets;
+  ft->m_ptsSimpMask = m_ptsSimpMask;
+  ft->m_innerStats = m_innerStats;
+  return ft;
+}
+
+size_t FeatureType::GetMemorySize() const
+{
+  // Rough estimation of a metadata entry size (map node and short string).
+  size_t constexpr kMetadataEntrySize = 64;
+
+  // Points are counted even if they fit into the static part of the buffer, it's ok for estimation.
+  return sizeof(FeatureType) + m_data.capacity() + m_params.name.GetBuffer().capacity() +
+         m_params.ref.capacity() + m_metadata.Size() * kMetadataEntrySize +
+         m_metaIds.capacity() * sizeof(indexer::MetadataDeserializer::MetaIds::value_type) +
+         (m_points.size() + m_triangles.size()) * sizeof(m2::PointD);
+}
+
 feature::GeomType FeatureType::GetGeomType() const
 {
   // FeatureType::FeatureType(osm::MapObject const & emo) expects
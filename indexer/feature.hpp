@@ -39,6 +39,16 @@ public:
 
   static std::unique_ptr<FeatureType> CreateFromMapObject(osm::MapObject const & emo);
 
+  /// Makes a copy of the feature with all the parsed data. The copy is bound to |loadInfo| and
+  /// |metadataDeserializer| of the reader which will be used to parse the rest of the feature.
+  std::unique_ptr<FeatureType> Clone(feature::SharedLoadInfo const * loadInfo,
+                                     indexer::MetadataDeserializer * metadataDeserializer) const;
+  /// Makes a copy bound to the same reader.
+  std::unique_ptr<FeatureType> Clone() const { return Clone(m_loadInfo, m_metadataDeserializer); }
+
+  /// Approximate size of the feature in memory, including the parsed data.
+  size_t GetMemorySize() const;
+
   feature::GeomType GetGeomType() const;
 
   uint8_t GetTypesCount() const { return (m_header & feature::HEADER_MASK_TYPE) + 1; }
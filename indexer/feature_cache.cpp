@@ -0,0 +1,177 @@
+#include "indexer/feature_cache.hpp"
+
+#include "indexer/feature.hpp"
+
+#include "base/assert.hpp"
+#include "base/macros.hpp"
+
+#include <functional>
+#include <iterator>
+#include <sstream>
+
+namespace
+{
+void ParseParts(FeatureType & ft, uint8_t parts, int scale)
+{
+  if (parts & FeatureCache::kTypes)
+    ft.ForEachType([](uint32_t) {});
+  if (parts & FeatureCache::kCommon)
+    UNUSED_VALUE(ft.GetNames());
+  if (parts & FeatureCache::kMetadata)
+    UNUSED_VALUE(ft.GetMetadata());
+  if (parts & FeatureCache::kGeometry)
+  {
+    ft.ParseGeometry(scale);
+    ft.ParseTriangles(scale);
+  }
+}
+}  // namespace
+
+size_t FeatureCache::KeyHash::operator()(Key const & key) const
+{
+  size_t const h = std::hash<FeatureID>()(key.m_id);
+  return h ^ (static_cast<size_t>(key.m_parts) << 8) ^ (static_cast<size_t>(key.m_scale + 1) << 16);
+}
+
+FeatureCache::FeatureCache(size_t budgetBytes) : m_budget(budgetBytes) {}
+
+// static
+FeatureCache & FeatureCache::Instance()
+{
+  static FeatureCache instance;
+  return instance;
+}
+
+void FeatureCache::SetBudget(size_t budgetBytes)
+{
+  if (m_budget.exchange(budgetBytes) != budgetBytes)
+    Clear();
+}
+
+std::shared_ptr<FeatureType const> FeatureCache::Find(Key const & key)
+{
+  if (!IsEnabled())
+    return {};
+
+  Shard & shard = GetShard(key.m_id);
+  std::lock_guard<std::mutex> lock(shard.m_mutex);
+  auto const it = shard.m_index.find(key);
+  if (it == shard.m_index.end())
+  {
+    ++shard.m_stats.m_misses;
+    return {};
+  }
+
+  ++shard.m_stats.m_hits;
+  shard.m_lru.splice(shard.m_lru.begin(), shard.m_lru, it->second);
+  return it->second->m_feature;
+}
+
+void FeatureCache::Insert(Key const & key, FeatureType & ft)
+{
+  if (!IsEnabled())
+    return;
+
+  ParseParts(ft, key.m_parts, key.m_scale);
+
+  // Cached copy is never parsed further, so it's ok that its reader may be destroyed.
+  // Clients get features from the cache via Clone() bound to their own readers.
+  std::shared_ptr<FeatureType const> copy = ft.Clone();
+  size_t const size = copy->GetMemorySize();
+  size_t const budget = GetShardBudget();
+  if (size > budget)
+    return;
+
+  Shard & shard = GetShard(key.m_id);
+  std::lock_guard<std::mutex> lock(shard.m_mutex);
+  if (shard.m_index.count(key) != 0)
+    return;
+
+  while (!shard.m_lru.empty() && shard.m_bytes + size > budget)
+  {
+    Erase(shard, std::prev(shard.m_lru.end()));
+    ++shard.m_stats.m_evictions;
+  }
+
+  shard.m_lru.push_front({key, std::move(copy), size});
+  shard.m_index.emplace(key, shard.m_lru.begin());
+  shard.m_bytes += size;
+}
+
+void FeatureCache::DropMwm(MwmSet::MwmId const & id)
+{
+  DropIf([&id](Key const & key) { return key.m_id.m_mwmId == id; });
+}
+
+void FeatureCache::DropFeature(FeatureID const & id)
+{
+  Shard & shard = GetShard(id);
+  std::lock_guard<std::mutex> lock(shard.m_mutex);
+  for (auto it = shard.m_lru.begin(); it != shard.m_lru.end();)
+  {
+    auto const next = std::next(it);
+    if (it->m_key.m_id == id)
+      Erase(shard, it);
+    it = next;
+  }
+}
+
+void FeatureCache::Clear()
+{
+  DropIf([](Key const &) { return true; });
+}
+
+FeatureCache::Stats FeatureCache::GetStats() const
+{
+  Stats stats;
+  for (auto const & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    stats.m_hits += shard.m_stats.m_hits;
+    stats.m_misses += shard.m_stats.m_misses;
+    stats.m_evictions += shard.m_stats.m_evictions;
+    stats.m_entries += shard.m_lru.size();
+    stats.m_bytes += shard.m_bytes;
+  }
+  return stats;
+}
+
+FeatureCache::Shard & FeatureCache::GetShard(FeatureID const & id)
+{
+  // All the entries of a feature are in the same shard to make DropFeature() cheap.
+  return m_shards[std::hash<FeatureID>()(id) % kShardsCount];
+}
+
+template <typename Pred>
+void FeatureCache::DropIf(Pred && pred)
+{
+  for (auto & shard : m_shards)
+  {
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    for (auto it = shard.m_lru.begin(); it != shard.m_lru.end();)
+    {
+      auto const next = std::next(it);
+      if (pred(it->m_key))
+        Erase(shard, it);
+      it = next;
+    }
+  }
+}
+
+// static
+void FeatureCache::Erase(Shard & shard, std::list<Entry>::iterator it)
+{
+  ASSERT_GREATER_OR_EQUAL(shard.m_bytes, it->m_size, ());
+  shard.m_bytes -= it->m_size;
+  shard.m_index.erase(it->m_key);
+  shard.m_lru.erase(it);
+}
+
+std::string DebugPrint(FeatureCache::Stats const & stats)
+{
+  std::ostringstream out;
+  out << "FeatureCache::Stats [ Hits: " << stats.m_hits << " Misses: " << stats.m_misses
+      << " HitRate: " << stats.GetHitRate() << " Evictions: " << stats.m_evictions
+      << " Entries: " << stats.m_entries << " Bytes: " << stats.m_bytes << " ]";
+  return out.str();
+}
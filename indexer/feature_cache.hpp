@@ -0,0 +1,137 @@
+#pragma once
+
+#include "indexer/feature_decl.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include "base/macros.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class FeatureType;
+
+/// Process-wide cache of parsed features shared by all the subsystems (rendering, search, routing,
+/// place pages and so on). Features are cached with some of their parts already parsed, the key is
+/// (FeatureID, parts, scale). Only original (not edited) features are stored in the cache.
+/// The cache is disabled by default, use SetBudget() to enable it. Thread-safe.
+class FeatureCache
+{
+public:
+  /// Parts of the feature which are parsed before caching.
+  enum Parts : uint8_t
+  {
+    kTypes = 1 << 0,
+    // Names, layer, rank, house number, ref and center for point features.
+    kCommon = 1 << 1,
+    kMetadata = 1 << 2,
+    // Points and triangles of the scale from the key.
+    kGeometry = 1 << 3,
+
+    kDefaultParts = kTypes | kCommon
+  };
+
+  static int constexpr kNoScale = -1;
+  static size_t constexpr kShardsCount = 16;
+
+  struct Key
+  {
+    Key(FeatureID const & id, uint8_t parts, int scale)
+      : m_id(id), m_parts(parts), m_scale((parts & kGeometry) ? scale : kNoScale)
+    {
+    }
+
+    bool operator==(Key const & rhs) const
+    {
+      return m_id == rhs.m_id && m_parts == rhs.m_parts && m_scale == rhs.m_scale;
+    }
+
+    FeatureID m_id;
+    uint8_t m_parts;
+    int m_scale;
+  };
+
+  struct Stats
+  {
+    double GetHitRate() const
+    {
+      uint64_t const total = m_hits + m_misses;
+      return total == 0 ? 0.0 : static_cast<double>(m_hits) / static_cast<double>(total);
+    }
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    size_t m_entries = 0;
+    size_t m_bytes = 0;
+  };
+
+  explicit FeatureCache(size_t budgetBytes = 0);
+
+  static FeatureCache & Instance();
+
+  /// Sets memory budget of the cache in bytes and drops all the features if it's changed.
+  /// Zero budget disables the cache.
+  void SetBudget(size_t budgetBytes);
+  bool IsEnabled() const { return m_budget.load(std::memory_order_relaxed) != 0; }
+
+  /// @returns cached feature or nullptr. Cached feature must not be changed, use
+  /// FeatureType::Clone() to get a modifiable copy.
+  std::shared_ptr<FeatureType const> Find(Key const & key);
+
+  /// Parses key's parts of |ft| and puts the copy of it into the cache.
+  void Insert(Key const & key, FeatureType & ft);
+
+  /// Drops all features of |id|, should be called when mwm is deregistered.
+  void DropMwm(MwmSet::MwmId const & id);
+  /// Drops all entries of the feature, should be called when the feature is edited.
+  void DropFeature(FeatureID const & id);
+  void Clear();
+
+  Stats GetStats() const;
+
+private:
+  struct KeyHash
+  {
+    size_t operator()(Key const & key) const;
+  };
+
+  struct Entry
+  {
+    Key m_key;
+    std::shared_ptr<FeatureType const> m_feature;
+    size_t m_size;
+  };
+
+  struct Shard
+  {
+    std::mutex mutable m_mutex;
+    // Most recently used entries are in the front.
+    std::list<Entry> m_lru;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+    size_t m_bytes = 0;
+    Stats m_stats;
+  };
+
+  Shard & GetShard(FeatureID const & id);
+  size_t GetShardBudget() const { return m_budget.load(std::memory_order_relaxed) / kShardsCount; }
+
+  template <typename Pred>
+  void DropIf(Pred && pred);
+
+  // Removes |it| from the shard. The shard must be locked.
+  static void Erase(Shard & shard, std::list<Entry>::iterator it);
+
+  std::atomic<size_t> m_budget;
+  std::array<Shard, kShardsCount> m_shards;
+
+  DISALLOW_COPY_AND_MOVE(FeatureCache);
+};
+
+std::string DebugPrint(FeatureCache::Stats const & stats);
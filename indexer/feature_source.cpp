@@ -41,6 +41,24 @@ std::unique_ptr<FeatureType> FeatureSource::GetOriginalFeature(uint32_t index) c
   return ft;
 }
 
+std::unique_ptr<FeatureType> FeatureSource::GetCachedOriginalFeature(uint32_t index, uint8_t parts,
+                                                                     int scale) const
+{
+  auto & cache = FeatureCache::Instance();
+  if (!cache.IsEnabled())
+    return GetOriginalFeature(index);
+
+  ASSERT(m_handle.IsAlive(), ());
+  ASSERT(m_vector, ());
+  FeatureCache::Key const key({GetMwmId(), index}, parts, scale);
+  if (auto const cached = cache.Find(key))
+    return m_vector->Clone(*cached);
+
+  auto ft = GetOriginalFeature(index);
+  cache.Insert(key, *ft);
+  return ft;
+}
+
 FeatureStatus FeatureSource::GetFeatureStatus(uint32_t index) const
 {
   return FeatureStatus::Untouched;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "indexer/feature.hpp"
+#include "indexer/feature_cache.hpp"
 #include "indexer/features_vector.hpp"
 #include "indexer/mwm_set.hpp"
 
@@ -34,6 +35,10 @@ public:
   size_t GetNumFeatures() const;
 
   std::unique_ptr<FeatureType> GetOriginalFeature(uint32_t index) const;
+  /// Same as GetOriginalFeature, but takes the feature from FeatureCache (when it's enabled)
+  /// with |parts| (see FeatureCache::Parts) already parsed.
+  std::unique_ptr<FeatureType> GetCachedOriginalFeature(uint32_t index, uint8_t parts,
+                                                        int scale = FeatureCache::kNoScale) const;
 
   MwmSet::MwmId const & GetMwmId() const { return m_handle.GetId(); }
 
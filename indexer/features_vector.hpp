@@ -25,6 +25,12 @@ public:
 
   std::unique_ptr<FeatureType> GetByIndex(uint32_t index) const;
 
+  /// Copies |ft| loaded by another vector of the same mwm (e.g. taken from FeatureCache).
+  std::unique_ptr<FeatureType> Clone(FeatureType const & ft) const
+  {
+    return ft.Clone(&m_loadInfo, m_metaDeserializer);
+  }
+
   size_t GetNumFeatures() const;
 
   template <class ToDo> void ForEach(ToDo && toDo) const
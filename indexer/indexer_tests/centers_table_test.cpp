@@ -17,6 +17,7 @@
 #include "base/file_name_utils.hpp"
 
 #include <cstdint>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -152,6 +153,18 @@ UNIT_CLASS_TEST(CentersTableTest, Subset)
       while (j != features.size() && features[j].first < i)
         ++j;
     }
+
+    vector<uint32_t> ids(100);
+    iota(ids.begin(), ids.end(), 0);
+    j = 0;
+    table->GetMany(ids, [&](uint32_t id, m2::PointD const & actual)
+    {
+      TEST_LESS(j, features.size(), ());
+      TEST_EQUAL(id, features[j].first, ());
+      TEST_LESS_OR_EQUAL(mercator::DistanceOnEarth(actual, features[j].second), 1.0, ());
+      ++j;
+    });
+    TEST_EQUAL(j, features.size(), ());
   }
 }
 }  // namespace
@@ -0,0 +1,106 @@
+#include "testing/testing.hpp"
+
+#include "indexer/classificator.hpp"
+#include "indexer/classificator_loader.hpp"
+#include "indexer/editable_map_object.hpp"
+#include "indexer/feature.hpp"
+#include "indexer/feature_cache.hpp"
+#include "indexer/mwm_set.hpp"
+
+#include <memory>
+#include <string>
+
+namespace feature_cache_tests
+{
+using namespace std;
+
+unique_ptr<FeatureType> MakeFeature(FeatureID const & id, string const & name)
+{
+  osm::EditableMapObject emo;
+  feature::TypesHolder types;
+  types.Add(classif().GetTypeByPath({"amenity", "cafe"}));
+  emo.SetTypes(types);
+  emo.SetName(name, StringUtf8Multilang::kDefaultCode);
+  emo.SetPointType();
+  emo.SetMercator(m2::PointD(1.0, 1.0));
+  emo.SetID(id);
+  return FeatureType::CreateFromMapObject(emo);
+}
+
+UNIT_TEST(FeatureCache_Smoke)
+{
+  classificator::Load();
+
+  MwmSet::MwmId const mwmId(make_shared<MwmInfo>());
+  FeatureID const id(mwmId, 1);
+  FeatureCache::Key const key(id, FeatureCache::kDefaultParts, 17 /* scale */);
+
+  FeatureCache cache;
+  TEST(!cache.IsEnabled(), ());
+  auto ft = MakeFeature(id, "Cafe");
+  cache.Insert(key, *ft);
+  TEST(!cache.Find(key), ());
+
+  cache.SetBudget(1024 * 1024);
+  TEST(!cache.Find(key), ());
+  cache.Insert(key, *ft);
+
+  auto const cached = cache.Find(key);
+  TEST(cached, ());
+  auto const copy = cached->Clone();
+  TEST_EQUAL(copy->GetID(), id, ());
+  TEST_EQUAL(copy->GetReadableName(), "Cafe", ());
+  TEST_EQUAL(copy->GetCenter(), m2::PointD(1.0, 1.0), ());
+
+  // Scale is the part of the key for the geometry only.
+  TEST(cache.Find(FeatureCache::Key(id, FeatureCache::kDefaultParts, 10 /* scale */)), ());
+  TEST(!cache.Find(FeatureCache::Key(id, FeatureCache::kGeometry, 17 /* scale */)), ());
+
+  auto stats = cache.GetStats();
+  TEST_EQUAL(stats.m_hits, 2, ());
+  TEST_EQUAL(stats.m_misses, 2, ());
+  TEST_EQUAL(stats.m_entries, 1, ());
+  TEST_EQUAL(stats.m_bytes, cached->GetMemorySize(), ());
+
+  cache.DropFeature(id);
+  TEST(!cache.Find(key), ());
+
+  cache.Insert(key, *ft);
+  cache.DropMwm(MwmSet::MwmId(make_shared<MwmInfo>()));
+  TEST(cache.Find(key), ());
+  cache.DropMwm(mwmId);
+  TEST(!cache.Find(key), ());
+  TEST_EQUAL(cache.GetStats().m_bytes, 0, ());
+}
+
+UNIT_TEST(FeatureCache_Budget)
+{
+  classificator::Load();
+
+  MwmSet::MwmId const mwmId(make_shared<MwmInfo>());
+  size_t const featureSize = MakeFeature(FeatureID(mwmId, 0), "Cafe")->GetMemorySize();
+
+  // Features of every shard should fit into the shard budget.
+  size_t constexpr kFeaturesPerShard = 4;
+  FeatureCache cache(featureSize * kFeaturesPerShard * FeatureCache::kShardsCount);
+
+  uint32_t constexpr kCount = 1000;
+  for (uint32_t i = 0; i < kCount; ++i)
+  {
+    FeatureID const id(mwmId, i);
+    cache.Insert(FeatureCache::Key(id, FeatureCache::kDefaultParts, FeatureCache::kNoScale),
+                 *MakeFeature(id, "Cafe"));
+  }
+
+  auto const stats = cache.GetStats();
+  TEST_LESS_OR_EQUAL(stats.m_entries, kFeaturesPerShard * FeatureCache::kShardsCount, ());
+  TEST_GREATER(stats.m_entries, 0, ());
+  TEST_LESS_OR_EQUAL(stats.m_bytes, featureSize * kFeaturesPerShard * FeatureCache::kShardsCount, ());
+  TEST_EQUAL(stats.m_evictions + stats.m_entries, kCount, ());
+
+  // The last inserted feature is always cached.
+  TEST(cache.Find(FeatureCache::Key(FeatureID(mwmId, kCount - 1), FeatureCache::kDefaultParts,
+                                    FeatureCache::kNoScale)),
+       ());
+}
+}  // namespace feature_cache_tests
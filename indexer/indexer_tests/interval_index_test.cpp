@@ -9,6 +9,7 @@
 #include "base/macros.hpp"
 #include "base/stl_helpers.hpp"
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -34,6 +35,27 @@ auto IndexValueInserter(vector<uint32_t> & values)
   return [inserter = base::MakeBackInsertFunctor(values)] (uint64_t, auto value) { inserter(value); };
 };
 
+class CountingReader : public MemReader
+{
+public:
+  CountingReader(void const * pData, size_t size) : MemReader(pData, size) {}
+
+  void Read(uint64_t pos, void * p, size_t size) const override
+  {
+    ++m_reads;
+    MemReader::Read(pos, p, size);
+  }
+
+  void Prefetch(uint64_t pos, size_t size) const override
+  {
+    TEST_LESS_OR_EQUAL(pos + size, Size(), ());
+    ++m_prefetches;
+  }
+
+  mutable size_t m_reads = 0;
+  mutable size_t m_prefetches = 0;
+};
+
 }
 
 UNIT_TEST(IntervalIndex_LevelCount)
@@ -291,3 +313,34 @@ UNIT_TEST(IntervalIndex_Simple5)
     TEST_EQUAL(values, vector<uint32_t>(expected, expected + ARRAY_SIZE(expected)), ());
   }
 }
+
+UNIT_TEST(IntervalIndex_BatchedChildrenReads)
+{
+  // 256 leaves under the same level 1 node.
+  vector<CellIdFeaturePairForTest> data;
+  for (uint32_t i = 0; i < 256; ++i)
+    data.emplace_back(0xA0B1C20000ULL + (uint64_t{i} << 8), i);
+  vector<char> serialIndex;
+  MemWriter<vector<char>> writer(serialIndex);
+  BuildIntervalIndex(data.begin(), data.end(), writer, 40);
+
+  ReaderPtr<CountingReader> reader(make_unique<CountingReader>(&serialIndex[0], serialIndex.size()));
+  IntervalIndex<ReaderPtr<CountingReader>, uint32_t> index(reader);
+  auto const & counter = *reader.GetPtr();
+  counter.m_reads = 0;
+  {
+    vector<uint32_t> values;
+    index.ForEach(IndexValueInserter(values), 0, index.KeyEnd());
+    TEST_EQUAL(values.size(), 256, ());
+    for (uint32_t i = 0; i < values.size(); ++i)
+      TEST_EQUAL(values[i], i, ());
+    // Root, one node per each of the 3 inner levels and all the leaves at once.
+    TEST_EQUAL(counter.m_reads, 5, ());
+    TEST_EQUAL(counter.m_prefetches, 3, ());
+  }
+  {
+    vector<uint32_t> values;
+    index.ForEach(IndexValueInserter(values), 0xA0B1C21000ULL, 0xA0B1C21300ULL);
+    TEST_EQUAL(values, vector<uint32_t>({0x10, 0x11, 0x12}), ());
+  }
+}
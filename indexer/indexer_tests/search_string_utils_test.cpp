@@ -1,9 +1,13 @@
+#include "testing/benchmark.hpp"
 #include "testing/testing.hpp"
 
 #include "indexer/search_string_utils.hpp"
 
+#include "base/logging.hpp"
 #include "base/string_utils.hpp"
+#include "base/timer.hpp"
 
+#include <random>
 #include <string>
 #include <vector>
 
@@ -288,4 +292,49 @@ UNIT_TEST(NormalizeAndSimplifyString_Apostrophe)
   TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Pop’s"), "pop's", ());
 }
 
+UNIT_TEST(NormalizeAndSimplifyString_ASCII)
+{
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8("Main  STREET, 1A"), "main street, 1a", ());
+  TEST_EQUAL(NormalizeAndSimplifyStringUtf8(""), "", ());
+
+  // Non-ASCII suffix makes the generic path to be taken, the result for the ASCII part should be
+  // the same as the ASCII fast path gives.
+  string allChars;
+  for (int c = 1; c < 0x80; ++c)
+    allChars.push_back(static_cast<char>(c));
+
+  mt19937 rng(0);
+  uniform_int_distribution<size_t> dist(0, allChars.size() - 1);
+  vector<string> strs = {allChars, "  ", "Ab  Cd "};
+  for (size_t i = 0; i < 100; ++i)
+  {
+    string s;
+    for (size_t j = 0; j < i; ++j)
+      s.push_back(allChars[dist(rng)]);
+    strs.push_back(s);
+  }
+
+  for (auto const & s : strs)
+  {
+    TEST_EQUAL(NormalizeAndSimplifyString(s + "Ж"), NormalizeAndSimplifyString(s) + MakeUniString("ж"),
+               (s));
+  }
+}
+
+BENCHMARK_TEST(NormalizeAndSimplifyString)
+{
+  vector<string> const names = {"Main Street", "Rue de la Paix", "Starbucks Coffee", "Hauptstraße",
+                                "Улица Ленина", "Café de Flore"};
+  size_t constexpr kIterations = 200000;
+
+  for (auto const & name : names)
+  {
+    base::Timer timer;
+    size_t size = 0;
+    for (size_t i = 0; i < kIterations; ++i)
+      size += NormalizeAndSimplifyString(name).size();
+    LOG(LINFO, (name, "ascii:", IsASCIIString(name), "ns per string:",
+                timer.ElapsedNanoseconds() / kIterations, size));
+  }
+}
 } // namespace search_string_utils_test
@@ -8,6 +8,7 @@
 #include "base/buffer_vector.hpp"
 
 #include <cstdint>
+#include <utility>
 
 class IntervalIndexBase
 {
@@ -65,25 +66,37 @@ public:
       if (end > KeyEnd())
         end = KeyEnd();
       --end;  // end is inclusive in ForEachImpl().
-      ForEachNode(f, beg, end, m_Header.m_Levels, 0,
-                  m_LevelOffsets[m_Header.m_Levels + 1] - m_LevelOffsets[m_Header.m_Levels],
-                  0 /* started keyBase */);
+
+      uint32_t const rootOffset = m_LevelOffsets[m_Header.m_Levels];
+      uint32_t const rootSize = m_LevelOffsets[m_Header.m_Levels + 1] - rootOffset;
+      ASSERT(rootSize > 0, ());
+      buffer_vector<uint8_t, 576> root;
+      root.resize(rootSize);
+      m_Reader.Read(rootOffset, &root[0], rootSize);
+      ForEachNode(f, beg, end, m_Header.m_Levels, &root[0], rootSize, 0 /* started keyBase */);
     }
   }
 
 private:
+  // Child of an inner node which intersects with the requested interval.
+  // |m_offset| is relative to the beginning of the child's level.
+  struct Child
+  {
+    uint32_t m_offset;
+    uint32_t m_size;
+    uint64_t m_beg;
+    uint64_t m_end;
+    uint64_t m_keyBase;
+  };
+
   template <typename F>
   void ForEachLeaf(F const & f, uint64_t const beg, uint64_t const end,
-      uint32_t const offset, uint32_t const size,
+      uint8_t const * data, uint32_t const size,
       uint64_t keyBase /* discarded part of object key value in the parent nodes*/) const
   {
-    buffer_vector<uint8_t, 1024> data;
-    data.resize(size);
-
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+    ArrayByteSource src(data);
 
-    void const * pEnd = &data[0] + size;
+    void const * pEnd = data + size;
     Value value = 0;
     while (src.Ptr() < pEnd)
     {
@@ -98,20 +111,58 @@ private:
     }
   }
 
+  // Traverses already read node |data| of |level|. Children which intersect with [beg, end]
+  // are stored contiguously on the next level, so all of them are fetched with one read
+  // and the level below them is prefetched before descending.
   template <typename F>
   void ForEachNode(F const & f, uint64_t beg, uint64_t end, int level,
-      uint32_t offset, uint32_t size,
+      uint8_t const * data, uint32_t size,
       uint64_t keyBase /* discarded part of object key value in the parent nodes */) const
   {
     ASSERT(size > 0, ());
-    offset += m_LevelOffsets[level];
 
     if (level == 0)
     {
-      ForEachLeaf(f, beg, end, offset, size, keyBase);
+      ForEachLeaf(f, beg, end, data, size, keyBase);
       return;
     }
 
+    buffer_vector<Child, 32> children;
+    CollectChildren(beg, end, level, data, size, keyBase, children);
+    if (children.empty())
+      return;
+
+    uint32_t const childrenOffset = children.front().m_offset;
+    uint32_t const childrenSize = children.back().m_offset + children.back().m_size - childrenOffset;
+
+    buffer_vector<uint8_t, 1024> childrenData;
+    childrenData.resize(childrenSize);
+    m_Reader.Read(m_LevelOffsets[level - 1] + childrenOffset, &childrenData[0], childrenSize);
+
+    if (level > 1)
+    {
+      // Grandchildren of the first and the last children bound the range to be scanned next.
+      uint32_t const firstOffset = GetChildrenRange(&childrenData[0], children.front().m_size).first;
+      auto const lastRange = GetChildrenRange(
+          &childrenData[children.back().m_offset - childrenOffset], children.back().m_size);
+      if (lastRange.first + lastRange.second > firstOffset)
+      {
+        m_Reader.Prefetch(m_LevelOffsets[level - 2] + firstOffset,
+                          lastRange.first + lastRange.second - firstOffset);
+      }
+    }
+
+    for (auto const & child : children)
+    {
+      ForEachNode(f, child.m_beg, child.m_end, level - 1,
+                  &childrenData[child.m_offset - childrenOffset], child.m_size, child.m_keyBase);
+    }
+  }
+
+  template <typename Children>
+  void CollectChildren(uint64_t beg, uint64_t end, int level, uint8_t const * data, uint32_t size,
+                       uint64_t keyBase, Children & children) const
+  {
     uint8_t const skipBits = (m_Header.m_LeafBytes << 3) + (level - 1) * m_Header.m_BitsPerLevel;
     ASSERT_LESS_OR_EQUAL(beg, end, (skipBits));
 
@@ -120,12 +171,13 @@ private:
     uint32_t const end0 = static_cast<uint32_t>(end >> skipBits);
     ASSERT_LESS(end0, (1U << m_Header.m_BitsPerLevel), (beg, end, skipBits));
 
-    buffer_vector<uint8_t, 576> data;
-    data.resize(size);
-
-    m_Reader.Read(offset, &data[0], size);
-    ArrayByteSource src(&data[0]);
+    auto const addChild = [&](uint32_t i, uint32_t childOffset, uint32_t childSize) {
+      uint64_t const beg1 = (i == beg0) ? (beg & levelBytesFF) : 0;
+      uint64_t const end1 = (i == end0) ? (end & levelBytesFF) : levelBytesFF;
+      children.push_back({childOffset, childSize, beg1, end1, keyBase + (uint64_t{i} << skipBits)});
+    };
 
+    ArrayByteSource src(data);
     uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
     uint32_t childOffset = offsetAndFlag >> 1;
     if (offsetAndFlag & 1)
@@ -139,21 +191,17 @@ private:
         {
           uint32_t childSize = ReadVarUint<uint32_t>(src);
           if (i >= beg0)
-          {
-            uint64_t const beg1 = (i == beg0) ? (beg & levelBytesFF) : 0;
-            uint64_t const end1 = (i == end0) ? (end & levelBytesFF) : levelBytesFF;
-            ForEachNode(f, beg1, end1, level - 1, childOffset, childSize, keyBase + (uint64_t{i} << skipBits));
-          }
+            addChild(i, childOffset, childSize);
           childOffset += childSize;
         }
       }
       ASSERT(end0 != (static_cast<uint32_t>(1) << m_Header.m_BitsPerLevel) - 1 ||
-             src.Ptr() == data.data() + size,
-             (beg, end, beg0, end0, offset, size, src.Ptr(), data.data()));
+             src.Ptr() == data + size,
+             (beg, end, beg0, end0, size, src.Ptr(), data));
     }
     else
     {
-      void const * pEnd = &data[0] + size;
+      void const * pEnd = data + size;
       while (src.Ptr() < pEnd)
       {
         uint8_t const i = src.ReadByte();
@@ -161,16 +209,38 @@ private:
           break;
         uint32_t childSize = ReadVarUint<uint32_t>(src);
         if (i >= beg0)
-        {
-          uint64_t const beg1 = (i == beg0) ? (beg & levelBytesFF) : 0;
-          uint64_t const end1 = (i == end0) ? (end & levelBytesFF) : levelBytesFF;
-          ForEachNode(f, beg1, end1, level - 1, childOffset, childSize, keyBase + (uint64_t{i} << skipBits));
-        }
+          addChild(i, childOffset, childSize);
         childOffset += childSize;
       }
     }
   }
 
+  // Returns offset and total size of all children of an inner node.
+  std::pair<uint32_t, uint32_t> GetChildrenRange(uint8_t const * data, uint32_t size) const
+  {
+    ArrayByteSource src(data);
+    uint32_t const offsetAndFlag = ReadVarUint<uint32_t>(src);
+    uint32_t childrenSize = 0;
+    if (offsetAndFlag & 1)
+    {
+      uint32_t const bitmapSize = BitmapSize(m_Header.m_BitsPerLevel);
+      src.Advance(bitmapSize);
+      void const * pEnd = data + size;
+      while (src.Ptr() < pEnd)
+        childrenSize += ReadVarUint<uint32_t>(src);
+    }
+    else
+    {
+      void const * pEnd = data + size;
+      while (src.Ptr() < pEnd)
+      {
+        src.ReadByte();
+        childrenSize += ReadVarUint<uint32_t>(src);
+      }
+    }
+    return {offsetAndFlag >> 1, childrenSize};
+  }
+
   ReaderT m_Reader;
   Header m_Header;
   buffer_vector<uint32_t, 7> m_LevelOffsets;
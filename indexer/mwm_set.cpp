@@ -1,5 +1,6 @@
 #include "indexer/mwm_set.hpp"
 
+#include "indexer/feature_cache.hpp"
 #include "indexer/features_offsets_table.hpp"
 #include "indexer/scales.hpp"
 
@@ -173,6 +174,7 @@ bool MwmSet::DeregisterImpl(MwmId const & id, EventList & events)
         break;
       }
     }
+    FeatureCache::Instance().DropMwm(id);
     return true;
   }
 
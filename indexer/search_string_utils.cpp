@@ -5,6 +5,7 @@
 #include "coding/transliteration.hpp"
 
 #include "base/dfa_helpers.hpp"
+#include "base/levenshtein_dfa_cache.hpp"
 #include "base/mem_trie.hpp"
 
 #include <algorithm>
@@ -45,6 +46,17 @@ std::pair<UniString, UniString> const kPreprocessReplacements[] = {
     {MakeUniString("м-н"), MakeUniString("микрорайон")},
 };
 
+// Max number of cached automata. Automata for long tokens with 2 errors take tens of kilobytes.
+size_t constexpr kMaxDFACacheSize = 256;
+
+LevenshteinDFACache & GetDFACache()
+{
+  // In search we use LevenshteinDFAs for fuzzy matching. But due to
+  // performance reasons, we limit prefix misprints to fixed set of substitutions defined in
+  // kAllowedMisprints and skipped letters.
+  static LevenshteinDFACache cache(1 /* prefixSize */, kAllowedMisprints, kMaxDFACacheSize);
+  return cache;
+}
 
 void TransliterateHiraganaToKatakana(UniString & s)
 {
@@ -70,10 +82,7 @@ size_t GetMaxErrorsForToken(UniString const & token)
 LevenshteinDFA BuildLevenshteinDFA(UniString const & s)
 {
   ASSERT(!s.empty(), ());
-  // In search we use LevenshteinDFAs for fuzzy matching. But due to
-  // performance reasons, we limit prefix misprints to fixed set of substitutions defined in
-  // kAllowedMisprints and skipped letters.
-  return LevenshteinDFA(s, 1 /* prefixSize */, kAllowedMisprints, GetMaxErrorsForToken(s));
+  return GetDFACache().Get(s, GetMaxErrorsForToken(s));
 }
 
 LevenshteinDFA BuildLevenshteinDFA_Category(UniString const & s)
@@ -87,11 +96,27 @@ LevenshteinDFA BuildLevenshteinDFA_Category(UniString const & s)
   /// @todo "hote" doesn't match "hotel" now. Allow prefix search for categories?
 
   ASSERT(!s.empty(), ());
-  return LevenshteinDFA(s, 1 /* prefixSize */, kAllowedMisprints, GetMaxErrorsForToken_Category(s.size()));
+  return GetDFACache().Get(s, GetMaxErrorsForToken_Category(s.size()));
 }
 
 UniString NormalizeAndSimplifyString(std::string_view s)
 {
+  // Most of the queries and many of the names are ASCII. ASCII is not changed by the
+  // normalization, so only lower casing and spaces squashing are needed.
+  if (IsASCIIString(s))
+  {
+    UniString uniString;
+    uniString.reserve(s.size());
+    for (char const ch : s)
+    {
+      UniChar const c = static_cast<unsigned char>(ch);
+      if (c == ' ' && !uniString.empty() && uniString.back() == ' ')
+        continue;
+      uniString.push_back((c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c);
+    }
+    return uniString;
+  }
+
   UniString uniString = MakeUniString(s);
   for (size_t i = 0; i < uniString.size(); ++i)
   {
@@ -43,6 +43,8 @@ namespace bench
     double m_all = 0.0;
   };
 
-  /// @param[in] count number of times to run benchmark
-  void RunFeaturesLoadingBenchmark(std::string filePath, std::pair<int, int> scaleR, AllResult & res);
+  /// Runs benchmark res.size() times on the same registered mwm, so the later passes
+  /// may take the features from FeatureCache (if it's enabled).
+  void RunFeaturesLoadingBenchmark(std::string filePath, std::pair<int, int> scaleR,
+                                   std::vector<AllResult> & res);
 }  // namespace bench
@@ -99,7 +99,7 @@ namespace
   }
 }
 
-void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, AllResult & res)
+void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, vector<AllResult> & res)
 {
   base::GetNameFromFullPath(fileName);
   base::GetNameWithoutExt(fileName);
@@ -119,6 +119,7 @@ void RunFeaturesLoadingBenchmark(string fileName, pair<int, int> scaleRange, All
   if (scaleRange.first > scaleRange.second)
     return;
 
-  RunBenchmark(src, r.first.GetInfo()->m_bordersRect, scaleRange, res);
+  for (auto & passRes : res)
+    RunBenchmark(src, r.first.GetInfo()->m_bordersRect, scaleRange, passRes);
 }
 }  // namespace bench
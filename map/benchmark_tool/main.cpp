@@ -2,8 +2,11 @@
 
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_header.hpp"
+#include "indexer/feature_cache.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 #include <gflags/gflags.h>
 
@@ -13,6 +16,8 @@ DEFINE_string(input, "", "MWM file name in the data directory");
 DEFINE_int32(lowS, 10, "Low processing scale");
 DEFINE_int32(highS, 17, "High processing scale");
 DEFINE_bool(print_scales, false, "Print geometry scales for MWM and exit");
+DEFINE_int32(passes, 1, "Number of benchmark passes");
+DEFINE_int32(feature_cache_mb, 0, "Size of the shared feature cache in MB, 0 disables the cache");
 
 int main(int argc, char ** argv)
 {
@@ -41,10 +46,20 @@ int main(int argc, char ** argv)
   {
     using namespace bench;
 
-    AllResult res;
+    if (FLAGS_feature_cache_mb > 0)
+      FeatureCache::Instance().SetBudget(static_cast<size_t>(FLAGS_feature_cache_mb) * 1024 * 1024);
+
+    vector<AllResult> res(max(FLAGS_passes, 1));
     RunFeaturesLoadingBenchmark(FLAGS_input, make_pair(FLAGS_lowS, FLAGS_highS), res);
 
-    res.Print();
+    for (size_t i = 0; i < res.size(); ++i)
+    {
+      cout << "Pass " << i + 1 << ": ";
+      res[i].Print();
+    }
+
+    if (FeatureCache::Instance().IsEnabled())
+      cout << DebugPrint(FeatureCache::Instance().GetStats()) << endl;
   }
 
   return 0;
@@ -1,8 +1,12 @@
 #include "openlr/graph.hpp"
 
+#include "platform/country_file.hpp"
+
 #include "geometry/mercator.hpp"
 #include "geometry/point_with_altitude.hpp"
 
+#include "base/assert.hpp"
+
 #include <map>
 #include <memory>
 #include <utility>
@@ -13,33 +17,12 @@ using namespace std;
 
 namespace openlr
 {
-namespace
-{
-using EdgeGetter = void (IRoadGraph::*)(geometry::PointWithAltitude const &,
-                                        RoadGraphBase::EdgeListT &) const;
-
-void GetRegularEdges(geometry::PointWithAltitude const & junction, IRoadGraph const & graph,
-                     EdgeGetter const edgeGetter,
-                     Graph::EdgeCacheT & cache,
-                     Graph::EdgeListT & edges)
-{
-  auto const it = cache.find(junction);
-  if (it == end(cache))
-  {
-    auto & es = cache[junction];
-    (graph.*edgeGetter)(junction, es);
-    edges.append(begin(es), end(es));
-  }
-  else
-  {
-    auto const & es = it->second;
-    edges.append(begin(es), end(es));
-  }
-}
-}  // namespace
-
-Graph::Graph(DataSource & dataSource, shared_ptr<CarModelFactory> carModelFactory)
-  : m_dataSource(dataSource, nullptr /* numMwmIDs */), m_graph(m_dataSource, IRoadGraph::Mode::ObeyOnewayTag, carModelFactory)
+Graph::Graph(DataSource & dataSource, shared_ptr<CarModelFactory> carModelFactory,
+             shared_ptr<SharedRoadCache> sharedCache)
+  : m_mwmSet(dataSource)
+  , m_dataSource(dataSource, nullptr /* numMwmIDs */)
+  , m_graph(m_dataSource, IRoadGraph::Mode::ObeyOnewayTag, carModelFactory)
+  , m_sharedCache(std::move(sharedCache))
 {
 }
 
@@ -57,12 +40,12 @@ void Graph::GetIngoingEdges(Junction const & junction, EdgeListT & edges)
 
 void Graph::GetRegularOutgoingEdges(Junction const & junction, EdgeListT & edges)
 {
-  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularOutgoingEdges, m_outgoingCache, edges);
+  GetRegularEdges(junction, true /* outgoing */, edges);
 }
 
 void Graph::GetRegularIngoingEdges(Junction const & junction, EdgeListT & edges)
 {
-  GetRegularEdges(junction, m_graph, &IRoadGraph::GetRegularIngoingEdges, m_ingoingCache, edges);
+  GetRegularEdges(junction, false /* outgoing */, edges);
 }
 
 void Graph::FindClosestEdges(m2::PointD const & point, uint32_t const count,
@@ -83,6 +66,75 @@ void Graph::AddOutgoingFakeEdge(Edge const & e)
   m_graph.AddOutgoingFakeEdge(e);
 }
 
+void Graph::GetRegularEdges(Junction const & junction, bool outgoing, EdgeListT & edges)
+{
+  auto & cache = outgoing ? m_outgoingCache : m_ingoingCache;
+  auto const it = cache.find(junction);
+  if (it != cache.end())
+  {
+    edges.append(it->second.begin(), it->second.end());
+    return;
+  }
+
+  auto & es = cache[junction];
+  SharedRoadCache::EdgeEntries entries;
+  if (m_sharedCache && m_sharedCache->GetEdges(junction, outgoing, entries))
+  {
+    FromSharedEntries(entries, es);
+  }
+  else
+  {
+    if (outgoing)
+      m_graph.GetRegularOutgoingEdges(junction, es);
+    else
+      m_graph.GetRegularIngoingEdges(junction, es);
+
+    if (m_sharedCache)
+      m_sharedCache->SetEdges(junction, outgoing, ToSharedEntries(es));
+  }
+  edges.append(es.begin(), es.end());
+}
+
+SharedRoadCache::EdgeEntries Graph::ToSharedEntries(EdgeListT const & edges)
+{
+  SharedRoadCache::EdgeEntries entries;
+  entries.reserve(edges.size());
+  for (auto const & e : edges)
+  {
+    CHECK(!e.IsFake(), (e));
+    auto const & fid = e.GetFeatureId();
+    SharedRoadCache::EdgeEntry entry;
+    entry.m_countryIdx = m_sharedCache->GetCountryIdx(fid.m_mwmId.GetInfo()->GetCountryName());
+    entry.m_featureIdx = fid.m_index;
+    entry.m_segId = e.GetSegId();
+    entry.m_forward = e.IsForward();
+    entry.m_startJunction = e.GetStartJunction();
+    entry.m_endJunction = e.GetEndJunction();
+    entries.push_back(entry);
+  }
+  return entries;
+}
+
+void Graph::FromSharedEntries(SharedRoadCache::EdgeEntries const & entries, EdgeListT & edges)
+{
+  for (auto const & entry : entries)
+  {
+    if (entry.m_countryIdx >= m_countryMwmIds.size())
+      m_countryMwmIds.resize(entry.m_countryIdx + 1);
+
+    auto & mwmId = m_countryMwmIds[entry.m_countryIdx];
+    if (!mwmId.IsAlive())
+    {
+      mwmId = m_mwmSet.GetMwmIdByCountryFile(
+          platform::CountryFile(m_sharedCache->GetCountryName(entry.m_countryIdx)));
+      CHECK(mwmId.IsAlive(), (m_sharedCache->GetCountryName(entry.m_countryIdx)));
+    }
+
+    edges.push_back(Edge::MakeReal(FeatureID(mwmId, entry.m_featureIdx), entry.m_forward,
+                                   entry.m_segId, entry.m_startJunction, entry.m_endJunction));
+  }
+}
+
 void Graph::GetFeatureTypes(FeatureID const & featureId, feature::TypesHolder & types) const
 {
   m_graph.GetFeatureTypes(featureId, types);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "openlr/shared_road_cache.hpp"
+
 #include "routing/data_source.hpp"
 #include "routing/features_road_graph.hpp"
 #include "routing/road_graph.hpp"
@@ -28,7 +30,9 @@ public:
   using EdgeVector = routing::FeaturesRoadGraph::EdgeVector;
   using Junction = geometry::PointWithAltitude;
 
-  Graph(DataSource & dataSource, std::shared_ptr<routing::CarModelFactory> carModelFactory);
+  /// \param sharedCache is used to share regular edges with the graphs of other threads, may be null.
+  Graph(DataSource & dataSource, std::shared_ptr<routing::CarModelFactory> carModelFactory,
+        std::shared_ptr<SharedRoadCache> sharedCache = nullptr);
 
   // Appends edges such as that edge.GetStartJunction() == junction to the |edges|.
   void GetOutgoingEdges(geometry::PointWithAltitude const & junction, EdgeListT & edges);
@@ -54,8 +58,18 @@ public:
 
   using EdgeCacheT = std::map<Junction, EdgeListT>;
 private:
+  void GetRegularEdges(Junction const & junction, bool outgoing, EdgeListT & edges);
+
+  SharedRoadCache::EdgeEntries ToSharedEntries(EdgeListT const & edges);
+  void FromSharedEntries(SharedRoadCache::EdgeEntries const & entries, EdgeListT & edges);
+
+  MwmSet const & m_mwmSet;
   routing::MwmDataSource m_dataSource;
   routing::FeaturesRoadGraph m_graph;
   EdgeCacheT m_outgoingCache, m_ingoingCache;
+
+  std::shared_ptr<SharedRoadCache> m_sharedCache;
+  // Mwm ids of |m_mwmSet| by country indexes of |m_sharedCache|.
+  std::vector<MwmSet::MwmId> m_countryMwmIds;
 };
 }  // namespace openlr
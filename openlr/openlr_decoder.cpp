@@ -14,6 +14,7 @@
 #include "openlr/score_candidate_points_getter.hpp"
 #include "openlr/score_paths_connector.hpp"
 #include "openlr/score_types.hpp"
+#include "openlr/shared_road_cache.hpp"
 #include "openlr/way_point.hpp"
 
 #include "routing/features_road_graph.hpp"
@@ -39,6 +40,7 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <functional>
@@ -220,8 +222,11 @@ void CopyWithoutOffsets(InputIterator start, InputIterator stop, OutputIterator
 class SegmentsDecoderV2
 {
 public:
-  SegmentsDecoderV2(DataSource & dataSource, unique_ptr<CarModelFactory> cmf)
-    : m_dataSource(dataSource), m_graph(dataSource, std::move(cmf)), m_infoGetter(dataSource)
+  SegmentsDecoderV2(DataSource & dataSource, unique_ptr<CarModelFactory> cmf,
+                    shared_ptr<SharedRoadCache> sharedCache)
+    : m_dataSource(dataSource)
+    , m_graph(dataSource, std::move(cmf), sharedCache)
+    , m_infoGetter(dataSource, sharedCache)
   {
   }
 
@@ -309,8 +314,11 @@ private:
 class SegmentsDecoderV3
 {
 public:
-  SegmentsDecoderV3(DataSource & dataSource, unique_ptr<CarModelFactory> carModelFactory)
-      : m_dataSource(dataSource), m_graph(dataSource, std::move(carModelFactory)), m_infoGetter(dataSource)
+  SegmentsDecoderV3(DataSource & dataSource, unique_ptr<CarModelFactory> carModelFactory,
+                    shared_ptr<SharedRoadCache> sharedCache)
+      : m_dataSource(dataSource)
+      , m_graph(dataSource, std::move(carModelFactory), sharedCache)
+      , m_infoGetter(dataSource, sharedCache)
   {
   }
 
@@ -457,24 +465,40 @@ template <typename Decoder, typename Stats>
 void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
                            uint32_t const numThreads, vector<DecodedPath> & paths)
 {
+  // Segments are decoded by batches which are taken by the threads from the shared counter,
+  // so a thread which got cheap segments takes the next batch instead of waiting for the others.
+  // Batches keep the adjacent |paths| written by one thread to avoid false sharing.
+  size_t constexpr kBatchSize = GetOptimalBatchSize();
+  size_t const numBatches = (segments.size() + kBatchSize - 1) / kBatchSize;
+  atomic<size_t> nextBatch{0};
+
+  // Road edges and road infos decoded by one thread are reused by the others. All the data sources
+  // have the same mwms, so the countries are taken from the first one before the threads start.
+  vector<shared_ptr<MwmInfo>> mwmsInfo;
+  m_dataSources[0].GetMwmsInfo(mwmsInfo);
+  vector<string> countries;
+  for (auto const & info : mwmsInfo)
+    countries.push_back(info->GetCountryName());
+  auto const sharedCache = make_shared<SharedRoadCache>(countries);
+
   auto const worker = [&](size_t threadNum, DataSource & dataSource, Stats & stat)
   {
-    size_t constexpr kBatchSize = GetOptimalBatchSize();
     size_t constexpr kProgressFrequency = 100;
 
     size_t const numSegments = segments.size();
 
-    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter));
+    Decoder decoder(dataSource, make_unique<CarModelFactory>(m_countryParentNameGetter), sharedCache);
     base::Timer timer;
-    for (size_t i = threadNum * kBatchSize; i < numSegments; i += numThreads * kBatchSize)
+    for (size_t batch = nextBatch++; batch < numBatches; batch = nextBatch++)
     {
+      size_t const i = batch * kBatchSize;
       for (size_t j = i; j < numSegments && j < i + kBatchSize; ++j)
       {
         if (!decoder.DecodeSegment(segments[j], paths[j], stat))
           ++stat.m_routesFailed;
         ++stat.m_routesHandled;
 
-        if (stat.m_routesHandled % kProgressFrequency == 0 || i == segments.size() - 1)
+        if (stat.m_routesHandled % kProgressFrequency == 0 || j == numSegments - 1)
         {
           LOG(LINFO, ("Thread", threadNum, "processed", stat.m_routesHandled,
                       "failed:", stat.m_routesFailed));
@@ -499,6 +523,7 @@ void OpenLRDecoder::Decode(vector<LinearSegment> const & segments,
     allStats.Add(s);
 
   allStats.Report();
+  LOG(LINFO, ("Shared road cache:", sharedCache->GetStats()));
   LOG(LINFO, ("Matching tool:", timer.ElapsedSeconds(), "seconds."));
 }
 }  // namespace openlr
@@ -0,0 +1,124 @@
+#include "testing/testing.hpp"
+
+#include "openlr/shared_road_cache.hpp"
+
+#include "geometry/point_with_altitude.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace shared_road_cache_test
+{
+using namespace openlr;
+using namespace std;
+
+geometry::PointWithAltitude MakeJunction(double x, double y)
+{
+  return geometry::PointWithAltitude({x, y}, 0 /* altitude */);
+}
+
+UNIT_TEST(SharedRoadCache_Smoke)
+{
+  SharedRoadCache cache({"Russia_Moscow", "Belarus_Minsk Region"});
+  TEST_EQUAL(cache.GetCountryIdx("Russia_Moscow"), 0, ());
+  TEST_EQUAL(cache.GetCountryIdx("Belarus_Minsk Region"), 1, ());
+  TEST_EQUAL(cache.GetCountryName(1), "Belarus_Minsk Region", ());
+
+  auto const junction = MakeJunction(1.0, 2.0);
+  SharedRoadCache::EdgeEntries entries;
+  TEST(!cache.GetEdges(junction, true /* outgoing */, entries), ());
+
+  SharedRoadCache::EdgeEntry entry;
+  entry.m_countryIdx = 1;
+  entry.m_featureIdx = 10;
+  entry.m_segId = 2;
+  entry.m_forward = false;
+  entry.m_startJunction = junction;
+  entry.m_endJunction = MakeJunction(1.0, 3.0);
+  cache.SetEdges(junction, true /* outgoing */, {entry});
+
+  TEST(cache.GetEdges(junction, true /* outgoing */, entries), ());
+  TEST_EQUAL(entries.size(), 1, ());
+  TEST_EQUAL(entries[0].m_featureIdx, 10, ());
+  TEST_EQUAL(entries[0].m_segId, 2, ());
+  TEST(!entries[0].m_forward, ());
+  TEST_EQUAL(entries[0].m_endJunction, MakeJunction(1.0, 3.0), ());
+
+  // Ingoing edges are cached separately.
+  TEST(!cache.GetEdges(junction, false /* outgoing */, entries), ());
+
+  auto const stats = cache.GetStats();
+  TEST_EQUAL(stats.m_requests, 3, ());
+  TEST_EQUAL(stats.m_hits, 1, ());
+}
+
+UNIT_TEST(SharedRoadCache_Threads)
+{
+  SharedRoadCache cache({"Country"});
+  size_t constexpr kThreadsNumber = 4;
+  uint32_t constexpr kJunctionsNumber = 1000;
+
+  vector<thread> threads;
+  for (size_t t = 0; t < kThreadsNumber; ++t)
+  {
+    threads.emplace_back([&cache]() {
+      for (uint32_t i = 0; i < kJunctionsNumber; ++i)
+      {
+        auto const junction = MakeJunction(i, i);
+        SharedRoadCache::EdgeEntries entries;
+        if (cache.GetEdges(junction, true /* outgoing */, entries))
+          continue;
+
+        SharedRoadCache::EdgeEntry entry;
+        entry.m_countryIdx = cache.GetCountryIdx("Country");
+        entry.m_featureIdx = i;
+        entry.m_startJunction = junction;
+        cache.SetEdges(junction, true /* outgoing */, {entry});
+      }
+    });
+  }
+
+  for (auto & t : threads)
+    t.join();
+
+  for (uint32_t i = 0; i < kJunctionsNumber; ++i)
+  {
+    SharedRoadCache::EdgeEntries entries;
+    TEST(cache.GetEdges(MakeJunction(i, i), true /* outgoing */, entries), (i));
+    TEST_EQUAL(entries.size(), 1, ());
+    TEST_EQUAL(entries[0].m_featureIdx, i, ());
+    TEST_EQUAL(entries[0].m_countryIdx, 0, ());
+  }
+}
+
+UNIT_TEST(SharedRoadCache_Eviction)
+{
+  size_t constexpr kMaxEntries = 640;
+  uint32_t constexpr kJunctionsNumber = 10000;
+  SharedRoadCache cache({"Country"}, kMaxEntries);
+
+  for (uint32_t i = 0; i < kJunctionsNumber; ++i)
+  {
+    SharedRoadCache::EdgeEntry entry;
+    entry.m_featureIdx = i;
+    cache.SetEdges(MakeJunction(i, i), true /* outgoing */, {entry});
+  }
+
+  size_t edgesNumber = 0;
+  for (uint32_t i = 0; i < kJunctionsNumber; ++i)
+  {
+    SharedRoadCache::EdgeEntries entries;
+    if (cache.GetEdges(MakeJunction(i, i), true /* outgoing */, entries))
+      ++edgesNumber;
+  }
+
+  TEST_GREATER(edgesNumber, 0, ());
+  TEST_LESS_OR_EQUAL(edgesNumber, kMaxEntries, ());
+
+  // The last entry is not evicted.
+  SharedRoadCache::EdgeEntries entries;
+  TEST(cache.GetEdges(MakeJunction(kJunctionsNumber - 1, kJunctionsNumber - 1), true /* outgoing */,
+                      entries), ());
+}
+}  // namespace shared_road_cache_test
@@ -1,5 +1,7 @@
 #include "openlr/road_info_getter.hpp"
 
+#include "openlr/shared_road_cache.hpp"
+
 #include "indexer/classificator.hpp"
 #include "indexer/feature.hpp"
 #include "indexer/data_source.hpp"
@@ -18,8 +20,9 @@ RoadInfoGetter::RoadInfo::RoadInfo(FeatureType & ft)
 }
 
 // RoadInfoGetter ----------------------------------------------------------------------------------
-RoadInfoGetter::RoadInfoGetter(DataSource const & dataSource)
-  : m_dataSource(dataSource)
+RoadInfoGetter::RoadInfoGetter(DataSource const & dataSource,
+                               std::shared_ptr<SharedRoadCache> sharedCache)
+  : m_dataSource(dataSource), m_sharedCache(std::move(sharedCache))
 {
 }
 
@@ -29,12 +32,22 @@ RoadInfoGetter::RoadInfo RoadInfoGetter::Get(FeatureID const & fid)
   if (it != end(m_cache))
     return it->second;
 
+  uint32_t countryIdx = 0;
+  if (m_sharedCache)
+  {
+    countryIdx = m_sharedCache->GetCountryIdx(fid.m_mwmId.GetInfo()->GetCountryName());
+    if (auto const info = m_sharedCache->GetRoadInfo(countryIdx, fid.m_index))
+      return m_cache.emplace(fid, *info).first->second;
+  }
+
   FeaturesLoaderGuard g(m_dataSource, fid.m_mwmId);
   auto ft = g.GetOriginalFeatureByIndex(fid.m_index);
   CHECK(ft, ());
 
   RoadInfo info(*ft);
   it = m_cache.emplace(fid, info).first;
+  if (m_sharedCache)
+    m_sharedCache->SetRoadInfo(countryIdx, fid.m_index, info);
 
   return it->second;
 }
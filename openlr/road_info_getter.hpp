@@ -6,6 +6,7 @@
 #include "indexer/ftypes_matcher.hpp"
 
 #include <map>
+#include <memory>
 
 class Classificator;
 class DataSource;
@@ -17,6 +18,8 @@ class TypesHolder;
 
 namespace openlr
 {
+class SharedRoadCache;
+
 class RoadInfoGetter final
 {
 public:
@@ -30,7 +33,8 @@ public:
     bool m_isRoundabout = false;
   };
 
-  explicit RoadInfoGetter(DataSource const & dataSource);
+  explicit RoadInfoGetter(DataSource const & dataSource,
+                          std::shared_ptr<SharedRoadCache> sharedCache = nullptr);
 
   RoadInfo Get(FeatureID const & fid);
 
@@ -38,5 +42,6 @@ public:
 
   DataSource const & m_dataSource;
   std::map<FeatureID, RoadInfo> m_cache;
+  std::shared_ptr<SharedRoadCache> m_sharedCache;
 };
 }  // namespace openlr
@@ -0,0 +1,112 @@
+#include "openlr/shared_road_cache.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+
+namespace openlr
+{
+SharedRoadCache::SharedRoadCache(std::vector<std::string> const & countries, size_t maxEntries)
+  : m_countries(countries), m_maxShardEntries(std::max<size_t>(maxEntries / kShardsNumber, 1))
+{
+  for (size_t i = 0; i < m_countries.size(); ++i)
+  {
+    auto const inserted = m_countryToIdx.emplace(m_countries[i], base::checked_cast<uint32_t>(i)).second;
+    CHECK(inserted, ("Duplicated country", m_countries[i]));
+  }
+}
+
+uint32_t SharedRoadCache::GetCountryIdx(std::string const & countryName) const
+{
+  auto const it = m_countryToIdx.find(countryName);
+  CHECK(it != m_countryToIdx.cend(), ("Unknown country", countryName));
+  return it->second;
+}
+
+std::string const & SharedRoadCache::GetCountryName(uint32_t countryIdx) const
+{
+  CHECK_LESS(countryIdx, m_countries.size(), ());
+  return m_countries[countryIdx];
+}
+
+bool SharedRoadCache::GetEdges(Junction const & junction, bool outgoing, EdgeEntries & entries) const
+{
+  ++m_requests;
+  auto const & shard = m_shards[GetShardIdx(junction)];
+  std::lock_guard<std::mutex> guard(shard.m_mutex);
+  auto const it = shard.m_edges.find({junction, outgoing});
+  if (it == shard.m_edges.cend())
+    return false;
+
+  ++m_hits;
+  entries = it->second;
+  return true;
+}
+
+void SharedRoadCache::SetEdges(Junction const & junction, bool outgoing, EdgeEntries const & entries)
+{
+  auto & shard = m_shards[GetShardIdx(junction)];
+  std::lock_guard<std::mutex> guard(shard.m_mutex);
+  Insert(std::make_pair(junction, outgoing), entries, shard.m_edges, shard.m_edgesQueue);
+}
+
+std::optional<RoadInfoGetter::RoadInfo> SharedRoadCache::GetRoadInfo(uint32_t countryIdx,
+                                                                     uint32_t featureIdx) const
+{
+  auto const & shard = m_shards[GetShardIdx(countryIdx, featureIdx)];
+  std::lock_guard<std::mutex> guard(shard.m_mutex);
+  auto const it = shard.m_roadInfos.find({countryIdx, featureIdx});
+  if (it == shard.m_roadInfos.cend())
+    return {};
+  return it->second;
+}
+
+void SharedRoadCache::SetRoadInfo(uint32_t countryIdx, uint32_t featureIdx,
+                                  RoadInfoGetter::RoadInfo const & info)
+{
+  auto & shard = m_shards[GetShardIdx(countryIdx, featureIdx)];
+  std::lock_guard<std::mutex> guard(shard.m_mutex);
+  Insert(std::make_pair(countryIdx, featureIdx), info, shard.m_roadInfos, shard.m_roadInfosQueue);
+}
+
+template <typename Key, typename Value>
+void SharedRoadCache::Insert(Key const & key, Value const & value, std::map<Key, Value> & entries,
+                             std::deque<Key> & queue) const
+{
+  // Another decoder could cache the same value meanwhile, they are equal.
+  if (!entries.emplace(key, value).second)
+    return;
+
+  queue.push_back(key);
+  if (queue.size() > m_maxShardEntries)
+  {
+    entries.erase(queue.front());
+    queue.pop_front();
+  }
+}
+
+// static
+size_t SharedRoadCache::GetShardIdx(Junction const & junction)
+{
+  auto const & p = junction.GetPoint();
+  size_t const h = std::hash<double>()(p.x) ^ (std::hash<double>()(p.y) << 1);
+  return h % kShardsNumber;
+}
+
+// static
+size_t SharedRoadCache::GetShardIdx(uint32_t countryIdx, uint32_t featureIdx)
+{
+  return (static_cast<size_t>(countryIdx) * 31 + featureIdx) % kShardsNumber;
+}
+
+std::string DebugPrint(SharedRoadCache::Stats const & stats)
+{
+  std::ostringstream out;
+  out << "SharedRoadCache::Stats [ requests: " << stats.m_requests << ", hits: " << stats.m_hits
+      << " ]";
+  return out.str();
+}
+}  // namespace openlr
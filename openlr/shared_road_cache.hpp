@@ -0,0 +1,104 @@
+#pragma once
+
+#include "openlr/road_info_getter.hpp"
+
+#include "geometry/point_with_altitude.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openlr
+{
+// Thread-safe cache of regular road graph edges and road infos which is shared by the decoders
+// of all the threads. Every decoder reads features from its own DataSource and mwm ids of
+// different data sources are not interchangeable, so features are stored by country index here
+// and every decoder converts them to its own FeatureIDs.
+// The number of cached edge lists and road infos is bounded, the oldest ones are evicted first.
+class SharedRoadCache final
+{
+public:
+  static size_t constexpr kDefaultMaxEntries = 1 << 20;
+
+  using Junction = geometry::PointWithAltitude;
+
+  struct EdgeEntry
+  {
+    uint32_t m_countryIdx = 0;
+    uint32_t m_featureIdx = 0;
+    uint32_t m_segId = 0;
+    bool m_forward = true;
+    Junction m_startJunction;
+    Junction m_endJunction;
+  };
+
+  using EdgeEntries = std::vector<EdgeEntry>;
+
+  struct Stats
+  {
+    uint64_t m_requests = 0;
+    uint64_t m_hits = 0;
+  };
+
+  /// \param countries are all the countries the decoders may read, they are known before
+  /// the decoding starts, so country indexes are looked up without locks.
+  /// \param maxEntries is the max number of both edge lists and road infos.
+  explicit SharedRoadCache(std::vector<std::string> const & countries,
+                           size_t maxEntries = kDefaultMaxEntries);
+
+  uint32_t GetCountryIdx(std::string const & countryName) const;
+  std::string const & GetCountryName(uint32_t countryIdx) const;
+
+  /// @returns false if edges of |junction| are not cached yet.
+  bool GetEdges(Junction const & junction, bool outgoing, EdgeEntries & entries) const;
+  void SetEdges(Junction const & junction, bool outgoing, EdgeEntries const & entries);
+
+  std::optional<RoadInfoGetter::RoadInfo> GetRoadInfo(uint32_t countryIdx, uint32_t featureIdx) const;
+  void SetRoadInfo(uint32_t countryIdx, uint32_t featureIdx, RoadInfoGetter::RoadInfo const & info);
+
+  Stats GetStats() const { return {m_requests.load(), m_hits.load()}; }
+
+private:
+  // Entries are distributed by shards with their own mutexes to reduce contention.
+  static size_t constexpr kShardsNumber = 64;
+
+  using EdgesKey = std::pair<Junction, bool>;
+  using RoadInfoKey = std::pair<uint32_t, uint32_t>;
+
+  struct Shard
+  {
+    mutable std::mutex m_mutex;
+    std::map<EdgesKey, EdgeEntries> m_edges;
+    // Keys of |m_edges| in the order of insertion.
+    std::deque<EdgesKey> m_edgesQueue;
+    std::map<RoadInfoKey, RoadInfoGetter::RoadInfo> m_roadInfos;
+    std::deque<RoadInfoKey> m_roadInfosQueue;
+  };
+
+  static size_t GetShardIdx(Junction const & junction);
+  static size_t GetShardIdx(uint32_t countryIdx, uint32_t featureIdx);
+
+  // Inserts |value| and evicts the oldest entry if there are more than |m_maxShardEntries|.
+  template <typename Key, typename Value>
+  void Insert(Key const & key, Value const & value, std::map<Key, Value> & entries,
+              std::deque<Key> & queue) const;
+
+  std::vector<std::string> const m_countries;
+  std::map<std::string, uint32_t> m_countryToIdx;
+  size_t const m_maxShardEntries;
+
+  Shard m_shards[kShardsNumber];
+
+  mutable std::atomic<uint64_t> m_requests{0};
+  mutable std::atomic<uint64_t> m_hits{0};
+};
+
+std::string DebugPrint(SharedRoadCache::Stats const & stats);
+}  // namespace openlr
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "platform/battery_tracker.hpp"
+#include "platform/constants.hpp"
 #include "platform/country_defines.hpp"
 #include "platform/gui_thread.hpp"
 #include "platform/secure_storage.hpp"
 
+#include "coding/file_reader.hpp"
 #include "coding/reader.hpp"
 
 #include "base/assert.hpp"
@@ -118,6 +120,9 @@ protected:
 
   platform::BatteryLevelTracker m_batteryTracker;
 
+  /// Page cache parameters of readers of map data files.
+  FileReader::CacheParams m_dataReaderCacheParams = {READER_CHUNK_LOG_SIZE, READER_CHUNK_LOG_COUNT};
+
 public:
   Platform();
   virtual ~Platform() = default;
@@ -203,6 +208,11 @@ public:
   std::unique_ptr<ModelReader> GetReader(std::string const & file,
                                          std::string searchScope = std::string()) const;
 
+  /// Sets page cache parameters of readers of map data files returned by GetReader().
+  /// Affects only readers which are created after the call, so should be called before maps registration.
+  void SetDataReaderCacheParams(FileReader::CacheParams const & params) { m_dataReaderCacheParams = params; }
+  FileReader::CacheParams const & GetDataReaderCacheParams() const { return m_dataReaderCacheParams; }
+
   /// @name File operations
   //@{
   using FilesList = std::vector<std::string>;
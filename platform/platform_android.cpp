@@ -53,8 +53,8 @@ unique_ptr<ModelReader> Platform::GetReader(string const & file, string searchSc
   strings::AsciiToLower(ext);
   ASSERT(!ext.empty(), ());
 
-  uint32_t const logPageSize = (ext == DATA_FILE_EXTENSION) ? READER_CHUNK_LOG_SIZE : 10;
-  uint32_t const logPageCount = (ext == DATA_FILE_EXTENSION) ? READER_CHUNK_LOG_COUNT : 4;
+  FileReader::CacheParams const cacheParams =
+      (ext == DATA_FILE_EXTENSION) ? m_dataReaderCacheParams : FileReader::CacheParams();
 
   if (searchScope.empty())
   {
@@ -94,7 +94,7 @@ unique_ptr<ModelReader> Platform::GetReader(string const & file, string searchSc
     {
       string const path = base::JoinPath(m_writableDir, file);
       if (IsFileExistsByFullPath(path))
-        return make_unique<FileReader>(path, logPageSize, logPageCount);
+        return make_unique<FileReader>(path, cacheParams);
       break;
     }
 
@@ -102,20 +102,21 @@ unique_ptr<ModelReader> Platform::GetReader(string const & file, string searchSc
     {
       string const path = base::JoinPath(m_settingsDir, file);
       if (IsFileExistsByFullPath(path))
-        return make_unique<FileReader>(path, logPageSize, logPageCount);
+        return make_unique<FileReader>(path, cacheParams);
       break;
     }
 
     case 'f':
       if (IsFileExistsByFullPath(file))
-        return make_unique<FileReader>(file, logPageSize, logPageCount);
+        return make_unique<FileReader>(file, cacheParams);
       break;
 
     case 'r':
       ASSERT_EQUAL(file.find("assets/"), string::npos, ());
       try
       {
-        return make_unique<ZipFileReader>(m_resourcesDir, "assets/" + file, logPageSize, logPageCount);
+        return make_unique<ZipFileReader>(m_resourcesDir, "assets/" + file, cacheParams.m_logPageSize,
+                                        cacheParams.m_logPageCount);
       }
       catch (Reader::OpenException const & e)
       {
@@ -115,8 +115,8 @@ bool Platform::GetFileSizeByName(std::string const & fileName, uint64_t & size)
 
 std::unique_ptr<ModelReader> Platform::GetReader(std::string const & file, std::string searchScope) const
 {
-  return std::make_unique<FileReader>(ReadPathForFile(file, std::move(searchScope)), READER_CHUNK_LOG_SIZE,
-                                      READER_CHUNK_LOG_COUNT);
+  return std::make_unique<FileReader>(ReadPathForFile(file, std::move(searchScope)),
+                                      m_dataReaderCacheParams);
 }
 
 int Platform::VideoMemoryLimit() const { return 8 * 1024 * 1024; }
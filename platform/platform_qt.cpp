@@ -18,7 +18,7 @@
 std::unique_ptr<ModelReader> Platform::GetReader(std::string const & file, std::string searchScope) const
 {
   return std::make_unique<FileReader>(ReadPathForFile(file, std::move(searchScope)),
-                                 READER_CHUNK_LOG_SIZE, READER_CHUNK_LOG_COUNT);
+                                      m_dataReaderCacheParams);
 }
 
 bool Platform::GetFileSizeByName(std::string const & fileName, uint64_t & size) const
@@ -35,6 +35,19 @@ struct DefaultLengthChecker
 {
   template <class Weight> bool operator()(Weight const &) const { return true; }
 };
+
+struct AlternativesParams
+{
+  // Max number of paths including the best one.
+  size_t m_maxCount = 3;
+  // Alternative is not longer than (1 + m_maxStretch) * best path weight.
+  double m_maxStretch = 0.25;
+  // Alternative shares not more than m_maxSharing * best path weight with any chosen path.
+  double m_maxSharing = 0.8;
+  // Alternative has a plateau (a part which is the shortest path between its ends) not shorter
+  // than m_minPlateau * best path weight. Approximates local optimality of the path.
+  double m_minPlateau = 0.2;
+};
 }  // namespace astar
 
 template <typename Vertex, typename Edge, typename Weight>
@@ -222,6 +235,15 @@ public:
     });
   }
 
+  /// Finds the best path and up to |altParams.m_maxCount - 1| alternatives by plateau method:
+  /// the forward and backward waves of one bidirectional run are propagated until all the paths
+  /// not longer than the allowed stretch are found, then via-paths are taken along the parts
+  /// which are common for both shortest path trees.
+  /// |results| are sorted by weight, the first one is the best path.
+  template <class P>
+  Result FindAlternativePathsBidirectional(P & params, astar::AlternativesParams const & altParams,
+                                           std::vector<RoutingResult<Vertex, Weight>> & results) const;
+
   // Adjust route to the previous one.
   // Expects |params.m_checkLengthCallback| to check wave propagation limit.
   template <typename P>
@@ -383,6 +405,16 @@ private:
     Weight pS;
   };
 
+  /// Propagates bidirectional waves and calls |emitter|(cur, nxt, bestPathRealLength) when all the
+  /// paths not longer than (1 + |maxStretch|) * the best path are found.
+  /// Waves continue to find the next best path if |emitter| returns false.
+  template <class P, class Emitter>
+  Result PropagateWavesBidirectional(P & params, double maxStretch, Emitter && emitter) const;
+
+  static void SelectAlternatives(BidirectionalStepContext & forward, BidirectionalStepContext & backward,
+                                 Weight const & bestLength, astar::AlternativesParams const & altParams,
+                                 std::vector<RoutingResult<Vertex, Weight>> & results);
+
   static void ReconstructPath(Vertex const & v,
                               typename BidirectionalStepContext::Parents const & parent,
                               std::vector<Vertex> & path);
@@ -572,6 +604,58 @@ template <typename Vertex, typename Edge, typename Weight>
 template <class P, class Emitter>
 typename AStarAlgorithm<Vertex, Edge, Weight>::Result
 AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalEx(P & params, Emitter && emitter) const
+{
+  return PropagateWavesBidirectional(params, 0.0 /* maxStretch */,
+                                     [&emitter](BidirectionalStepContext & cur, BidirectionalStepContext & nxt,
+                                                Weight const & bestPathRealLength)
+  {
+    // No problem if length check fails, but we still emit the result.
+    // Happens with "transit" route because of length, haven't seen with regular car route.
+    //ASSERT(params.m_checkLengthCallback(bestPathRealLength), ());
+
+    RoutingResult<Vertex, Weight> result;
+    ReconstructPathBidirectional(cur.bestVertex, nxt.bestVertex, cur.parent, nxt.parent, result.m_path);
+    result.m_distance = bestPathRealLength;
+    if (!cur.forward)
+      reverse(result.m_path.begin(), result.m_path.end());
+
+    return emitter(std::move(result));
+  });
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <class P>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::FindAlternativePathsBidirectional(
+    P & params, astar::AlternativesParams const & altParams,
+    std::vector<RoutingResult<Vertex, Weight>> & results) const
+{
+  CHECK_GREATER(altParams.m_maxCount, 0, ());
+  results.clear();
+
+  return PropagateWavesBidirectional(params, altParams.m_maxStretch,
+                                     [&](BidirectionalStepContext & cur, BidirectionalStepContext & nxt,
+                                         Weight const & bestPathRealLength)
+  {
+    RoutingResult<Vertex, Weight> best;
+    ReconstructPathBidirectional(cur.bestVertex, nxt.bestVertex, cur.parent, nxt.parent, best.m_path);
+    best.m_distance = bestPathRealLength;
+    if (!cur.forward)
+      reverse(best.m_path.begin(), best.m_path.end());
+    results.push_back(std::move(best));
+
+    auto & forward = cur.forward ? cur : nxt;
+    auto & backward = cur.forward ? nxt : cur;
+    SelectAlternatives(forward, backward, bestPathRealLength, altParams, results);
+    return true;
+  });
+}
+
+template <typename Vertex, typename Edge, typename Weight>
+template <class P, class Emitter>
+typename AStarAlgorithm<Vertex, Edge, Weight>::Result
+AStarAlgorithm<Vertex, Edge, Weight>::PropagateWavesBidirectional(P & params, double maxStretch,
+                                                                 Emitter && emitter) const
 {
   auto const epsilon = params.m_weightEpsilon;
   auto & graph = params.m_graph;
@@ -603,41 +687,38 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalEx(P & params, Emitte
 
   auto const EmitResult = [cur, nxt, &bestPathRealLength, &emitter]()
   {
-    // No problem if length check fails, but we still emit the result.
-    // Happens with "transit" route because of length, haven't seen with regular car route.
-    //ASSERT(params.m_checkLengthCallback(bestPathRealLength), ());
-
-    RoutingResult<Vertex, Weight> result;
-    ReconstructPathBidirectional(cur->bestVertex, nxt->bestVertex, cur->parent, nxt->parent, result.m_path);
-    result.m_distance = bestPathRealLength;
-    if (!cur->forward)
-      reverse(result.m_path.begin(), result.m_path.end());
-
-    return emitter(std::move(result));
+    return emitter(*cur, *nxt, bestPathRealLength);
   };
 
   typename Graph::EdgeListT adj;
 
-  // It is not necessary to check emptiness for both queues here
-  // because if we have not found a path by the time one of the
-  // queues is exhausted, we never will.
+  // If we have not found a path by the time one of the queues is exhausted, we never will.
   uint32_t steps = 0;
   PeriodicPollCancellable periodicCancellable(params.m_cancellable);
 
-  while (!cur->queue.empty() && !nxt->queue.empty())
+  while (!cur->queue.empty() || !nxt->queue.empty())
   {
+    if (cur->queue.empty() || nxt->queue.empty())
+    {
+      // Paths longer than the best one are searched by the rest wave.
+      if (!foundAnyPath || maxStretch == 0.0)
+        break;
+      if (cur->queue.empty())
+        std::swap(cur, nxt);
+    }
+
     ++steps;
 
     if (periodicCancellable.IsCancelled())
       return Result::Cancelled;
 
-    if (steps % kQueueSwitchPeriod == 0)
+    if (steps % kQueueSwitchPeriod == 0 && !nxt->queue.empty())
       std::swap(cur, nxt);
 
     if (foundAnyPath)
     {
       auto const curTop = cur->TopDistance();
-      auto const nxtTop = nxt->TopDistance();
+      auto const nxtTop = nxt->queue.empty() ? kZeroDistance : nxt->TopDistance();
 
       // The intuition behind this is that we cannot obtain a path shorter
       // than the left side of the inequality because that is how any path we find
@@ -650,7 +731,9 @@ AStarAlgorithm<Vertex, Edge, Weight>::FindPathBidirectionalEx(P & params, Emitte
       // several top states in a priority queue may have equal reduced path lengths and
       // different real path lengths.
 
-      if (curTop + nxtTop >= bestPathReducedLength - epsilon)
+      // Reduced and real lengths of a path differ by a constant, so all the paths not longer than
+      // the best one plus |maxStretch| part of it are found when the inequality holds.
+      if (curTop + nxtTop >= bestPathReducedLength + maxStretch * bestPathRealLength - epsilon)
       {
         if (EmitResult())
           return Result::OK;
@@ -833,6 +916,138 @@ AStarAlgorithm<Vertex, Edge, Weight>::AdjustRoute(P & params,
   return Result::OK;
 }
 
+// static
+template <typename Vertex, typename Edge, typename Weight>
+void AStarAlgorithm<Vertex, Edge, Weight>::SelectAlternatives(
+    BidirectionalStepContext & forward, BidirectionalStepContext & backward, Weight const & bestLength,
+    astar::AlternativesParams const & altParams, std::vector<RoutingResult<Vertex, Weight>> & results)
+{
+  CHECK_EQUAL(results.size(), 1, ("The best path is expected."));
+
+  // Real distance from the start (finish) to |v| for the forward (backward) wave.
+  auto const realDistance = [](BidirectionalStepContext const & context, Vertex const & v)
+  {
+    auto const reduced = context.GetDistance(v);
+    CHECK(reduced, (v));
+    return *reduced + context.pS - context.ConsistentHeuristic(v);
+  };
+
+  // Edge (u, v) belongs to a plateau if it's in the both shortest path trees.
+  auto const isPlateauEdge = [&forward, &backward](Vertex const & u, Vertex const & v)
+  {
+    auto const parent = forward.GetParent(v);
+    auto const next = backward.GetParent(u);
+    return parent && next && *parent == u && *next == v;
+  };
+
+  struct Candidate
+  {
+    Vertex m_plateauEnd;
+    Weight m_length;
+  };
+
+  Weight const maxLength = bestLength + altParams.m_maxStretch * bestLength;
+  Weight const minPlateau = altParams.m_minPlateau * bestLength;
+
+  // Every plateau gives one via-path: the forward tree path to the plateau end and
+  // the backward tree path from it.
+  std::vector<Candidate> candidates;
+  for (auto const & item : forward.bestDistance)
+  {
+    Vertex const & begin = item.first;
+    if (!backward.GetDistance(begin))
+      continue;
+
+    // Plateaus are walked from their first vertices only.
+    if (auto const parent = forward.GetParent(begin); parent && isPlateauEdge(*parent, begin))
+      continue;
+
+    Vertex end = begin;
+    for (auto next = backward.GetParent(end); next && isPlateauEdge(end, *next); next = backward.GetParent(end))
+      end = *next;
+
+    if (end == begin)
+      continue;
+
+    Weight const plateau = realDistance(forward, end) - realDistance(forward, begin);
+    Weight const length = realDistance(forward, end) + realDistance(backward, end);
+    if (plateau >= minPlateau && length <= maxLength)
+      candidates.push_back({end, length});
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](Candidate const & lhs, Candidate const & rhs)
+  {
+    return lhs.m_length < rhs.m_length;
+  });
+
+  // Edges of the chosen paths: vertex -> previous vertex of the path.
+  using PathEdges = ska::bytell_hash_map<Vertex, Vertex>;
+  auto const getEdges = [](std::vector<Vertex> const & path, PathEdges & edges)
+  {
+    edges.clear();
+    for (size_t i = 1; i < path.size(); ++i)
+    {
+      if (!edges.emplace(path[i], path[i - 1]).second)
+        return false;
+    }
+    return edges.count(path.front()) == 0;
+  };
+
+  std::vector<PathEdges> chosen(1);
+  getEdges(results.front().m_path, chosen.front());
+
+  Weight const maxSharing = altParams.m_maxSharing * bestLength;
+  PathEdges edges;
+  for (auto const & candidate : candidates)
+  {
+    if (results.size() >= altParams.m_maxCount)
+      break;
+
+    if (!forward.graph.AreWavesConnectible(forward.parent, candidate.m_plateauEnd, backward.parent))
+      continue;
+
+    RoutingResult<Vertex, Weight> result;
+    ReconstructPath(candidate.m_plateauEnd, forward.parent, result.m_path);
+    size_t const forwardSize = result.m_path.size();
+    for (auto next = backward.GetParent(candidate.m_plateauEnd); next; next = backward.GetParent(*next))
+      result.m_path.push_back(*next);
+
+    auto const & path = result.m_path;
+    // Paths with loops are not alternatives.
+    if (!getEdges(path, edges))
+      continue;
+
+    bool shared = false;
+    for (auto const & chosenEdges : chosen)
+    {
+      Weight sharing = kZeroDistance;
+      for (size_t i = 1; i < path.size(); ++i)
+      {
+        auto const it = chosenEdges.find(path[i]);
+        if (it == chosenEdges.cend() || !(it->second == path[i - 1]))
+          continue;
+
+        sharing += i < forwardSize ? realDistance(forward, path[i]) - realDistance(forward, path[i - 1])
+                                   : realDistance(backward, path[i - 1]) - realDistance(backward, path[i]);
+      }
+
+      if (sharing > maxSharing)
+      {
+        shared = true;
+        break;
+      }
+    }
+
+    if (shared)
+      continue;
+
+    result.m_distance = candidate.m_length;
+    chosen.push_back(std::move(edges));
+    edges = PathEdges();
+    results.push_back(std::move(result));
+  }
+}
+
 // static
 template <typename Vertex, typename Edge, typename Weight>
 void AStarAlgorithm<Vertex, Edge, Weight>::ReconstructPath(
@@ -0,0 +1,104 @@
+#include "routing/compact_road_index.hpp"
+
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <queue>
+
+namespace routing
+{
+CompactRoadIndex::CompactRoadIndex(RoadIndex const & roadIndex, JointIndex const & jointIndex)
+{
+  std::vector<uint32_t> featureIds;
+  featureIds.reserve(roadIndex.GetSize());
+  roadIndex.ForEachRoad([&](uint32_t featureId, RoadJointIds const &) {
+    featureIds.push_back(featureId);
+  });
+  // Roads are iterated in the hash map order, sort them to make the layout deterministic.
+  std::sort(featureIds.begin(), featureIds.end());
+
+  m_featureToRoad.assign(featureIds.empty() ? 0 : featureIds.back() + 1, kNoRoad);
+
+  std::vector<uint32_t> order;
+  order.reserve(featureIds.size());
+  std::queue<uint32_t> queue;
+  auto const enqueue = [&](uint32_t featureId) {
+    if (m_featureToRoad[featureId] != kNoRoad)
+      return;
+
+    m_featureToRoad[featureId] = base::checked_cast<uint32_t>(order.size());
+    order.push_back(featureId);
+    queue.push(featureId);
+  };
+
+  // BFS over the roads connected by joints. Every connected component starts from its road
+  // with the least feature id.
+  for (uint32_t const startId : featureIds)
+  {
+    enqueue(startId);
+    while (!queue.empty())
+    {
+      uint32_t const featureId = queue.front();
+      queue.pop();
+      roadIndex.GetRoad(featureId).ForEachJoint([&](uint32_t /* pointId */, Joint::Id jointId) {
+        jointIndex.ForEachPoint(jointId, [&](RoadPoint const & rp) {
+          if (roadIndex.IsRoad(rp.GetFeatureId()))
+            enqueue(rp.GetFeatureId());
+        });
+      });
+    }
+  }
+
+  m_roadOffsets.reserve(order.size() + 1);
+  m_roadOffsets.push_back(0);
+  for (uint32_t const featureId : order)
+  {
+    RoadJointIds const & road = roadIndex.GetRoad(featureId);
+    uint32_t const begin = m_roadOffsets.back();
+    road.ForEachJoint([&](uint32_t pointId, Joint::Id jointId) {
+      uint32_t const idx = begin + pointId;
+      if (idx >= m_jointIds.size())
+        m_jointIds.resize(idx + 1, Joint::kInvalidId);
+      m_jointIds[idx] = jointId;
+    });
+    m_roadOffsets.push_back(base::checked_cast<uint32_t>(m_jointIds.size()));
+  }
+
+  m_jointIds.shrink_to_fit();
+}
+
+std::pair<Joint::Id, uint32_t> CompactRoadIndex::FindNeighbor(uint32_t featureId, uint32_t pointId,
+                                                              bool forward,
+                                                              uint32_t pointsNumber) const
+{
+  CHECK_GREATER_OR_EQUAL(pointsNumber, 2, ("Number of points of road should be greater or equal 2"));
+
+  uint32_t const road = GetRoadNumber(featureId);
+  CHECK_NOT_EQUAL(road, kNoRoad, ("Feature id:", featureId));
+
+  uint32_t const begin = m_roadOffsets[road];
+  uint32_t const size = m_roadOffsets[road + 1] - begin;
+  uint32_t const end = std::min(size, pointsNumber);
+  if (forward)
+  {
+    for (uint32_t index = pointId + 1; index < end; ++index)
+    {
+      Joint::Id const jointId = m_jointIds[begin + index];
+      if (jointId != Joint::kInvalidId)
+        return {jointId, index};
+    }
+  }
+  else
+  {
+    for (uint32_t index = std::min(pointId, end); index > 0; --index)
+    {
+      Joint::Id const jointId = m_jointIds[begin + index - 1];
+      if (jointId != Joint::kInvalidId)
+        return {jointId, index - 1};
+    }
+  }
+
+  // Return the end or start of road, depends on forward flag.
+  return {Joint::kInvalidId, forward ? pointsNumber - 1 : 0};
+}
+}  // namespace routing
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "routing/joint.hpp"
+#include "routing/joint_index.hpp"
+#include "routing/road_index.hpp"
+#include "routing/road_point.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace routing
+{
+// CompactRoadIndex is an immutable flat copy of RoadIndex for the hot path of IndexGraph.
+//
+// Joint ids of all the roads are stored in one vector (CSR layout): joints of a road are
+// [m_roadOffsets[road], m_roadOffsets[road + 1]) entries of m_jointIds indexed by point id.
+// Roads are numbered in BFS order over joints, so roads which are expanded one after another
+// by the routing wave are stored close to each other. Feature id is mapped to the road number
+// by a dense vector, so GetJointId() is two array lookups without hashing.
+class CompactRoadIndex final
+{
+public:
+  static uint32_t constexpr kNoRoad = std::numeric_limits<uint32_t>::max();
+
+  CompactRoadIndex(RoadIndex const & roadIndex, JointIndex const & jointIndex);
+
+  bool IsRoad(uint32_t featureId) const { return GetRoadNumber(featureId) != kNoRoad; }
+
+  /// @returns the position of |featureId| road in the layout or kNoRoad.
+  uint32_t GetRoadNumber(uint32_t featureId) const
+  {
+    return featureId < m_featureToRoad.size() ? m_featureToRoad[featureId] : kNoRoad;
+  }
+
+  uint32_t GetNumRoads() const { return static_cast<uint32_t>(m_roadOffsets.size() - 1); }
+
+  Joint::Id GetJointId(RoadPoint const & rp) const
+  {
+    uint32_t const road = GetRoadNumber(rp.GetFeatureId());
+    if (road == kNoRoad)
+      return Joint::kInvalidId;
+
+    uint32_t const idx = m_roadOffsets[road] + rp.GetPointId();
+    if (idx >= m_roadOffsets[road + 1])
+      return Joint::kInvalidId;
+
+    return m_jointIds[idx];
+  }
+
+  // The same as RoadJointIds::FindNeighbor() for |featureId| road.
+  std::pair<Joint::Id, uint32_t> FindNeighbor(uint32_t featureId, uint32_t pointId, bool forward,
+                                              uint32_t pointsNumber) const;
+
+private:
+  std::vector<uint32_t> m_featureToRoad;
+  std::vector<uint32_t> m_roadOffsets;
+  std::vector<Joint::Id> m_jointIds;
+};
+}  // namespace routing
@@ -181,6 +181,29 @@ FeaturesRoadGraphBase::FindRoads(m2::RectD const & rect, IsGoodFeatureFn const &
   return roads;
 }
 
+vector<IRoadGraph::FullRoadInfo>
+FeaturesRoadGraphBase::GetRoads(vector<FeatureID> const & featureIds, m2::RectD const & rect) const
+{
+  vector<IRoadGraph::FullRoadInfo> roads;
+  for (auto const & featureId : featureIds)
+  {
+    bool found = false;
+    RoadInfo & ri = m_cache.Find(featureId, found);
+    if (!found)
+    {
+      auto ft = m_dataSource.GetFeature(featureId);
+      if (!ft)
+        continue;
+      ExtractRoadInfo(featureId, *ft, kInvalidSpeedKMPH, ri);
+    }
+
+    if (!ri.m_junctions.empty() && RectCoversPolyline(ri.m_junctions, rect))
+      roads.emplace_back(featureId, ri);
+  }
+
+  return roads;
+}
+
 void FeaturesRoadGraphBase::GetFeatureTypes(FeatureID const & featureId, feature::TypesHolder & types) const
 {
   auto ft = m_dataSource.GetFeature(featureId);
@@ -98,6 +98,11 @@ public:
 
   bool IsRoad(FeatureType & ft) const;
 
+  /// \returns roads with |featureIds| which cross |rect|. Unlike FindRoads() only the features
+  /// with |featureIds| are read.
+  std::vector<IRoadGraph::FullRoadInfo> GetRoads(std::vector<FeatureID> const & featureIds,
+                                                 m2::RectD const & rect) const;
+
 protected:
   MwmDataSource & m_dataSource;
 
@@ -13,6 +13,8 @@
 #include "base/assert.hpp"
 #include "base/string_utils.hpp"
 
+#include <atomic>
+#include <sstream>
 #include <string>
 
 namespace routing
@@ -140,6 +142,10 @@ private:
   RoadAttrsGetter m_attrsGetter;
   VehicleModelPtrT m_vehicleModel;
 };
+
+// Summary stats of road geometry caches, see Geometry::GetTotalCacheStats().
+atomic<uint64_t> g_totalCacheRequests{0};
+atomic<uint64_t> g_totalCacheMisses{0};
 } // namespace
 
 
@@ -275,6 +281,13 @@ double RoadGeometry::GetRoadLengthM() const
 }
 
 // Geometry ----------------------------------------------------------------------------------------
+double Geometry::CacheStats::GetHitRate() const
+{
+  if (m_requests == 0)
+    return 0.0;
+  return static_cast<double>(m_requests - m_misses) / static_cast<double>(m_requests);
+}
+
 Geometry::Geometry(unique_ptr<GeometryLoader> loader, size_t roadsCacheSize)
   : m_loader(std::move(loader))
 {
@@ -282,15 +295,32 @@ Geometry::Geometry(unique_ptr<GeometryLoader> loader, size_t roadsCacheSize)
 
   m_featureIdToRoad = make_unique<RoutingCacheT>(roadsCacheSize, [this](uint32_t featureId, RoadGeometry & road)
   {
+    ++m_cacheStats.m_misses;
     m_loader->Load(featureId, road);
   });
 }
 
+Geometry::~Geometry()
+{
+  g_totalCacheRequests += m_cacheStats.m_requests;
+  g_totalCacheMisses += m_cacheStats.m_misses;
+}
+
+// static
+Geometry::CacheStats Geometry::GetTotalCacheStats()
+{
+  CacheStats stats;
+  stats.m_requests = g_totalCacheRequests.load();
+  stats.m_misses = g_totalCacheMisses.load();
+  return stats;
+}
+
 RoadGeometry const & Geometry::GetRoad(uint32_t featureId)
 {
   ASSERT(m_featureIdToRoad, ());
   ASSERT(m_loader, ());
 
+  ++m_cacheStats.m_requests;
   return m_featureIdToRoad->GetValue(featureId);
 }
 
@@ -316,4 +346,12 @@ unique_ptr<GeometryLoader> GeometryLoader::CreateFromFile(
   CHECK(vehicleModel, ());
   return make_unique<FileGeometryLoader>(fileName, vehicleModel);
 }
+
+string DebugPrint(Geometry::CacheStats const & stats)
+{
+  ostringstream out;
+  out << "CacheStats [ requests: " << stats.m_requests << ", misses: " << stats.m_misses
+      << ", hit rate: " << stats.GetHitRate() << " ]";
+  return out.str();
+}
 }  // namespace routing
@@ -132,10 +132,24 @@ public:
 class Geometry final
 {
 public:
+  struct CacheStats
+  {
+    double GetHitRate() const;
+
+    uint64_t m_requests = 0;
+    uint64_t m_misses = 0;
+  };
+
   Geometry() = default;
   /// \brief Geometry constructor
   /// \param roadsCacheSize in-memory geometry elements count limit
   Geometry(std::unique_ptr<GeometryLoader> loader, size_t roadsCacheSize = kRoadsCacheSize);
+  ~Geometry();
+
+  /// \returns summary stats of the caches of all the Geometry objects destroyed in the process.
+  /// Stats are accumulated once per object to keep GetRoad() cheap.
+  static CacheStats GetTotalCacheStats();
+  CacheStats const & GetCacheStats() const { return m_cacheStats; }
 
   /// \note The reference returned by the method is valid until the next call of GetRoad()
   /// of GetPoint() methods.
@@ -159,5 +173,8 @@ private:
 
   std::unique_ptr<GeometryLoader> m_loader;
   std::unique_ptr<RoutingCacheT> m_featureIdToRoad;
+  CacheStats m_cacheStats;
 };
+
+std::string DebugPrint(Geometry::CacheStats const & stats);
 }  // namespace routing
@@ -45,7 +45,7 @@ IndexGraph::IndexGraph(shared_ptr<Geometry> geometry, shared_ptr<EdgeEstimator>
 
 bool IndexGraph::IsJoint(RoadPoint const & roadPoint) const
 {
-  return m_roadIndex.GetJointId(roadPoint) != Joint::kInvalidId;
+  return GetJointId(roadPoint) != Joint::kInvalidId;
 }
 
 bool IndexGraph::IsJointOrEnd(Segment const & segment, bool fromStart) const
@@ -86,7 +86,7 @@ void IndexGraph::GetEdgeListImpl(astar::VertexData<Segment, RouteWeight> const &
   auto const & segment = vertexData.m_vertex;
 
   RoadPoint const roadPoint = segment.GetRoadPoint(isOutgoing);
-  Joint::Id const jointId = m_roadIndex.GetJointId(roadPoint);
+  Joint::Id const jointId = GetJointId(roadPoint);
 
   if (jointId != Joint::kInvalidId)
   {
@@ -123,7 +123,10 @@ void IndexGraph::GetLastPointsForJoint(SegmentListT const & children,
     bool forward = child.IsForward() == isOutgoing;
     if (IsRoad(child.GetFeatureId()))
     {
-      endPointId = GetRoad(child.GetFeatureId()).FindNeighbor(startPointId, forward, pointsNumber).second;
+      uint32_t const featureId = child.GetFeatureId();
+      endPointId = m_compactRoadIndex
+                       ? m_compactRoadIndex->FindNeighbor(featureId, startPointId, forward, pointsNumber).second
+                       : GetRoad(featureId).FindNeighbor(startPointId, forward, pointsNumber).second;
     }
     else
     {
@@ -207,6 +210,14 @@ void IndexGraph::Import(vector<Joint> const & joints)
   Build(checked_cast<uint32_t>(joints.size()));
 }
 
+void IndexGraph::BuildCompactRoadIndex()
+{
+  base::HighResTimer timer;
+  m_compactRoadIndex = make_unique<CompactRoadIndex const>(m_roadIndex, m_jointIndex);
+  LOG(LDEBUG, ("Compact road index of", m_compactRoadIndex->GetNumRoads(), "roads is built in",
+               timer.ElapsedMilliseconds(), "ms."));
+}
+
 void IndexGraph::SetRestrictions(RestrictionVec && restrictions)
 {
   m_restrictionsForward.clear();
@@ -244,6 +255,18 @@ void IndexGraph::SetRoadAccess(RoadAccess && roadAccess)
   m_roadAccess.SetCurrentTimeGetter(m_currentTimeGetter);
 }
 
+void IndexGraph::SetSpeedProfiles(std::shared_ptr<SpeedProfiles const> speedProfiles)
+{
+  m_speedProfiles = std::move(speedProfiles);
+  UpdateDepartureWeekTime();
+}
+
+void IndexGraph::UpdateDepartureWeekTime()
+{
+  if (m_speedProfiles)
+    m_departureWeekTime = m_speedProfiles->GetWeekTime(m_currentTimeGetter());
+}
+
 void IndexGraph::GetNeighboringEdges(astar::VertexData<Segment, RouteWeight> const & fromVertexData,
                                      RoadPoint const & rp, bool isOutgoing, bool useRoutingOptions,
                                      SegmentEdgeListT & edges, Parents<Segment> const & parents,
@@ -299,7 +322,7 @@ void IndexGraph::GetSegmentCandidateForJoint(Segment const & parent, bool isOutg
                                              SegmentListT & children) const
 {
   RoadPoint const roadPoint = parent.GetRoadPoint(isOutgoing);
-  Joint::Id const jointId = m_roadIndex.GetJointId(roadPoint);
+  Joint::Id const jointId = GetJointId(roadPoint);
 
   if (jointId == Joint::kInvalidId)
     return;
@@ -397,8 +420,12 @@ void IndexGraph::ReconstructJointSegment(astar::VertexData<JointSegment, RouteWe
 
     do
     {
+      // With speed profiles every segment is costed at the time of arrival at it, which is known
+      // for the forward wave only.
+      RouteWeight const weightTimeToCurrent =
+          m_speedProfiles && isOutgoing ? weightTimeToParent + summaryWeight : weightTimeToParent;
       RouteWeight const weight = CalculateEdgeWeight(EdgeEstimator::Purpose::Weight, isOutgoing,
-                                                     prev, current, weightTimeToParent);
+                                                     prev, current, weightTimeToCurrent);
 
       if (isOutgoing || prev != parent)
         summaryWeight += weight;
@@ -533,7 +560,7 @@ bool IndexGraph::IsUTurnAndRestricted(Segment const & parent, Segment const & ch
   auto const & roadGeometry = GetRoadGeometry(featureId);
 
   RoadPoint const rp = parent.GetRoadPoint(isOutgoing);
-  if (m_roadIndex.GetJointId(rp) == Joint::kInvalidId && !roadGeometry.IsEndPointId(turnPoint))
+  if (GetJointId(rp) == Joint::kInvalidId && !roadGeometry.IsEndPointId(turnPoint))
     return true;
 
   auto const it = m_noUTurnRestrictions.find(featureId);
@@ -556,7 +583,18 @@ RouteWeight IndexGraph::CalculateEdgeWeight(EdgeEstimator::Purpose purpose, bool
   auto const & segment = isOutgoing ? to : from;
   auto const & road = GetRoadGeometry(segment.GetFeatureId());
 
-  auto const weight = RouteWeight(m_estimator->CalcSegmentWeight(segment, road, purpose));
+  auto weight = RouteWeight(m_estimator->CalcSegmentWeight(segment, road, purpose));
+
+  // |prevWeight| is the time of arrival at |to| for the forward wave only.
+  if (m_speedProfiles && isOutgoing && prevWeight)
+  {
+    uint64_t const arrival =
+        m_departureWeekTime + static_cast<uint64_t>(std::max(prevWeight->GetWeight(), 0.0));
+    double const factor = m_speedProfiles->GetSpeedFactor(segment.GetFeatureId(), segment.GetSegmentIdx(),
+                                                          segment.IsForward(), arrival);
+    weight = RouteWeight(weight.GetWeight() / factor);
+  }
+
   auto const penalties = GetPenalties(purpose, isOutgoing ? from : to, isOutgoing ? to : from, prevWeight);
 
   return weight + penalties;
@@ -3,6 +3,7 @@
 #include "routing/base/astar_graph.hpp"
 #include "routing/base/astar_vertex_data.hpp"
 
+#include "routing/compact_road_index.hpp"
 #include "routing/edge_estimator.hpp"
 #include "routing/geometry.hpp"
 #include "routing/joint.hpp"
@@ -14,6 +15,7 @@
 #include "routing/road_point.hpp"
 #include "routing/routing_options.hpp"
 #include "routing/segment.hpp"
+#include "routing/speed_profiles.hpp"
 
 #include "geometry/point2d.hpp"
 
@@ -70,9 +72,15 @@ public:
                                                    Segment const & firstChild, bool isOutgoing,
                                                    uint32_t lastPoint) const;
 
-  Joint::Id GetJointId(RoadPoint const & rp) const { return m_roadIndex.GetJointId(rp); }
+  Joint::Id GetJointId(RoadPoint const & rp) const
+  {
+    return m_compactRoadIndex ? m_compactRoadIndex->GetJointId(rp) : m_roadIndex.GetJointId(rp);
+  }
 
-  bool IsRoad(uint32_t featureId) const { return m_roadIndex.IsRoad(featureId); }
+  bool IsRoad(uint32_t featureId) const
+  {
+    return m_compactRoadIndex ? m_compactRoadIndex->IsRoad(featureId) : m_roadIndex.IsRoad(featureId);
+  }
   RoadJointIds const & GetRoad(uint32_t featureId) const { return m_roadIndex.GetRoad(featureId); }
   RoadGeometry const & GetRoadGeometry(uint32_t featureId) const { return m_geometry->GetRoad(featureId); }
 
@@ -89,10 +97,16 @@ public:
 
   void Build(uint32_t numJoints);
   void Import(std::vector<Joint> const & joints);
+  /// Builds CompactRoadIndex from the road and joint indexes which are used for the joint lookups
+  /// while routing after that. Should be called after the graph is built or deserialized.
+  void BuildCompactRoadIndex();
+  bool HasCompactRoadIndex() const { return m_compactRoadIndex != nullptr; }
 
   void SetRestrictions(RestrictionVec && restrictions);
   void SetUTurnRestrictions(std::vector<RestrictionUTurn> && noUTurnRestrictions);
   void SetRoadAccess(RoadAccess && roadAccess);
+  /// Makes weights of the outgoing edges depend on the time of arrival at the edges.
+  void SetSpeedProfiles(std::shared_ptr<SpeedProfiles const> speedProfiles);
 
   void PushFromSerializer(Joint::Id jointId, RoadPoint const & rp)
   {
@@ -142,9 +156,15 @@ public:
                                   std::optional<RouteWeight const> const & prevWeight = std::nullopt) const;
 
   template <typename T>
-  void SetCurrentTimeGetter(T && t) { m_currentTimeGetter = std::forward<T>(t); }
+  void SetCurrentTimeGetter(T && t)
+  {
+    m_currentTimeGetter = std::forward<T>(t);
+    UpdateDepartureWeekTime();
+  }
 
 private:
+  void UpdateDepartureWeekTime();
+
   void GetEdgeListImpl(astar::VertexData<Segment, RouteWeight> const & vertexData, bool isOutgoing,
                        bool useRoutingOptions, bool useAccessConditional,
                        SegmentEdgeListT & edges, Parents<Segment> const & parents) const;
@@ -201,6 +221,7 @@ private:
   std::shared_ptr<EdgeEstimator> m_estimator;
   RoadIndex m_roadIndex;
   JointIndex m_jointIndex;
+  std::unique_ptr<CompactRoadIndex const> m_compactRoadIndex;
 
   Restrictions m_restrictionsForward;
   Restrictions m_restrictionsBackward;
@@ -219,6 +240,10 @@ private:
   std::unordered_map<uint32_t, UTurnEnding> m_noUTurnRestrictions;
 
   RoadAccess m_roadAccess;
+  // May be nullptr.
+  std::shared_ptr<SpeedProfiles const> m_speedProfiles;
+  // Local time of the week of |m_speedProfiles| when the route starts.
+  uint32_t m_departureWeekTime = 0;
   RoutingOptions m_avoidRoutingOptions;
 
   std::function<time_t()> m_currentTimeGetter = []() {
@@ -7,6 +7,7 @@
 #include "routing/road_access_serialization.hpp"
 #include "routing/route.hpp"
 #include "routing/speed_camera_ser_des.hpp"
+#include "routing/speed_profiles_serialization.hpp"
 
 #include "coding/files_container.hpp"
 
@@ -30,9 +31,12 @@ public:
   IndexGraphLoaderImpl(VehicleType vehicleType, bool loadAltitudes,
                        shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
                        shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-                       RoutingOptions routingOptions = RoutingOptions())
+                       RoutingOptions routingOptions = RoutingOptions(), bool loadSpeedProfiles = false,
+                       bool buildCompactRoadIndex = false)
     : m_vehicleType(vehicleType)
     , m_loadAltitudes(loadAltitudes)
+    , m_loadSpeedProfiles(loadSpeedProfiles)
+    , m_buildCompactRoadIndex(buildCompactRoadIndex)
     , m_dataSource(dataSource)
     , m_vehicleModelFactory(std::move(vehicleModelFactory))
     , m_estimator(std::move(estimator))
@@ -56,6 +60,8 @@ private:
 
   VehicleType m_vehicleType;
   bool m_loadAltitudes;
+  bool m_loadSpeedProfiles;
+  bool m_buildCompactRoadIndex;
   MwmDataSource & m_dataSource;
   shared_ptr<VehicleModelFactoryInterface> m_vehicleModelFactory;
   shared_ptr<EdgeEstimator> m_estimator;
@@ -146,6 +152,16 @@ IndexGraphLoaderImpl::GraphPtrT IndexGraphLoaderImpl::CreateIndexGraph(NumMwmId
   DeserializeIndexGraph(*value, m_vehicleType, *graph);
   LOG(LINFO, (ROUTING_FILE_TAG, "section for", value->GetCountryFileName(), "loaded in", timer.ElapsedSeconds(), "seconds"));
 
+  if (m_buildCompactRoadIndex)
+    graph->BuildCompactRoadIndex();
+
+  if (m_loadSpeedProfiles)
+  {
+    auto speedProfiles = make_shared<SpeedProfiles>();
+    if (ReadSpeedProfilesFromMwm(*value, *speedProfiles) && !speedProfiles->IsEmpty())
+      graph->SetSpeedProfiles(std::move(speedProfiles));
+  }
+
   return graph;
 }
 
@@ -202,15 +218,34 @@ bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, VehicleType vehicleType, R
   return false;
 }
 
+bool ReadSpeedProfilesFromMwm(MwmValue const & mwmValue, SpeedProfiles & speedProfiles)
+{
+  if (!mwmValue.m_cont.IsExist(SPEED_PROFILES_FILE_TAG))
+    return false;
+
+  try
+  {
+    auto const reader = mwmValue.m_cont.GetReader(SPEED_PROFILES_FILE_TAG);
+    ReaderSource src(reader);
+    return SpeedProfilesSerializer::Deserialize(src, speedProfiles);
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("Error while reading", SPEED_PROFILES_FILE_TAG, "section.", e.Msg()));
+  }
+  return false;
+}
+
 // static
 unique_ptr<IndexGraphLoader> IndexGraphLoader::Create(
     VehicleType vehicleType, bool loadAltitudes,
     shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
     shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-    RoutingOptions routingOptions)
+    RoutingOptions routingOptions, bool loadSpeedProfiles, bool buildCompactRoadIndex)
 {
   return make_unique<IndexGraphLoaderImpl>(vehicleType, loadAltitudes, vehicleModelFactory,
-                                           estimator, dataSource, routingOptions);
+                                           estimator, dataSource, routingOptions, loadSpeedProfiles,
+                                           buildCompactRoadIndex);
 }
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph)
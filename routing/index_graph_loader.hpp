@@ -34,7 +34,8 @@ public:
       VehicleType vehicleType, bool loadAltitudes,
       std::shared_ptr<VehicleModelFactoryInterface> vehicleModelFactory,
       std::shared_ptr<EdgeEstimator> estimator, MwmDataSource & dataSource,
-      RoutingOptions routingOptions = RoutingOptions());
+      RoutingOptions routingOptions = RoutingOptions(), bool loadSpeedProfiles = false,
+      bool buildCompactRoadIndex = false);
 };
 
 void DeserializeIndexGraph(MwmValue const & mwmValue, VehicleType vehicleType, IndexGraph & graph);
@@ -43,4 +44,6 @@ uint32_t DeserializeIndexGraphNumRoads(MwmValue const & mwmValue, VehicleType ve
 
 bool ReadRoadAccessFromMwm(MwmValue const & mwmValue, VehicleType vehicleType, RoadAccess & roadAccess);
 bool ReadSpeedCamsFromMwm(MwmValue const & mwmValue, SpeedCamerasMapT & camerasMap);
+/// \returns false if there's no speed_profiles section in the mwm or it can't be read.
+bool ReadSpeedProfilesFromMwm(MwmValue const & mwmValue, SpeedProfiles & speedProfiles);
 }  // namespace routing
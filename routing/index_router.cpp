@@ -239,6 +239,22 @@ double IndexRouter::BestEdgeComparator::GetSquaredDist(Edge const & edge) const
 }
 
 // IndexRouter ------------------------------------------------------------------------------------
+string const IndexRouter::kTimeDependentRoutingSettings = "time_dependent_routing";
+
+// static
+bool IndexRouter::LoadTimeDependentRoutingFromSettings()
+{
+  bool enable = false;
+  settings::TryGet(kTimeDependentRoutingSettings, enable);
+  return enable;
+}
+
+// static
+void IndexRouter::SaveTimeDependentRoutingToSettings(bool enable)
+{
+  settings::Set(kTimeDependentRoutingSettings, enable);
+}
+
 IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
                          CountryParentNameGetterFn const & countryParentNameGetterFn,
                          TCountryFileFn const & countryFileFn, CountryRectFn const & countryRectFn,
@@ -273,6 +289,13 @@ IndexRouter::IndexRouter(VehicleType vehicleType, bool loadAltitudes,
   CHECK(m_directionsEngine, ());
 }
 
+bool IndexRouter::IsTimeDependentRouting() const
+{
+  if (m_vehicleType != VehicleType::Car)
+    return false;
+  return m_timeDependentRouting ? *m_timeDependentRouting : LoadTimeDependentRoutingFromSettings();
+}
+
 unique_ptr<WorldGraph> IndexRouter::MakeSingleMwmWorldGraph()
 {
   auto worldGraph = MakeWorldGraph();
@@ -388,6 +411,138 @@ bool IndexRouter::GetBestOutgoingEdges(m2::PointD const & checkpoint, WorldGraph
                                 FeaturesRoadGraph::kClosestEdgesRadiusM, edges, dummy);
 }
 
+RouterResultCode IndexRouter::CalculateIsochrone(m2::PointD const & start,
+                                                 IsochroneParams const & params,
+                                                 RouterDelegate const & delegate,
+                                                 Isochrone & isochrone)
+{
+  try
+  {
+    SCOPE_GUARD(featureRoadGraphClear, [this]
+    {
+      ClearState();
+    });
+
+    base::Timer timer;
+    TrafficStash::Guard guard(m_trafficStash);
+    auto graph = MakeWorldGraph();
+    graph->SetMode(WorldGraphMode::NoLeaps);
+
+    vector<Segment> startSegments;
+    bool bestSegmentIsAlmostCodirectional = false;
+    PointsOnEdgesSnapping snapping(*this, *graph);
+    if (!snapping.FindBestSegments(start, m2::PointD::Zero() /* startDirection */, true /* isOutgoing */,
+                                   startSegments, bestSegmentIsAlmostCodirectional))
+    {
+      return RouterResultCode::StartPointNotFound;
+    }
+
+    FakeEnding dummy{};
+    IndexGraphStarter starter(MakeFakeEnding(startSegments, start, *graph), dummy,
+                              0 /* fakeNumerationStart */, bestSegmentIsAlmostCodirectional, *graph);
+
+    if (!BuildIsochrone(starter, params, delegate.GetCancellable(), isochrone))
+      return RouterResultCode::Cancelled;
+
+    double const elapsedSec = timer.ElapsedSeconds();
+    LOG(LINFO, ("Isochrone from", mercator::ToLatLon(start), "for", params.m_maxTimeSec, "seconds:",
+                isochrone, "elapsed:", elapsedSec, "seconds, settled per second:",
+                elapsedSec > 0.0 ? isochrone.m_settledCount / elapsedSec : 0.0));
+    return RouterResultCode::NoError;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't build isochrone from", mercator::ToLatLon(start), ":\n ", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
+RouterResultCode IndexRouter::CalculateAlternativeRoutes(m2::PointD const & start,
+                                                         m2::PointD const & startDirection,
+                                                         m2::PointD const & finish,
+                                                         astar::AlternativesParams const & params,
+                                                         RouterDelegate const & delegate,
+                                                         vector<unique_ptr<Route>> & routes)
+{
+  routes.clear();
+
+  try
+  {
+    SCOPE_GUARD(featureRoadGraphClear, [this]
+    {
+      ClearState();
+    });
+
+    base::Timer timer;
+    TrafficStash::Guard guard(m_trafficStash);
+    auto graph = MakeWorldGraph();
+    graph->SetMode(WorldGraphMode::NoLeaps);
+
+    FakeEnding startEnding;
+    FakeEnding finishEnding;
+    bool startIsCodirectional = false;
+    PointsOnEdgesSnapping snapping(*this, *graph);
+    switch (snapping.Snap(start, finish, startDirection, startEnding, finishEnding, startIsCodirectional))
+    {
+    case 1: return RouterResultCode::StartPointNotFound;
+    case 2: return RouterResultCode::EndPointNotFound;
+    }
+
+    IndexGraphStarter starter(startEnding, finishEnding, 0 /* fakeNumerationStart */,
+                              startIsCodirectional, *graph);
+
+    using Vertex = IndexGraphStarter::Vertex;
+    using Edge = IndexGraphStarter::Edge;
+    using Weight = IndexGraphStarter::Weight;
+
+    AStarAlgorithm<Vertex, Edge, Weight>::Params<astar::DefaultVisitor, AStarLengthChecker> algoParams(
+        starter, starter.GetStartSegment(), starter.GetFinishSegment(), delegate.GetCancellable(),
+        astar::DefaultVisitor(), AStarLengthChecker(starter));
+
+    vector<RoutingResult<Vertex, Weight>> results;
+    auto const code = ConvertResult<Vertex, Edge, Weight>(
+        AStarAlgorithm<Vertex, Edge, Weight>().FindAlternativePathsBidirectional(algoParams, params, results));
+    if (code != RouterResultCode::NoError)
+      return code;
+
+    for (auto const & result : results)
+    {
+      IndexGraphStarter::CheckValidRoute(result.m_path);
+
+      auto route = make_unique<Route>(GetName(), routes.size() /* routeId */);
+      route->SetCurrentSubrouteIdx(0);
+      vector<Route::SubrouteAttrs> subroutes;
+      subroutes.emplace_back(starter.GetStartJunction().ToPointWithAltitude(),
+                             starter.GetFinishJunction().ToPointWithAltitude(), 0 /* beginSegmentIdx */,
+                             result.m_path.size());
+      route->SetSubroteAttrs(std::move(subroutes));
+
+      auto const redressResult = RedressRoute(result.m_path, delegate.GetCancellable(), starter, *route);
+      if (redressResult != RouterResultCode::NoError)
+      {
+        // The best route must be redressed.
+        if (redressResult == RouterResultCode::Cancelled || routes.empty())
+          return redressResult;
+
+        LOG(LWARNING, ("Can't redress alternative route, weight:", result.m_distance));
+        continue;
+      }
+
+      routes.push_back(std::move(route));
+    }
+
+    LOG(LINFO, ("Routes from", mercator::ToLatLon(start), "to", mercator::ToLatLon(finish), ":",
+                routes.size(), "elapsed:", timer.ElapsedSeconds(), "seconds."));
+    return RouterResultCode::NoError;
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Can't find alternative routes from", mercator::ToLatLon(start), "to",
+                 mercator::ToLatLon(finish), ":\n ", e.what()));
+    return RouterResultCode::InternalError;
+  }
+}
+
 void IndexRouter::AppendPartsOfReal(LatLonWithAltitude const & point1,
                                     LatLonWithAltitude const & point2, uint32_t & startIdx,
                                     ConnectionToOsm & link)
@@ -1123,7 +1278,8 @@ unique_ptr<WorldGraph> IndexRouter::MakeWorldGraph()
 
   auto indexGraphLoader = IndexGraphLoader::Create(
       m_vehicleType == VehicleType::Transit ? VehicleType::Pedestrian : m_vehicleType,
-      m_loadAltitudes, m_vehicleModelFactory, m_estimator, m_dataSource, routingOptions);
+      m_loadAltitudes, m_vehicleModelFactory, m_estimator, m_dataSource, routingOptions,
+      IsTimeDependentRouting(), m_compactRoadIndex);
 
   if (m_vehicleType != VehicleType::Transit)
   {
@@ -1299,22 +1455,36 @@ bool IndexRouter::PointsOnEdgesSnapping::FindBestSegments(
         m2::PointD const & checkpoint, m2::PointD const & direction, bool isOutgoing,
         vector<Segment> & bestSegments, bool & bestSegmentIsAlmostCodirectional)
 {
+  // If roads around are indexed, they are taken from the index in the radius which is large enough
+  // to contain the closest ones and the legacy radii are tried only if it's failed.
+  vector<RoadInfoT> indexedRoads;
+  double const indexedRadiusM = FindIndexedRoads(checkpoint, indexedRoads);
+
   vector<Edge> bestEdges;
-  if (!FindBestEdges(checkpoint, direction, isOutgoing, kFirstSearchDistanceM /* closestEdgesRadiusM */,
-                     bestEdges, bestSegmentIsAlmostCodirectional))
+  bool found = indexedRadiusM > 0.0 && FindBestEdgesOnRoads(checkpoint, direction, isOutgoing, move(indexedRoads),
+                                                            bestEdges, bestSegmentIsAlmostCodirectional);
+  for (double const radiusM : {double(kFirstSearchDistanceM), 500.0, double(kMaxSearchDistanceM)})
   {
-    if (!FindBestEdges(checkpoint, direction, isOutgoing, 500.0 /* closestEdgesRadiusM */,
-                       bestEdges, bestSegmentIsAlmostCodirectional) &&
-                       bestEdges.size() < kMaxRoadCandidates)
+    if (found)
+      break;
+    if (radiusM <= indexedRadiusM)
+      continue;
+
+    // There are enough roads around, but the best ones are filtered out. The found edges are used
+    // without the search in the max radius.
+    if (radiusM == kMaxSearchDistanceM && bestEdges.size() >= kMaxRoadCandidates)
     {
-      if (!FindBestEdges(checkpoint, direction, isOutgoing, 2000.0 /* closestEdgesRadiusM */,
-                         bestEdges, bestSegmentIsAlmostCodirectional))
-      {
-        return false;
-      }
+      found = true;
+      break;
     }
+
+    found = FindBestEdges(checkpoint, direction, isOutgoing, radiusM /* closestEdgesRadiusM */,
+                          bestEdges, bestSegmentIsAlmostCodirectional);
   }
 
+  if (!found)
+    return false;
+
   bestSegments.clear();
   for (auto const & edge : bestEdges)
     bestSegments.emplace_back(GetSegmentByEdge(edge));
@@ -1322,6 +1492,84 @@ bool IndexRouter::PointsOnEdgesSnapping::FindBestSegments(
   return true;
 }
 
+double IndexRouter::PointsOnEdgesSnapping::FindIndexedRoads(m2::PointD const & checkpoint,
+                                                            vector<RoadInfoT> & roads)
+{
+  // Fences and dead ends near the candidates should be found too.
+  double constexpr kRadiusFactor = 1.5;
+
+  auto const maxRect = mercator::RectByCenterXYAndSizeInMeters(checkpoint, kMaxSearchDistanceM);
+  double const maxDist = max(maxRect.SizeX(), maxRect.SizeY()) / 2.0;
+  VehicleMask const mask = GetVehicleMask(m_router.m_vehicleType);
+
+  vector<pair<NumMwmId, RoadSegmentIndex const *>> indexes;
+  bool allIndexed = true;
+  vector<double> distsM;
+  m_router.m_numMwmTree->ForEachInRect(maxRect, [&](NumMwmId numMwmId)
+  {
+    auto it = m_segmentIndexes.find(numMwmId);
+    if (it == m_segmentIndexes.end())
+    {
+      auto & dataSource = m_router.m_dataSource;
+      auto const status = dataSource.GetSectionStatus(numMwmId, ROAD_SEGMENTS_INDEX_FILE_TAG);
+      if (status == MwmDataSource::MwmNotLoaded)
+        return;
+
+      unique_ptr<RoadSegmentIndex> index;
+      if (status == MwmDataSource::SectionExists)
+        index = LoadRoadSegmentIndex(dataSource.GetMwmValue(numMwmId));
+      it = m_segmentIndexes.emplace(numMwmId, move(index)).first;
+    }
+
+    if (!it->second)
+    {
+      allIndexed = false;
+      return;
+    }
+    indexes.emplace_back(numMwmId, it->second.get());
+
+    set<uint32_t> features;
+    it->second->ForEachNearest(checkpoint, mask, maxDist, [&](RoadSegmentIndex::Result const & res)
+    {
+      if (features.insert(res.m_featureId).second)
+        distsM.push_back(mercator::DistanceOnEarth(checkpoint, res.m_projection));
+      return features.size() < kMaxRoadCandidates;
+    });
+  });
+
+  if (!allIndexed)
+    return 0.0;
+
+  // There are no roads around. One search with the max radius is enough to be sure.
+  if (distsM.empty())
+    return kMaxSearchDistanceM;
+
+  size_t const n = min(distsM.size(), kMaxRoadCandidates);
+  nth_element(distsM.begin(), distsM.begin() + (n - 1), distsM.end());
+  double const radiusM = base::Clamp(distsM[n - 1] * kRadiusFactor, double(kFirstSearchDistanceM),
+                                     double(kMaxSearchDistanceM));
+
+  // All the roads which cross the rect of the radius are visited by the index too, so neither
+  // other features nor the roads out of the rect are read.
+  auto const rect = mercator::RectByCenterXYAndSizeInMeters(checkpoint, radiusM);
+  double const rectDist = m2::PointD(rect.SizeX(), rect.SizeY()).Length() / 2.0;
+  vector<FeatureID> featureIds;
+  for (auto const & [numMwmId, index] : indexes)
+  {
+    auto const mwmId = m_router.m_dataSource.GetMwmId(numMwmId);
+    set<uint32_t> features;
+    index->ForEachNearest(checkpoint, mask, rectDist, [&](RoadSegmentIndex::Result const & res)
+    {
+      if (features.insert(res.m_featureId).second)
+        featureIds.emplace_back(mwmId, res.m_featureId);
+      return true;
+    });
+  }
+
+  roads = m_router.m_roadGraph.GetRoads(featureIds, rect);
+  return radiusM;
+}
+
 bool IndexRouter::PointsOnEdgesSnapping::FindBestEdges(
         m2::PointD const & checkpoint, m2::PointD const & direction, bool isOutgoing, double closestEdgesRadiusM,
         vector<Edge> & bestEdges, bool & bestSegmentIsAlmostCodirectional)
@@ -1333,6 +1581,14 @@ bool IndexRouter::PointsOnEdgesSnapping::FindBestEdges(
     return m_router.m_numMwmIds->ContainsFile(info->GetLocalFile().GetCountryFile());
   });
 
+  return FindBestEdgesOnRoads(checkpoint, direction, isOutgoing, move(closestRoads), bestEdges,
+                              bestSegmentIsAlmostCodirectional);
+}
+
+bool IndexRouter::PointsOnEdgesSnapping::FindBestEdgesOnRoads(
+        m2::PointD const & checkpoint, m2::PointD const & direction, bool isOutgoing,
+        vector<RoadInfoT> && closestRoads, vector<Edge> & bestEdges, bool & bestSegmentIsAlmostCodirectional)
+{
   set<Segment> deadEnds[2];
   // Removing all dead ends from |closestRoads|. Then some candidates will be taken from |closestRoads|.
   // It's necessary to remove all dead ends for all |closestRoads| before IsFencedOff().
@@ -10,8 +10,10 @@
 #include "routing/fake_edges_container.hpp"
 #include "routing/features_road_graph.hpp"
 #include "routing/guides_connections.hpp"
+#include "routing/isochrone.hpp"
 #include "routing/nearest_edge_finder.hpp"
 #include "routing/regions_decl.hpp"
+#include "routing/road_segment_index.hpp"
 #include "routing/router.hpp"
 #include "routing/routing_callbacks.hpp"
 #include "routing/segment.hpp"
@@ -27,6 +29,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -87,8 +90,40 @@ public:
 
   bool GetBestOutgoingEdges(m2::PointD const & checkpoint, WorldGraph & graph, std::vector<Edge> & edges);
 
+  /// \brief Fills |isochrone| with all the segments which may be reached from |start|
+  /// in |params.m_maxTimeSec|.
+  RouterResultCode CalculateIsochrone(m2::PointD const & start, IsochroneParams const & params,
+                                      RouterDelegate const & delegate, Isochrone & isochrone);
+
+  /// \brief Calculates the best route from |start| to |finish| and up to |params.m_maxCount - 1|
+  /// meaningfully different alternatives. Alternatives are taken from the search spaces of one
+  /// bidirectional A* run in NoLeaps mode, so it's intended for routes inside neighbouring mwms.
+  /// |routes| are sorted by weight.
+  RouterResultCode CalculateAlternativeRoutes(m2::PointD const & start, m2::PointD const & startDirection,
+                                              m2::PointD const & finish,
+                                              astar::AlternativesParams const & params,
+                                              RouterDelegate const & delegate,
+                                              std::vector<std::unique_ptr<Route>> & routes);
+
   VehicleType GetVehicleType() const { return m_vehicleType; }
 
+  /// \brief Setting which enables time-dependent routing for car routes, it's read for every route
+  /// unless SetTimeDependentRouting() is called.
+  static std::string const kTimeDependentRoutingSettings;
+  static bool LoadTimeDependentRoutingFromSettings();
+  static void SaveTimeDependentRoutingToSettings(bool enable);
+
+  /// \brief Enables time-dependent routing: weights of segments with historical speed profiles
+  /// are evaluated at the time of arrival at them. Unidirectional A* is used in this mode,
+  /// because the arrival time is unknown for the backward wave. Only car routes are time-dependent.
+  void SetTimeDependentRouting(bool enable) { m_timeDependentRouting = enable; }
+  bool IsTimeDependentRouting() const;
+
+  /// \brief Builds CompactRoadIndex for every loaded mwm graph to look up joints without hashing
+  /// while routing. It costs a pass over all the roads of the mwm on every graph load.
+  void SetCompactRoadIndex(bool enable) { m_compactRoadIndex = enable; }
+  bool IsCompactRoadIndex() const { return m_compactRoadIndex; }
+
 private:
   RouterResultCode CalculateSubrouteJointsMode(IndexGraphStarter & starter,
                                                RouterDelegate const & delegate,
@@ -132,8 +167,11 @@ private:
     // dead-end candidates if they belong to one graph's cluster (island).
     std::set<Segment> m_deadEnds[2];
     std::vector<Segment> m_startSegments;
+    // Road segments indexes of the mwms around checkpoints. Null if an mwm has no such section.
+    std::map<NumMwmId, std::unique_ptr<RoadSegmentIndex>> m_segmentIndexes;
 
     static uint32_t constexpr kFirstSearchDistanceM = 40;
+    static uint32_t constexpr kMaxSearchDistanceM = 2000;
 
   public:
     PointsOnEdgesSnapping(IndexRouter & router, WorldGraph & graph) : m_router(router), m_graph(graph) {}
@@ -164,6 +202,17 @@ private:
 
     Segment GetSegmentByEdge(Edge const & edge) const;
 
+    /// \brief Fills |roads| with the roads of the neighbourhood of |checkpoint| which contains
+    /// the closest roads. The roads are taken from road_segments_index sections, so other features
+    /// around are not read.
+    /// \returns radius of the neighbourhood in meters or 0 if some mwm around has no such section.
+    double FindIndexedRoads(m2::PointD const & checkpoint, std::vector<RoadInfoT> & roads);
+
+    /// \brief Same as FindBestEdges() but with the candidates and the fences from |closestRoads|.
+    bool FindBestEdgesOnRoads(m2::PointD const & checkpoint, m2::PointD const & direction,
+                              bool isOutgoing, std::vector<RoadInfoT> && closestRoads,
+                              std::vector<Edge> & bestEdges, bool & bestSegmentIsAlmostCodirectional);
+
   public:
     /// \brief Fills |closestCodirectionalEdge| with a codirectional edge which is closest to
     /// |point| and returns true if there's any. If not returns false.
@@ -250,8 +299,9 @@ private:
                             RoutingResult<Vertex, Weight> & routingResult)
   {
     AStarAlgorithm<Vertex, Edge, Weight> algorithm;
-    return ConvertTransitResult(
-        mwmIds, ConvertResult<Vertex, Edge, Weight>(algorithm.FindPathBidirectional(params, routingResult)));
+    auto const result = IsTimeDependentRouting() ? algorithm.FindPath(params, routingResult)
+                                               : algorithm.FindPathBidirectional(params, routingResult);
+    return ConvertTransitResult(mwmIds, ConvertResult<Vertex, Edge, Weight>(result));
   }
 
   void SetupAlgorithmMode(IndexGraphStarter & starter, bool guidesActive = false) const;
@@ -271,6 +321,9 @@ private:
 
   VehicleType m_vehicleType;
   bool m_loadAltitudes;
+  // Overrides kTimeDependentRoutingSettings if it's set.
+  std::optional<bool> m_timeDependentRouting;
+  bool m_compactRoadIndex = false;
   std::string const m_name;
   MwmDataSource m_dataSource;
   std::shared_ptr<VehicleModelFactoryInterface> m_vehicleModelFactory;
@@ -0,0 +1,117 @@
+#include "routing/isochrone.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/route_weight.hpp"
+
+#include "coding/point_coding.hpp"
+
+#include "geometry/concave_hull.hpp"
+#include "geometry/mercator.hpp"
+#include "geometry/nearby_points_sweeper.hpp"
+
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+
+namespace routing
+{
+namespace
+{
+// Cancellation is checked once per |kCancelCheckPeriod| settled vertices.
+size_t constexpr kCancelCheckPeriod = 1000;
+
+void BuildHull(IndexGraphStarter & starter, IsochroneParams const & params, Isochrone & isochrone)
+{
+  std::vector<m2::PointD> points;
+  points.reserve(2 * isochrone.m_segments.size() + 1);
+  points.push_back(mercator::FromLatLon(starter.GetStartJunction().GetLatLon()));
+  for (auto const & reached : isochrone.m_segments)
+  {
+    points.push_back(mercator::FromLatLon(starter.GetPoint(reached.m_segment, false /* front */)));
+    points.push_back(mercator::FromLatLon(starter.GetPoint(reached.m_segment, true /* front */)));
+  }
+
+  double const cellSize = mercator::MetersToMercator(params.m_hullCellSizeM);
+  m2::NearbyPointsSweeper sweeper(cellSize);
+  for (size_t i = 0; i < points.size(); ++i)
+    sweeper.Add(points[i].x, points[i].y, i, 0 /* priority */);
+
+  std::vector<m2::PointD> thinned;
+  sweeper.Sweep([&](size_t i) { thinned.push_back(points[i]); });
+
+  // Edges shorter than a couple of cells can't be dug, there is no space between the points.
+  isochrone.m_hull = m2::ConcaveHull(thinned, params.m_hullConcavity, 2.0 * cellSize /* minEdgeLength */,
+                                     kMwmPointAccuracy).Points();
+}
+}  // namespace
+
+bool BuildIsochrone(IndexGraphStarter & starter, IsochroneParams const & params,
+                    base::Cancellable const & cancellable, Isochrone & isochrone)
+{
+  using Algorithm = AStarAlgorithm<Segment, SegmentEdge, RouteWeight>;
+
+  isochrone = {};
+
+  Algorithm algorithm;
+  Algorithm::Context context(starter);
+  bool cancelled = false;
+
+  auto const visitVertex = [&](Segment const & vertex)
+  {
+    if (isochrone.m_settledCount++ % kCancelCheckPeriod == 0 && cancellable.IsCancelled())
+    {
+      cancelled = true;
+      return false;
+    }
+
+    // Fake segments which are parts of real ones are reported as the real ones.
+    Segment real = vertex;
+    if (starter.ConvertToReal(real))
+      isochrone.m_segments.push_back({real, context.GetDistance(vertex).GetWeight()});
+    return true;
+  };
+
+  auto const adjustEdgeWeight = [](Segment const & /* vertex */, SegmentEdge const & edge)
+  {
+    return edge.GetWeight();
+  };
+
+  // Penalties are a part of the vertex order, so the wave is bounded by the filter only.
+  auto const filterStates = [&params](auto const & state)
+  {
+    return state.distance.GetWeight() <= params.m_maxTimeSec;
+  };
+
+  auto const reducedToRealLength = [](auto const & state) { return state.distance; };
+
+  algorithm.PropagateWave(starter, starter.GetStartSegment(), visitVertex, adjustEdgeWeight,
+                          filterStates, reducedToRealLength, context);
+  if (cancelled)
+    return false;
+
+  // The same real segment may be reached as itself and as a fake part of it.
+  auto & segments = isochrone.m_segments;
+  std::sort(segments.begin(), segments.end(), [](auto const & lhs, auto const & rhs)
+  {
+    return std::tie(lhs.m_segment, lhs.m_timeSec) < std::tie(rhs.m_segment, rhs.m_timeSec);
+  });
+  segments.erase(std::unique(segments.begin(), segments.end(), [](auto const & lhs, auto const & rhs)
+  {
+    return lhs.m_segment == rhs.m_segment;
+  }), segments.end());
+
+  BuildHull(starter, params, isochrone);
+  return true;
+}
+
+std::string DebugPrint(Isochrone const & isochrone)
+{
+  std::ostringstream out;
+  out << "Isochrone [ segments: " << isochrone.m_segments.size()
+      << ", hull points: " << isochrone.m_hull.size()
+      << ", settled vertices: " << isochrone.m_settledCount << " ]";
+  return out.str();
+}
+}  // namespace routing
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "routing/segment.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/cancellable.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace routing
+{
+class IndexGraphStarter;
+
+struct IsochroneParams
+{
+  // Max weight of the paths from the start, in seconds.
+  double m_maxTimeSec = 15.0 * 60.0;
+  // Ends of the reached segments are thinned out with this step before building the hull.
+  double m_hullCellSizeM = 100.0;
+  // Hull edges are dug while they are |m_hullConcavity| times longer than the distance to
+  // the closest inner point. See m2::ConcaveHull.
+  double m_hullConcavity = 2.0;
+};
+
+struct Isochrone
+{
+  struct ReachedSegment
+  {
+    Segment m_segment;
+    // Weight of the best path from the start to the end of |m_segment|, in seconds.
+    double m_timeSec = 0.0;
+  };
+
+  // Real segments sorted by Segment.
+  std::vector<ReachedSegment> m_segments;
+  // Concave hull around the reached segments in mercator, counterclockwise.
+  std::vector<m2::PointD> m_hull;
+  // Number of vertices settled by the wave, fake ones included.
+  size_t m_settledCount = 0;
+};
+
+/// \brief Runs one-to-all Dijkstra from the start of |starter| over the whole world graph
+/// (cross mwm transitions included) and collects all the segments which may be reached in
+/// |params.m_maxTimeSec|. The finish of |starter| is not used.
+/// \returns false if the wave was cancelled.
+bool BuildIsochrone(IndexGraphStarter & starter, IsochroneParams const & params,
+                    base::Cancellable const & cancellable, Isochrone & isochrone);
+
+std::string DebugPrint(Isochrone const & isochrone);
+}  // namespace routing
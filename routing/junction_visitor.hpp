@@ -39,6 +39,19 @@ public:
       m_lastProgressPercent = progress->GetLastPercent();
   }
 
+  JunctionVisitor(JunctionVisitor && rhs)
+    : m_graph(rhs.m_graph)
+    , m_delegate(rhs.m_delegate)
+    , m_visitCounter(rhs.m_visitCounter)
+    , m_visitPeriod(rhs.m_visitPeriod)
+    , m_progress(std::move(rhs.m_progress))
+    , m_lastProgressPercent(rhs.m_lastProgressPercent)
+  {
+    rhs.m_visitCounter = 0;
+  }
+
+  ~JunctionVisitor() { m_delegate.OnVerticesVisited(m_visitCounter); }
+
   /// @param[in]  p   { Current state, Step context } pair.
   /// @param[in]  to  End vertex (final for forward and start for backward waves).
   template <class StateContextPair> void operator()(StateContextPair const & p, Vertex const & to)
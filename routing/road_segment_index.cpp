@@ -0,0 +1,295 @@
+#include "routing/road_segment_index.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include "coding/byte_stream.hpp"
+#include "coding/files_container.hpp"
+#include "coding/point_coding.hpp"
+
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <tuple>
+
+#include "defines.hpp"
+
+namespace routing
+{
+namespace
+{
+using namespace road_segment_index;
+
+struct Box
+{
+  void Add(m2::PointU const & p)
+  {
+    m_minX = std::min(m_minX, p.x);
+    m_minY = std::min(m_minY, p.y);
+    m_maxX = std::max(m_maxX, p.x);
+    m_maxY = std::max(m_maxY, p.y);
+  }
+
+  void Add(Box const & b)
+  {
+    Add(m2::PointU(b.m_minX, b.m_minY));
+    Add(m2::PointU(b.m_maxX, b.m_maxY));
+  }
+
+  uint32_t m_minX = std::numeric_limits<uint32_t>::max();
+  uint32_t m_minY = std::numeric_limits<uint32_t>::max();
+  uint32_t m_maxX = 0;
+  uint32_t m_maxY = 0;
+};
+
+// Index of (x, y) on the Hilbert curve filling 2^16 x 2^16 grid.
+uint32_t HilbertValue(uint32_t x, uint32_t y)
+{
+  uint32_t constexpr kSide = 1U << 16;
+  uint32_t d = 0;
+  for (uint32_t s = kSide / 2; s > 0; s /= 2)
+  {
+    uint32_t const rx = (x & s) > 0 ? 1 : 0;
+    uint32_t const ry = (y & s) > 0 ? 1 : 0;
+    d += s * s * ((3 * rx) ^ ry);
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = kSide - 1 - x;
+        y = kSide - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return d;
+}
+
+double SquaredDistToRect(m2::PointD const & p, m2::PointD const & minP, m2::PointD const & maxP)
+{
+  double const dx = std::max({minP.x - p.x, 0.0, p.x - maxP.x});
+  double const dy = std::max({minP.y - p.y, 0.0, p.y - maxP.y});
+  return dx * dx + dy * dy;
+}
+}  // namespace
+
+namespace road_segment_index
+{
+std::vector<uint32_t> GetLevelSizes(uint32_t leavesCount, uint32_t nodeSize)
+{
+  CHECK_GREATER(nodeSize, 1, ());
+  std::vector<uint32_t> sizes;
+  if (leavesCount == 0)
+    return sizes;
+
+  sizes.push_back(leavesCount);
+  while (sizes.back() > 1)
+    sizes.push_back((sizes.back() + nodeSize - 1) / nodeSize);
+  return sizes;
+}
+}  // namespace road_segment_index
+
+// RoadSegmentIndexBuilder -------------------------------------------------------------------------
+void RoadSegmentIndexBuilder::Add(uint32_t featureId, uint32_t segmentIdx, VehicleMask mask,
+                                  m2::PointD const & p0, m2::PointD const & p1)
+{
+  CHECK_LESS_OR_EQUAL(segmentIdx, kMaxSegmentIdx, (featureId));
+  CHECK_LESS(mask, 1U << 8, ());
+
+  Leaf leaf;
+  leaf.m_p0 = PointDToPointU(p0, kPointCoordBits);
+  leaf.m_p1 = PointDToPointU(p1, kPointCoordBits);
+  leaf.m_featureId = featureId;
+  leaf.m_segmentAndMask = (segmentIdx << 8) | mask;
+
+  // Hilbert curve on 16 bits grid is enough to keep nearby segments together.
+  uint32_t constexpr kShift = kPointCoordBits - 16;
+  uint64_t const cx = (uint64_t{leaf.m_p0.x} + leaf.m_p1.x) / 2;
+  uint64_t const cy = (uint64_t{leaf.m_p0.y} + leaf.m_p1.y) / 2;
+  leaf.m_hilbert = HilbertValue(static_cast<uint32_t>(cx >> kShift), static_cast<uint32_t>(cy >> kShift));
+
+  m_leaves.push_back(leaf);
+}
+
+void RoadSegmentIndexBuilder::Serialize(Writer & writer)
+{
+  std::sort(m_leaves.begin(), m_leaves.end(), [](Leaf const & lhs, Leaf const & rhs)
+  {
+    return std::tie(lhs.m_hilbert, lhs.m_featureId, lhs.m_segmentAndMask) <
+           std::tie(rhs.m_hilbert, rhs.m_featureId, rhs.m_segmentAndMask);
+  });
+
+  RoadSegmentIndexHeader header;
+  header.m_leavesCount = base::checked_cast<uint32_t>(m_leaves.size());
+  header.Serialize(writer);
+
+  std::vector<Box> boxes;
+  boxes.reserve(m_leaves.size());
+  for (auto const & leaf : m_leaves)
+  {
+    WriteToSink(writer, leaf.m_p0.x);
+    WriteToSink(writer, leaf.m_p0.y);
+    WriteToSink(writer, leaf.m_p1.x);
+    WriteToSink(writer, leaf.m_p1.y);
+    WriteToSink(writer, leaf.m_featureId);
+    WriteToSink(writer, leaf.m_segmentAndMask);
+
+    Box box;
+    box.Add(leaf.m_p0);
+    box.Add(leaf.m_p1);
+    boxes.push_back(box);
+  }
+
+  auto const levelSizes = GetLevelSizes(header.m_leavesCount, header.m_nodeSize);
+  for (size_t level = 1; level < levelSizes.size(); ++level)
+  {
+    std::vector<Box> parents(levelSizes[level]);
+    for (size_t i = 0; i < boxes.size(); ++i)
+      parents[i / header.m_nodeSize].Add(boxes[i]);
+
+    for (auto const & box : parents)
+    {
+      WriteToSink(writer, box.m_minX);
+      WriteToSink(writer, box.m_minY);
+      WriteToSink(writer, box.m_maxX);
+      WriteToSink(writer, box.m_maxY);
+    }
+    boxes.swap(parents);
+  }
+}
+
+// RoadSegmentIndex --------------------------------------------------------------------------------
+RoadSegmentIndex::RoadSegmentIndex(std::unique_ptr<Reader> reader, RoadSegmentIndexHeader const & header)
+  : m_reader(std::move(reader)), m_header(header)
+{
+  m_levelSizes = GetLevelSizes(m_header.m_leavesCount, m_header.m_nodeSize);
+
+  uint64_t offset = sizeof(RoadSegmentIndexHeader);
+  for (size_t level = 0; level < m_levelSizes.size(); ++level)
+  {
+    m_levelOffsets.push_back(offset);
+    offset += uint64_t{m_levelSizes[level]} * (level == 0 ? kLeafSize : kBoxSize);
+  }
+}
+
+// static
+std::unique_ptr<RoadSegmentIndex> RoadSegmentIndex::Load(Reader const & reader)
+{
+  NonOwningReaderSource src(reader);
+  RoadSegmentIndexHeader header;
+  header.Deserialize(src);
+  if (header.m_version != RoadSegmentIndexHeader::kLatestVersion || header.m_nodeSize < 2)
+  {
+    LOG(LWARNING, ("Unknown", ROAD_SEGMENTS_INDEX_FILE_TAG, "section version:", header.m_version));
+    return {};
+  }
+
+  return std::unique_ptr<RoadSegmentIndex>(
+      new RoadSegmentIndex(reader.CreateSubReader(0, reader.Size()), header));
+}
+
+void RoadSegmentIndex::ForEachNearest(m2::PointD const & point, VehicleMask mask, double maxDist,
+                                      ResultFn const & fn) const
+{
+  if (m_levelSizes.empty())
+    return;
+
+  struct Entry
+  {
+    bool operator>(Entry const & rhs) const { return m_squaredDist > rhs.m_squaredDist; }
+
+    double m_squaredDist;
+    size_t m_level;
+    uint32_t m_index;
+    Result m_result;
+  };
+
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  double const maxSquaredDist = maxDist * maxDist;
+  std::vector<uint8_t> buffer;
+
+  // Reads entries [beg, end) of |level| by one read and queues the ones closer than |maxDist|.
+  auto const expand = [&](size_t level, uint32_t beg, uint32_t end)
+  {
+    size_t const entrySize = level == 0 ? kLeafSize : kBoxSize;
+    buffer.resize((end - beg) * entrySize);
+    m_reader->Read(m_levelOffsets[level] + uint64_t{beg} * entrySize, buffer.data(), buffer.size());
+
+    ArrayByteSource src(buffer.data());
+    for (uint32_t i = beg; i < end; ++i)
+    {
+      uint32_t const x0 = ReadPrimitiveFromSource<uint32_t>(src);
+      uint32_t const y0 = ReadPrimitiveFromSource<uint32_t>(src);
+      uint32_t const x1 = ReadPrimitiveFromSource<uint32_t>(src);
+      uint32_t const y1 = ReadPrimitiveFromSource<uint32_t>(src);
+      m2::PointD const p0 = PointUToPointD({x0, y0}, kPointCoordBits);
+      m2::PointD const p1 = PointUToPointD({x1, y1}, kPointCoordBits);
+
+      if (level != 0)
+      {
+        double const dist = SquaredDistToRect(point, p0, p1);
+        if (dist <= maxSquaredDist)
+          queue.push({dist, level, i, {}});
+        continue;
+      }
+
+      uint32_t const featureId = ReadPrimitiveFromSource<uint32_t>(src);
+      uint32_t const segmentAndMask = ReadPrimitiveFromSource<uint32_t>(src);
+      if ((segmentAndMask & mask & 0xFF) == 0)
+        continue;
+
+      Result res;
+      res.m_featureId = featureId;
+      res.m_segmentIdx = segmentAndMask >> 8;
+      res.m_projection = m2::ParametrizedSegment<m2::PointD>(p0, p1).ClosestPointTo(point);
+      res.m_squaredDist = point.SquaredLength(res.m_projection);
+      if (res.m_squaredDist <= maxSquaredDist)
+        queue.push({res.m_squaredDist, level, i, res});
+    }
+  };
+
+  size_t const topLevel = m_levelSizes.size() - 1;
+  expand(topLevel, 0, m_levelSizes[topLevel]);
+
+  // Best-first search: leaves are popped in the order of increasing distance, because
+  // the distance to a box is not greater than the distance to any segment inside.
+  while (!queue.empty())
+  {
+    Entry const entry = queue.top();
+    queue.pop();
+
+    if (entry.m_level == 0)
+    {
+      if (!fn(entry.m_result))
+        return;
+      continue;
+    }
+
+    uint32_t const beg = entry.m_index * m_header.m_nodeSize;
+    uint32_t const end = std::min(beg + m_header.m_nodeSize, m_levelSizes[entry.m_level - 1]);
+    expand(entry.m_level - 1, beg, end);
+  }
+}
+
+std::unique_ptr<RoadSegmentIndex> LoadRoadSegmentIndex(MwmValue const & value)
+{
+  if (!value.m_cont.IsExist(ROAD_SEGMENTS_INDEX_FILE_TAG))
+    return {};
+
+  try
+  {
+    return RoadSegmentIndex::Load(*value.m_cont.GetReader(ROAD_SEGMENTS_INDEX_FILE_TAG).GetPtr());
+  }
+  catch (Reader::Exception const & e)
+  {
+    LOG(LERROR, ("File", value.GetCountryFileName(), "Error while reading",
+                 ROAD_SEGMENTS_INDEX_FILE_TAG, "section.", e.Msg()));
+    return {};
+  }
+}
+}  // namespace routing
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "routing/vehicle_mask.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/write_to_sink.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/assert.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class MwmValue;
+
+namespace routing
+{
+/// Section with all the routable segments of an mwm packed into a static R-tree.
+/// Segments (leaves) are sorted by Hilbert value of their centers, every |m_nodeSize| consecutive
+/// entries of a level are covered by one bounding box of the next level up to the single root box.
+/// Layout: header, leaves (kLeafSize bytes each), boxes of level 1, boxes of level 2, ..., root box.
+/// Coordinates are mercator points quantized with kPointCoordBits.
+struct RoadSegmentIndexHeader
+{
+  template <typename Sink>
+  void Serialize(Sink & sink) const
+  {
+    WriteToSink(sink, m_version);
+    WriteToSink(sink, m_nodeSize);
+    WriteToSink(sink, m_leavesCount);
+  }
+
+  template <typename Source>
+  void Deserialize(Source & src)
+  {
+    m_version = ReadPrimitiveFromSource<uint16_t>(src);
+    m_nodeSize = ReadPrimitiveFromSource<uint16_t>(src);
+    m_leavesCount = ReadPrimitiveFromSource<uint32_t>(src);
+  }
+
+  static uint16_t constexpr kLatestVersion = 0;
+
+  uint16_t m_version = kLatestVersion;
+  uint16_t m_nodeSize = 16;
+  uint32_t m_leavesCount = 0;
+};
+
+static_assert(sizeof(RoadSegmentIndexHeader) == 8, "Wrong header size of road_segments_index section.");
+
+namespace road_segment_index
+{
+// Four coordinates, feature id and (segment index << 8 | vehicle mask).
+size_t constexpr kLeafSize = 6 * sizeof(uint32_t);
+size_t constexpr kBoxSize = 4 * sizeof(uint32_t);
+uint32_t constexpr kMaxSegmentIdx = (1 << 24) - 1;
+
+/// @returns sizes of all the levels from leaves to root.
+std::vector<uint32_t> GetLevelSizes(uint32_t leavesCount, uint32_t nodeSize);
+}  // namespace road_segment_index
+
+class RoadSegmentIndexBuilder
+{
+public:
+  void Add(uint32_t featureId, uint32_t segmentIdx, VehicleMask mask, m2::PointD const & p0,
+           m2::PointD const & p1);
+
+  size_t GetCount() const { return m_leaves.size(); }
+
+  void Serialize(Writer & writer);
+
+private:
+  struct Leaf
+  {
+    m2::PointU m_p0;
+    m2::PointU m_p1;
+    uint32_t m_featureId = 0;
+    uint32_t m_segmentAndMask = 0;
+    uint32_t m_hilbert = 0;
+  };
+
+  std::vector<Leaf> m_leaves;
+};
+
+class RoadSegmentIndex
+{
+public:
+  struct Result
+  {
+    uint32_t m_featureId = 0;
+    uint32_t m_segmentIdx = 0;
+    m2::PointD m_projection;
+    double m_squaredDist = 0.0;
+  };
+
+  /// @returns false from the callback to stop the search.
+  using ResultFn = std::function<bool(Result const &)>;
+
+  /// @returns nullptr if the version of the section is unknown.
+  static std::unique_ptr<RoadSegmentIndex> Load(Reader const & reader);
+
+  uint32_t GetCount() const { return m_header.m_leavesCount; }
+
+  /// Calls |fn| for segments allowed for |mask| in the order of increasing distance to |point|
+  /// until |fn| returns false or all the segments closer than |maxDist| (in mercator) are visited.
+  /// Only the nodes which may contain closer segments are read.
+  void ForEachNearest(m2::PointD const & point, VehicleMask mask, double maxDist,
+                      ResultFn const & fn) const;
+
+private:
+  RoadSegmentIndex(std::unique_ptr<Reader> reader, RoadSegmentIndexHeader const & header);
+
+  std::unique_ptr<Reader> m_reader;
+  RoadSegmentIndexHeader m_header;
+  std::vector<uint32_t> m_levelSizes;
+  std::vector<uint64_t> m_levelOffsets;
+};
+
+/// @returns nullptr if there is no road_segments_index section in the mwm or its version is unknown.
+std::unique_ptr<RoadSegmentIndex> LoadRoadSegmentIndex(MwmValue const & value);
+}  // namespace routing
@@ -7,6 +7,8 @@
 #include "base/cancellable.hpp"
 #include "base/timer.hpp"
 
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 
 namespace routing
@@ -21,6 +23,12 @@ public:
   /// Set routing progress. Waits current progress status from 0 to 100.
   void OnProgress(float progress) const;
   void OnPointCheck(ms::LatLon const & point) const;
+  /// Called by routing algorithms once per search with the number of settled vertices. Several
+  /// routing threads (e.g. absent regions finder) may share one delegate.
+  void OnVerticesVisited(uint64_t count) const
+  {
+    m_visitedVerticesCount.fetch_add(count, std::memory_order_relaxed);
+  }
 
   void SetProgressCallback(ProgressCallback const & progressCallback);
   void SetPointCheckCallback(PointCheckCallback const & pointCallback);
@@ -32,10 +40,14 @@ public:
   void Cancel() { return m_cancellable.Cancel(); }
   bool IsCancelled() const { return m_cancellable.IsCancelled(); }
 
+  uint64_t GetVisitedVerticesCount() const { return m_visitedVerticesCount.load(); }
+  void ResetVisitedVerticesCount() { m_visitedVerticesCount = 0; }
+
 private:
   ProgressCallback m_progressCallback;
   PointCheckCallback m_pointCallback;
 
   base::Cancellable m_cancellable;
+  mutable std::atomic<uint64_t> m_visitedVerticesCount{0};
 };
 } //  namespace routing
@@ -290,6 +290,8 @@ RoutesBuilder::Result
 RoutesBuilder::Processor::operator()(Params const & params)
 {
   InitRouter(params.m_type);
+  m_router->SetCompactRoadIndex(params.m_compactRoadIndex);
+  m_router->SetTimeDependentRouting(params.m_timeDependentRouting);
   SCOPE_GUARD(returnDataSource, [&]() {
     m_dataSourceStorage.PushDataSource(std::move(m_dataSource));
   });
@@ -302,6 +304,7 @@ RoutesBuilder::Processor::operator()(Params const & params)
   CHECK(m_dataSource, ());
 
   double timeSum = 0.0;
+  m_delegate->ResetVisitedVerticesCount();
   for (size_t i = 0; i < params.m_launchesNumber; ++i)
   {
     m_delegate->SetTimeout(params.m_timeoutSeconds);
@@ -319,6 +322,7 @@ RoutesBuilder::Processor::operator()(Params const & params)
   result.m_params.m_checkpoints = params.m_checkpoints;
   result.m_code = resultCode;
   result.m_buildTimeSeconds = timeSum / static_cast<double>(params.m_launchesNumber);
+  result.m_visitedVerticesNumber = m_delegate->GetVisitedVerticesCount() / params.m_launchesNumber;
 
   RoutesBuilder::Route routeResult;
   routeResult.m_distance = route.GetTotalDistanceMeters();
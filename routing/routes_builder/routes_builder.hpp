@@ -62,6 +62,9 @@ public:
     Checkpoints m_checkpoints;
     uint32_t m_timeoutSeconds = RouterDelegate::kNoTimeout;
     uint32_t m_launchesNumber = 1;
+    // Is not dumped, it's a setting of the router for benchmarks.
+    bool m_compactRoadIndex = false;
+    bool m_timeDependentRouting = false;
   };
 
   struct Route
@@ -93,11 +96,17 @@ public:
     Params m_params;
     std::vector<Route> m_routes;
     double m_buildTimeSeconds = 0.0;
+    // Average number of settled vertices per launch. It's not dumped.
+    uint64_t m_visitedVerticesNumber = 0;
   };
 
   Result ProcessTask(Params const & params);
   std::future<Result> ProcessTaskAsync(Params const & params);
 
+  /// Mwms registered in data sources of the builder.
+  NumMwmIds const & GetNumMwmIds() const { return *m_numMwmIds; }
+  storage::CountryInfoGetter const & GetCountryInfoGetter() const { return *m_cig; }
+
 private:
 
   class Processor
@@ -0,0 +1,344 @@
+#include "routing/routes_builder/routing_benchmark_tool/benchmark.hpp"
+
+#include "routing/checkpoints.hpp"
+
+#include "storage/country_info_getter.hpp"
+
+#include "routing_common/num_mwm_id.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+#include "geometry/mercator.hpp"
+#include "geometry/rect2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/math.hpp"
+#include "base/string_utils.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <utility>
+
+#include "std/target_os.hpp"
+
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_MAC)
+#include <sys/resource.h>
+#endif
+
+namespace routing
+{
+namespace routes_builder
+{
+namespace
+{
+// Attempts to find a query with both points in the registered mwms.
+size_t constexpr kMaxGenerationAttempts = 1000;
+
+size_t FindBand(std::vector<DistanceBand> const & bands, ms::LatLon const & start,
+                ms::LatLon const & finish)
+{
+  double const distanceKm = ms::DistanceOnEarth(start, finish) / 1000.0;
+  for (size_t i = 0; i < bands.size(); ++i)
+  {
+    if (bands[i].Contains(distanceKm))
+      return i;
+  }
+  return Query::kNoBand;
+}
+
+std::string BandName(std::vector<DistanceBand> const & bands, size_t bandIdx)
+{
+  if (bandIdx >= bands.size())
+    return "other";
+
+  std::ostringstream out;
+  out << bands[bandIdx].m_minKm << "-" << bands[bandIdx].m_maxKm << "km";
+  return out.str();
+}
+
+double GetMean(std::vector<double> const & values)
+{
+  if (values.empty())
+    return 0.0;
+  return std::accumulate(values.cbegin(), values.cend(), 0.0) / static_cast<double>(values.size());
+}
+}  // namespace
+
+std::vector<DistanceBand> ParseDistanceBands(std::string const & str)
+{
+  std::vector<DistanceBand> bands;
+  for (auto const & token : strings::Tokenize(str, ","))
+  {
+    auto const bounds = strings::Tokenize(token, "-");
+    CHECK_EQUAL(bounds.size(), 2, ("Wrong band:", token));
+
+    DistanceBand band;
+    CHECK(strings::to_double(bounds[0], band.m_minKm), ("Wrong band:", token));
+    CHECK(strings::to_double(bounds[1], band.m_maxKm), ("Wrong band:", token));
+    CHECK_LESS(band.m_minKm, band.m_maxKm, ("Wrong band:", token));
+    bands.push_back(band);
+  }
+  return bands;
+}
+
+std::vector<Query> LoadQueries(std::string const & path, std::vector<DistanceBand> const & bands)
+{
+  std::ifstream input(path);
+  CHECK(input.good(), ("Error during opening:", path));
+
+  std::vector<Query> queries;
+  Query query;
+  while (input >> query.m_start.m_lat >> query.m_start.m_lon >> query.m_finish.m_lat >>
+         query.m_finish.m_lon)
+  {
+    query.m_bandIdx = FindBand(bands, query.m_start, query.m_finish);
+    queries.push_back(query);
+  }
+  return queries;
+}
+
+std::vector<Query> GenerateQueries(RoutesBuilder const & builder,
+                                   std::vector<DistanceBand> const & bands, size_t countPerBand,
+                                   uint32_t seed)
+{
+  auto const & numMwmIds = builder.GetNumMwmIds();
+  auto const & infoGetter = builder.GetCountryInfoGetter();
+
+  // Mwms are chosen proportionally to their areas to get uniform distribution of start points.
+  std::vector<m2::RectD> rects;
+  std::vector<double> areas;
+  numMwmIds.ForEachId([&](NumMwmId id) {
+    rects.push_back(infoGetter.GetLimitRectForLeaf(numMwmIds.GetFile(id).GetName()));
+    areas.push_back(rects.back().SizeX() * rects.back().SizeY());
+  });
+  CHECK(!rects.empty(), ("No mwms are registered."));
+
+  auto const isCovered = [&](m2::PointD const & point) {
+    auto const countryId = infoGetter.GetRegionCountryId(point);
+    return !countryId.empty() && numMwmIds.ContainsFile(platform::CountryFile(countryId));
+  };
+
+  std::mt19937 rng(seed);
+  std::discrete_distribution<size_t> rectDistribution(areas.cbegin(), areas.cend());
+  std::uniform_real_distribution<double> unitDistribution(0.0, 1.0);
+
+  std::vector<Query> queries;
+  for (size_t bandIdx = 0; bandIdx < bands.size(); ++bandIdx)
+  {
+    auto const & band = bands[bandIdx];
+    size_t generated = 0;
+    for (size_t attempt = 0; generated < countPerBand && attempt < countPerBand * kMaxGenerationAttempts;
+         ++attempt)
+    {
+      auto const & rect = rects[rectDistribution(rng)];
+      m2::PointD const start(rect.minX() + unitDistribution(rng) * rect.SizeX(),
+                             rect.minY() + unitDistribution(rng) * rect.SizeY());
+      if (!isCovered(start))
+        continue;
+
+      double const distanceM =
+          1000.0 * (band.m_minKm + unitDistribution(rng) * (band.m_maxKm - band.m_minKm));
+      double const bearing = 2.0 * math::pi * unitDistribution(rng);
+      auto const finish =
+          mercator::GetSmPoint(start, distanceM * std::cos(bearing), distanceM * std::sin(bearing));
+      if (!isCovered(finish))
+        continue;
+
+      Query query;
+      query.m_start = mercator::ToLatLon(start);
+      query.m_finish = mercator::ToLatLon(finish);
+      // Mercator offsets are not exact distances, so the band is checked again.
+      query.m_bandIdx = FindBand(bands, query.m_start, query.m_finish);
+      queries.push_back(query);
+      ++generated;
+    }
+
+    if (generated < countPerBand)
+    {
+      LOG(LWARNING, ("Only", generated, "queries of", countPerBand, "are generated for band",
+                     BandName(bands, bandIdx)));
+    }
+  }
+  return queries;
+}
+
+double GetPercentile(std::vector<double> const & sortedValues, double percent)
+{
+  if (sortedValues.empty())
+    return 0.0;
+
+  CHECK(std::is_sorted(sortedValues.cbegin(), sortedValues.cend()), ());
+  auto const rank = static_cast<size_t>(std::ceil(percent / 100.0 * sortedValues.size()));
+  return sortedValues[std::min(std::max(rank, size_t{1}), sortedValues.size()) - 1];
+}
+
+uint64_t GetPeakRssBytes()
+{
+#if defined(OMIM_OS_LINUX) || defined(OMIM_OS_MAC)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if defined(OMIM_OS_MAC)
+  return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+  // Kilobytes on Linux.
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
+void BandStats::Add(RoutesBuilder::Result const & result)
+{
+  ++m_queriesNumber;
+  ++m_codes[result.m_code];
+  if (!result.IsCodeOK())
+    return;
+
+  m_latenciesMs.push_back(result.m_buildTimeSeconds * 1000.0);
+  m_visitedVertices.push_back(static_cast<double>(result.m_visitedVerticesNumber));
+  if (result.m_buildTimeSeconds > 0.0)
+    m_expansionRates.push_back(m_visitedVertices.back() / m_latenciesMs.back());
+}
+
+std::vector<ModeStats> RunBenchmark(RoutesBuilder & builder, std::vector<Query> const & queries,
+                                    BenchmarkParams const & params)
+{
+  std::vector<ModeStats> allStats;
+  for (auto const type : params.m_types)
+  {
+    ModeStats stats;
+    stats.m_type = type;
+    stats.m_bands.resize(params.m_bands.size() + 1);
+
+    auto const geometryStatsBefore = Geometry::GetTotalCacheStats();
+    base::Timer timer;
+
+    std::vector<std::pair<size_t, std::future<RoutesBuilder::Result>>> tasks;
+    tasks.reserve(queries.size());
+    for (auto const & query : queries)
+    {
+      RoutesBuilder::Params taskParams(type, query.m_start, query.m_finish);
+      taskParams.m_timeoutSeconds = params.m_timeoutSeconds;
+      taskParams.m_launchesNumber = params.m_launchesNumber;
+      taskParams.m_compactRoadIndex = params.m_compactRoadIndex;
+      taskParams.m_timeDependentRouting = params.m_timeDependentRouting;
+      size_t const bandIdx = std::min(query.m_bandIdx, params.m_bands.size());
+      tasks.emplace_back(bandIdx, builder.ProcessTaskAsync(taskParams));
+    }
+
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+      stats.m_bands[tasks[i].first].Add(tasks[i].second.get());
+      if ((i + 1) % 100 == 0 || i + 1 == tasks.size())
+        LOG_FORCE(LINFO, (type, ": built", i + 1, "of", tasks.size(), "routes."));
+    }
+
+    stats.m_wallTimeSeconds = timer.ElapsedSeconds();
+
+    // Road geometry is owned by the world graph which is destroyed at the end of every route
+    // building, so stats of all the routes of the mode are already accumulated.
+    auto const geometryStatsAfter = Geometry::GetTotalCacheStats();
+    stats.m_geometryCacheStats.m_requests =
+        geometryStatsAfter.m_requests - geometryStatsBefore.m_requests;
+    stats.m_geometryCacheStats.m_misses = geometryStatsAfter.m_misses - geometryStatsBefore.m_misses;
+    stats.m_peakRssBytes = GetPeakRssBytes();
+
+    for (auto & bandStats : stats.m_bands)
+    {
+      std::sort(bandStats.m_latenciesMs.begin(), bandStats.m_latenciesMs.end());
+      std::sort(bandStats.m_visitedVertices.begin(), bandStats.m_visitedVertices.end());
+      std::sort(bandStats.m_expansionRates.begin(), bandStats.m_expansionRates.end());
+    }
+
+    allStats.push_back(std::move(stats));
+  }
+  return allStats;
+}
+
+void PrintReport(std::vector<ModeStats> const & stats, BenchmarkParams const & params,
+                 std::ostream & out)
+{
+  out << std::fixed << std::setprecision(1);
+  for (auto const & modeStats : stats)
+  {
+    size_t queriesNumber = 0;
+    for (auto const & bandStats : modeStats.m_bands)
+      queriesNumber += bandStats.m_queriesNumber;
+
+    out << "==== " << DebugPrint(modeStats.m_type) << " ====\n"
+        << "Routes: " << queriesNumber << ", wall time: " << modeStats.m_wallTimeSeconds
+        << " s, throughput: "
+        << (modeStats.m_wallTimeSeconds > 0.0 ? queriesNumber / modeStats.m_wallTimeSeconds : 0.0)
+        << " routes/s\n"
+        << "Geometry cache requests: " << modeStats.m_geometryCacheStats.m_requests
+        << ", hit rate: " << 100.0 * modeStats.m_geometryCacheStats.GetHitRate() << "%\n"
+        << "Peak RSS: " << modeStats.m_peakRssBytes / (1024 * 1024) << " MiB\n";
+
+    for (size_t bandIdx = 0; bandIdx < modeStats.m_bands.size(); ++bandIdx)
+    {
+      auto const & bandStats = modeStats.m_bands[bandIdx];
+      if (bandStats.m_queriesNumber == 0)
+        continue;
+
+      auto const & latencies = bandStats.m_latenciesMs;
+      auto const & visited = bandStats.m_visitedVertices;
+      out << "  Band " << BandName(params.m_bands, bandIdx) << ": " << bandStats.m_queriesNumber
+          << " queries, " << latencies.size() << " found\n"
+          << "    latency ms: mean " << GetMean(latencies) << ", p50 " << GetPercentile(latencies, 50)
+          << ", p90 " << GetPercentile(latencies, 90) << ", p99 " << GetPercentile(latencies, 99)
+          << ", max " << (latencies.empty() ? 0.0 : latencies.back()) << "\n"
+          << "    settled vertices: mean " << GetMean(visited) << ", p50 " << GetPercentile(visited, 50)
+          << ", p90 " << GetPercentile(visited, 90) << ", p99 " << GetPercentile(visited, 99) << "\n"
+          << "    expansion rate (vertices/ms): mean " << GetMean(bandStats.m_expansionRates)
+          << ", p50 " << GetPercentile(bandStats.m_expansionRates, 50) << "\n";
+
+      out << "    codes:";
+      for (auto const & [code, count] : bandStats.m_codes)
+        out << " " << DebugPrint(code) << "=" << count;
+      out << "\n";
+    }
+  }
+}
+
+void WriteCsvReport(std::vector<ModeStats> const & stats, BenchmarkParams const & params,
+                    std::string const & path)
+{
+  std::ofstream out(path);
+  CHECK(out.good(), ("Error during opening:", path));
+
+  out << "vehicle,band,queries,found,latency_mean_ms,latency_p50_ms,latency_p90_ms,latency_p99_ms,"
+         "settled_p50,settled_p90,settled_p99,geometry_cache_hit_rate,peak_rss_mib,"
+         "expansion_rate_p50\n";
+  out << std::fixed << std::setprecision(3);
+  for (auto const & modeStats : stats)
+  {
+    for (size_t bandIdx = 0; bandIdx < modeStats.m_bands.size(); ++bandIdx)
+    {
+      auto const & bandStats = modeStats.m_bands[bandIdx];
+      if (bandStats.m_queriesNumber == 0)
+        continue;
+
+      auto const & latencies = bandStats.m_latenciesMs;
+      auto const & visited = bandStats.m_visitedVertices;
+      out << ToString(modeStats.m_type) << "," << BandName(params.m_bands, bandIdx) << ","
+          << bandStats.m_queriesNumber << "," << latencies.size() << "," << GetMean(latencies)
+          << "," << GetPercentile(latencies, 50) << "," << GetPercentile(latencies, 90) << ","
+          << GetPercentile(latencies, 99) << "," << GetPercentile(visited, 50) << ","
+          << GetPercentile(visited, 90) << "," << GetPercentile(visited, 99) << ","
+          << modeStats.m_geometryCacheStats.GetHitRate() << ","
+          << modeStats.m_peakRssBytes / (1024 * 1024) << ","
+          << GetPercentile(bandStats.m_expansionRates, 50) << "\n";
+    }
+  }
+}
+}  // namespace routes_builder
+}  // namespace routing
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "routing/routes_builder/routes_builder.hpp"
+
+#include "routing/geometry.hpp"
+#include "routing/routing_callbacks.hpp"
+#include "routing/vehicle_mask.hpp"
+
+#include "geometry/latlon.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace routing
+{
+namespace routes_builder
+{
+struct DistanceBand
+{
+  bool Contains(double distanceKm) const { return m_minKm <= distanceKm && distanceKm < m_maxKm; }
+
+  double m_minKm = 0.0;
+  double m_maxKm = 0.0;
+};
+
+struct Query
+{
+  static size_t constexpr kNoBand = std::numeric_limits<size_t>::max();
+
+  ms::LatLon m_start;
+  ms::LatLon m_finish;
+  size_t m_bandIdx = kNoBand;
+};
+
+/// Parses comma separated bands of straight line distances in km: "0-5,5-20,20-100".
+std::vector<DistanceBand> ParseDistanceBands(std::string const & str);
+
+/// Reads queries in routes_builder_tool format, one "start_lat start_lon finish_lat finish_lon"
+/// per line. Band of every query is the first band containing its straight line distance.
+std::vector<Query> LoadQueries(std::string const & path, std::vector<DistanceBand> const & bands);
+
+/// Generates |countPerBand| queries for every band. Start points are uniformly distributed over
+/// the mwms registered in |builder|, finish points are in random directions from them
+/// at random distances of the band. Both points must be covered by the registered mwms.
+std::vector<Query> GenerateQueries(RoutesBuilder const & builder,
+                                   std::vector<DistanceBand> const & bands, size_t countPerBand,
+                                   uint32_t seed);
+
+/// @returns percentile by nearest rank method, |sortedValues| must be sorted.
+double GetPercentile(std::vector<double> const & sortedValues, double percent);
+
+/// @returns peak resident set size of the process in bytes or 0 if it's unknown on the platform.
+uint64_t GetPeakRssBytes();
+
+struct BenchmarkParams
+{
+  std::vector<VehicleType> m_types;
+  std::vector<DistanceBand> m_bands;
+  uint32_t m_timeoutSeconds = RouterDelegate::kNoTimeout;
+  uint32_t m_launchesNumber = 1;
+  bool m_compactRoadIndex = false;
+  bool m_timeDependentRouting = false;
+};
+
+/// Stats of routes of one vehicle type and one distance band.
+struct BandStats
+{
+  void Add(RoutesBuilder::Result const & result);
+
+  size_t m_queriesNumber = 0;
+  // Build times (ms) and settled vertices of the found routes only.
+  std::vector<double> m_latenciesMs;
+  std::vector<double> m_visitedVertices;
+  // Expansion rate is the number of settled vertices per ms of route building.
+  std::vector<double> m_expansionRates;
+  std::map<RouterResultCode, size_t> m_codes;
+};
+
+struct ModeStats
+{
+  VehicleType m_type = VehicleType::Car;
+  // Stats by band index, the last one is for queries out of all the bands.
+  std::vector<BandStats> m_bands;
+  double m_wallTimeSeconds = 0.0;
+  Geometry::CacheStats m_geometryCacheStats;
+  uint64_t m_peakRssBytes = 0;
+};
+
+/// Builds routes for all |queries| for every vehicle type of |params| by |builder| threads.
+/// Vehicle types are processed one by one to separate their cache and memory stats.
+std::vector<ModeStats> RunBenchmark(RoutesBuilder & builder, std::vector<Query> const & queries,
+                                    BenchmarkParams const & params);
+
+void PrintReport(std::vector<ModeStats> const & stats, BenchmarkParams const & params,
+                 std::ostream & out);
+
+/// Writes one line per (vehicle type, band) pair to compare results of different releases.
+void WriteCsvReport(std::vector<ModeStats> const & stats, BenchmarkParams const & params,
+                    std::string const & path);
+}  // namespace routes_builder
+}  // namespace routing
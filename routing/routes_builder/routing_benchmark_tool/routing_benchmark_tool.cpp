@@ -0,0 +1,157 @@
+#include "routing/routes_builder/routing_benchmark_tool/benchmark.hpp"
+
+#include "routing/routes_builder/routes_builder.hpp"
+
+#include "platform/platform.hpp"
+
+#include "base/assert.hpp"
+#include "base/logging.hpp"
+#include "base/string_utils.hpp"
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+DEFINE_string(data_path, "", "Data path with mwms, all of them are loaded once.");
+DEFINE_string(resources_path, "", "Resources path.");
+
+DEFINE_uint64(threads, 0,
+              "The number of threads. std::thread::hardware_concurrency() is used by default.");
+
+DEFINE_string(queries_file, "", "Path to file with queries in routes_builder_tool format: \n\t"
+                                "start_lat start_lon finish_lat finish_lon\n\t"
+                                "...\n"
+                                "If it's empty, queries are generated by --distance_bands.");
+
+DEFINE_string(distance_bands, "0-5,5-20,20-100,100-500",
+              "Comma separated bands of straight line distances (km) between start and finish. "
+              "Queries are generated for every band or loaded queries are grouped by them.");
+DEFINE_uint64(queries_per_band, 1000, "The number of generated queries for every band.");
+DEFINE_uint64(seed, 0, "Seed for queries generation.");
+
+DEFINE_string(vehicle_types, "car,pedestrian,bicycle",
+              "Comma separated vehicle types: car|pedestrian|bicycle|transit.");
+DEFINE_int32(timeout, 60, "Timeout in seconds for each route building. "
+                          "0 means without timeout (default: 1 minute).");
+DEFINE_int32(launches_number, 1, "Number of launches of every route building, the average time "
+                                 "is reported (default: 1).");
+
+DEFINE_bool(compact_road_index, false,
+            "Build compact road index on every mwm graph load to compare expansion rate.");
+DEFINE_bool(time_dependent_routing, false,
+            "Use historical speed profiles of mwms for car routes (unidirectional A*).");
+
+DEFINE_string(csv_path, "", "Path to save the report in csv format to compare releases.");
+DEFINE_bool(verbose, false, "Verbose logging (default: false)");
+
+using namespace routing;
+using namespace routes_builder;
+
+namespace
+{
+VehicleType ConvertVehicleTypeFromString(std::string_view str)
+{
+  if (str == "car")
+    return VehicleType::Car;
+  if (str == "pedestrian")
+    return VehicleType::Pedestrian;
+  if (str == "bicycle")
+    return VehicleType::Bicycle;
+  if (str == "transit")
+    return VehicleType::Transit;
+
+  CHECK(false, ("Unknown vehicle type:", str));
+  UNREACHABLE();
+}
+}  // namespace
+
+int Main(int argc, char ** argv)
+{
+  gflags::SetUsageMessage("This tool replays routing queries on loaded mwms in several threads and "
+                          "reports latency percentiles, settled vertices, expansion rate, "
+                          "geometry cache hit rate and memory for every vehicle type.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  CHECK_GREATER_OR_EQUAL(FLAGS_timeout, 0, ("Timeout should be greater than zero."));
+  CHECK_GREATER_OR_EQUAL(FLAGS_launches_number, 1, ());
+
+  if (!FLAGS_data_path.empty())
+    GetPlatform().SetWritableDirForTests(FLAGS_data_path);
+
+  if (!FLAGS_resources_path.empty())
+    GetPlatform().SetResourceDir(FLAGS_resources_path);
+
+  BenchmarkParams params;
+  for (auto const & type : strings::Tokenize(FLAGS_vehicle_types, ","))
+    params.m_types.push_back(ConvertVehicleTypeFromString(type));
+  CHECK(!params.m_types.empty(), ("--vehicle_types is empty."));
+
+  params.m_bands = ParseDistanceBands(FLAGS_distance_bands);
+  params.m_timeoutSeconds =
+      FLAGS_timeout == 0 ? RouterDelegate::kNoTimeout : static_cast<uint32_t>(FLAGS_timeout);
+  params.m_launchesNumber = static_cast<uint32_t>(FLAGS_launches_number);
+  params.m_compactRoadIndex = FLAGS_compact_road_index;
+  params.m_timeDependentRouting = FLAGS_time_dependent_routing;
+
+  auto threadsNumber = FLAGS_threads;
+  if (threadsNumber == 0)
+  {
+    auto const hardwareConcurrency = std::thread::hardware_concurrency();
+    threadsNumber = hardwareConcurrency > 0 ? hardwareConcurrency : 2;
+  }
+
+  base::ScopedLogLevelChanger changer(FLAGS_verbose ? base::LogLevel::LINFO : base::LogLevel::LERROR);
+
+  RoutesBuilder builder(threadsNumber);
+  LOG_FORCE(LINFO, ("Mwms are loaded, peak RSS:", GetPeakRssBytes() / (1024 * 1024), "MiB."));
+
+  std::vector<Query> queries;
+  if (!FLAGS_queries_file.empty())
+  {
+    queries = LoadQueries(FLAGS_queries_file, params.m_bands);
+  }
+  else
+  {
+    CHECK(!params.m_bands.empty(), ("--distance_bands is required for queries generation."));
+    queries = GenerateQueries(builder, params.m_bands, FLAGS_queries_per_band,
+                              static_cast<uint32_t>(FLAGS_seed));
+  }
+  CHECK(!queries.empty(), ("No queries."));
+
+  LOG_FORCE(LINFO, ("Queries:", queries.size(), ", threads:", threadsNumber));
+
+  auto const stats = RunBenchmark(builder, queries, params);
+  PrintReport(stats, params, std::cout);
+
+  if (!FLAGS_csv_path.empty())
+    WriteCsvReport(stats, params, FLAGS_csv_path);
+
+  return 0;
+}
+
+int main(int argc, char ** argv)
+{
+  try
+  {
+    Main(argc, argv);
+  }
+  catch (RootException const & e)
+  {
+    LOG(LERROR, ("Core exception:", e.Msg()));
+  }
+  catch (std::exception const & e)
+  {
+    LOG(LERROR, ("Std exception:", e.what()));
+  }
+  catch (...)
+  {
+    LOG(LERROR, ("Unknown exception."));
+  }
+
+  return 0;
+}
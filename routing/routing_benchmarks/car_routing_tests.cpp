@@ -3,6 +3,8 @@
 #include "routing/routing_benchmarks/helpers.hpp"
 
 #include "routing/car_directions.hpp"
+#include "routing/index_router.hpp"
+#include "routing/isochrone.hpp"
 #include "routing/road_graph.hpp"
 
 #include "routing_common/car_model.hpp"
@@ -10,9 +12,13 @@
 #include "geometry/latlon.hpp"
 #include "geometry/mercator.hpp"
 
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -37,6 +43,70 @@ public:
       TestRouter(*router, startMerc, finalMerc, routeFoundByAstarBidirectional);
   }
 
+  void TestCarIsochrone(ms::LatLon const & start, double maxTimeSec, size_t reiterations)
+  {
+    auto router = CreateRouter("test-isochrone");
+    auto & indexRouter = dynamic_cast<routing::IndexRouter &>(*router);
+
+    routing::IsochroneParams params;
+    params.m_maxTimeSec = maxTimeSec;
+
+    size_t settledCount = 0;
+    base::Timer timer;
+    for (size_t i = 0; i < reiterations; ++i)
+    {
+      routing::RouterDelegate delegate;
+      routing::Isochrone isochrone;
+      TEST_EQUAL(indexRouter.CalculateIsochrone(mercator::FromLatLon(start), params, delegate, isochrone),
+                 routing::RouterResultCode::NoError, ());
+      TEST(!isochrone.m_segments.empty(), ());
+      TEST(!isochrone.m_hull.empty(), ());
+      settledCount += isochrone.m_settledCount;
+    }
+
+    double const elapsedSec = timer.ElapsedSeconds();
+    LOG(LINFO, ("Isochrones:", reiterations, "settled vertices:", settledCount, "elapsed, seconds:",
+                elapsedSec, "settled per second:", settledCount / elapsedSec));
+  }
+
+  void TestCarAlternatives(ms::LatLon const & start, ms::LatLon const & final, size_t reiterations)
+  {
+    auto router = CreateRouter("test-alternatives");
+    auto & indexRouter = dynamic_cast<routing::IndexRouter &>(*router);
+
+    m2::PointD const startMerc = mercator::FromLatLon(start);
+    m2::PointD const finalMerc = mercator::FromLatLon(final);
+
+    base::Timer timer;
+    for (size_t i = 0; i < reiterations; ++i)
+    {
+      routing::RouterDelegate delegate;
+      routing::Route route("", 0 /* route id */);
+      TEST_EQUAL(indexRouter.CalculateRoute(routing::Checkpoints(startMerc, finalMerc), m2::PointD::Zero(),
+                                            false /* adjust */, delegate, route),
+                 routing::RouterResultCode::NoError, ());
+    }
+    double const singleSec = timer.ElapsedSeconds();
+
+    routing::astar::AlternativesParams params;
+    size_t routesCount = 0;
+    timer.Reset();
+    for (size_t i = 0; i < reiterations; ++i)
+    {
+      routing::RouterDelegate delegate;
+      std::vector<std::unique_ptr<routing::Route>> routes;
+      TEST_EQUAL(indexRouter.CalculateAlternativeRoutes(startMerc, m2::PointD::Zero(), finalMerc, params,
+                                                        delegate, routes),
+                 routing::RouterResultCode::NoError, ());
+      TEST(!routes.empty(), ());
+      routesCount += routes.size();
+    }
+    double const alternativesSec = timer.ElapsedSeconds();
+
+    LOG(LINFO, ("Single routes:", reiterations, "elapsed, seconds:", singleSec, "alternatives:", routesCount,
+                "elapsed, seconds:", alternativesSec, "ratio:", alternativesSec / singleSec));
+  }
+
 protected:
   std::unique_ptr<routing::VehicleModelFactoryInterface> CreateModelFactory() override
   {
@@ -64,4 +134,16 @@ UNIT_CLASS_TEST(CarTest, InAirport)
 {
   TestCarRouter(ms::LatLon(55.97285, 37.41275), ms::LatLon(55.96396, 37.41922), 30);
 }
+
+// Benchmark of one-to-all wave: all the segments reachable in 10 minutes from a city center.
+UNIT_CLASS_TEST(CarTest, Isochrone)
+{
+  TestCarIsochrone(ms::LatLon(55.75785, 37.58267), 10 * 60 /* maxTimeSec */, 5);
+}
+
+// Benchmark of alternatives search compared to the single route search.
+UNIT_CLASS_TEST(CarTest, Alternatives)
+{
+  TestCarAlternatives(ms::LatLon(55.75785, 37.58267), ms::LatLon(55.79453, 37.68442), 5);
+}
 }  // namespace
@@ -152,4 +152,57 @@ UNIT_TEST(AdjustRouteOutOfLimit)
   TEST_EQUAL(code, Algorithm::Result::NoPath, ());
   TEST(result.m_path.empty(), ());
 }
+
+UNIT_TEST(AStarAlgorithm_AlternativePaths)
+{
+  UndirectedGraph graph;
+
+  // The best path: 0 - 1 - 2 - 9, weight 30.
+  graph.AddEdge(0, 1, 10);
+  graph.AddEdge(1, 2, 10);
+  graph.AddEdge(2, 9, 10);
+  // Disjoint alternative: 0 - 3 - 4 - 9, weight 33.
+  graph.AddEdge(0, 3, 11);
+  graph.AddEdge(3, 4, 11);
+  graph.AddEdge(4, 9, 11);
+  // Short detour without a plateau: 1 - 5 - 2, not locally optimal.
+  graph.AddEdge(1, 5, 5.5);
+  graph.AddEdge(5, 2, 5);
+  // Detour with a plateau 8 - 10 sharing 0 - 1 - 2 with the best path, weight 30.5.
+  graph.AddEdge(2, 8, 1);
+  graph.AddEdge(8, 10, 8);
+  graph.AddEdge(10, 9, 1.5);
+  // Too long path.
+  graph.AddEdge(0, 6, 25);
+  graph.AddEdge(6, 9, 25);
+
+  Algorithm algo;
+  Algorithm::ParamsForTests<> params(graph, 0u /* startVertex */, 9u /* finishVertex */);
+
+  astar::AlternativesParams altParams;
+  vector<RoutingResult<unsigned /* Vertex */, double /* Weight */>> results;
+  TEST_EQUAL(algo.FindAlternativePathsBidirectional(params, altParams, results), Algorithm::Result::OK, ());
+  TEST_EQUAL(results.size(), 3, ());
+  TEST_EQUAL(results[0].m_path, vector<unsigned>({0, 1, 2, 9}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[0].m_distance, 30.0, ());
+  TEST_EQUAL(results[1].m_path, vector<unsigned>({0, 1, 2, 8, 10, 9}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[1].m_distance, 30.5, ());
+  TEST_EQUAL(results[2].m_path, vector<unsigned>({0, 3, 4, 9}), ());
+  TEST_ALMOST_EQUAL_ULPS(results[2].m_distance, 33.0, ());
+
+  // The detour shares 20 of 30 with the best path.
+  altParams.m_maxSharing = 0.6;
+  TEST_EQUAL(algo.FindAlternativePathsBidirectional(params, altParams, results), Algorithm::Result::OK, ());
+  TEST_EQUAL(results.size(), 2, ());
+  TEST_EQUAL(results[1].m_path, vector<unsigned>({0, 3, 4, 9}), ());
+
+  altParams.m_maxStretch = 0.05;
+  TEST_EQUAL(algo.FindAlternativePathsBidirectional(params, altParams, results), Algorithm::Result::OK, ());
+  TEST_EQUAL(results.size(), 1, ());
+
+  // The best path is the same as the one of FindPathBidirectional().
+  RoutingResult<unsigned /* Vertex */, double /* Weight */> best;
+  TEST_EQUAL(algo.FindPathBidirectional(params, best), Algorithm::Result::OK, ());
+  TEST_EQUAL(best.m_path, results[0].m_path, ());
+}
 }  // namespace astar_algorithm_test
@@ -0,0 +1,130 @@
+#include "testing/testing.hpp"
+
+#include "routing/compact_road_index.hpp"
+#include "routing/joint.hpp"
+#include "routing/joint_index.hpp"
+#include "routing/road_index.hpp"
+#include "routing/road_point.hpp"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace compact_road_index_test
+{
+using namespace routing;
+using namespace std;
+
+Joint MakeJoint(vector<RoadPoint> const & points)
+{
+  Joint joint;
+  for (auto const & point : points)
+    joint.AddPoint(point);
+  return joint;
+}
+
+void TestEqual(RoadIndex const & roadIndex, CompactRoadIndex const & compactIndex,
+               uint32_t maxFeatureId, uint32_t maxPointId)
+{
+  for (uint32_t featureId = 0; featureId <= maxFeatureId; ++featureId)
+  {
+    TEST_EQUAL(roadIndex.IsRoad(featureId), compactIndex.IsRoad(featureId), (featureId));
+    for (uint32_t pointId = 0; pointId <= maxPointId; ++pointId)
+    {
+      RoadPoint const rp(featureId, pointId);
+      TEST_EQUAL(roadIndex.GetJointId(rp), compactIndex.GetJointId(rp), (rp));
+
+      if (!roadIndex.IsRoad(featureId))
+        continue;
+
+      uint32_t const pointsNumber = maxPointId + 1;
+      for (bool const forward : {true, false})
+      {
+        TEST_EQUAL(roadIndex.GetRoad(featureId).FindNeighbor(pointId, forward, pointsNumber),
+                   compactIndex.FindNeighbor(featureId, pointId, forward, pointsNumber),
+                   (rp, forward));
+      }
+    }
+  }
+}
+
+//       R0 (f 10)      R1 (f 5)       R2 (f 1)
+//   J0 *--------* J1 *---------* J2 *--------* J3
+//
+//                      R3 (f 7)
+//                   J4 *--------* J5
+UNIT_TEST(CompactRoadIndex_Smoke)
+{
+  vector<Joint> joints;
+  joints.emplace_back(MakeJoint({{10, 0}}));         // J0
+  joints.emplace_back(MakeJoint({{10, 3}, {5, 0}}));  // J1
+  joints.emplace_back(MakeJoint({{5, 2}, {1, 0}}));   // J2
+  joints.emplace_back(MakeJoint({{1, 1}}));          // J3
+  joints.emplace_back(MakeJoint({{7, 0}}));          // J4
+  joints.emplace_back(MakeJoint({{7, 4}}));          // J5
+
+  RoadIndex roadIndex;
+  roadIndex.Import(joints);
+  JointIndex jointIndex;
+  jointIndex.Build(roadIndex, static_cast<uint32_t>(joints.size()));
+
+  CompactRoadIndex const compactIndex(roadIndex, jointIndex);
+  TEST_EQUAL(compactIndex.GetNumRoads(), 4, ());
+
+  // BFS starts from the least feature id and goes along the connected roads first.
+  TEST_EQUAL(compactIndex.GetRoadNumber(1), 0, ());
+  TEST_EQUAL(compactIndex.GetRoadNumber(5), 1, ());
+  TEST_EQUAL(compactIndex.GetRoadNumber(10), 2, ());
+  TEST_EQUAL(compactIndex.GetRoadNumber(7), 3, ());
+  TEST_EQUAL(compactIndex.GetRoadNumber(2), CompactRoadIndex::kNoRoad, ());
+  TEST_EQUAL(compactIndex.GetRoadNumber(100), CompactRoadIndex::kNoRoad, ());
+
+  TEST_EQUAL(compactIndex.GetJointId({10, 3}), 1, ());
+  TEST_EQUAL(compactIndex.GetJointId({10, 2}), Joint::kInvalidId, ());
+  TEST_EQUAL(compactIndex.GetJointId({10, 4}), Joint::kInvalidId, ());
+  TEST_EQUAL(compactIndex.GetJointId({7, 4}), 5, ());
+
+  TestEqual(roadIndex, compactIndex, 12 /* maxFeatureId */, 6 /* maxPointId */);
+}
+
+UNIT_TEST(CompactRoadIndex_Random)
+{
+  uint32_t constexpr kFeaturesNumber = 200;
+  uint32_t constexpr kPointsNumber = 10;
+
+  mt19937 rnd(42);
+  uniform_int_distribution<uint32_t> featureDist(0, kFeaturesNumber - 1);
+  uniform_int_distribution<uint32_t> pointDist(0, kPointsNumber - 1);
+  uniform_int_distribution<uint32_t> sizeDist(1, 4);
+
+  // Every road point is used by one joint at most.
+  vector<vector<bool>> used(kFeaturesNumber, vector<bool>(kPointsNumber, false));
+  vector<Joint> joints;
+  for (size_t i = 0; i < 300; ++i)
+  {
+    Joint joint;
+    uint32_t const size = sizeDist(rnd);
+    for (uint32_t j = 0; j < size; ++j)
+    {
+      RoadPoint const rp(featureDist(rnd), pointDist(rnd));
+      if (used[rp.GetFeatureId()][rp.GetPointId()])
+        continue;
+
+      used[rp.GetFeatureId()][rp.GetPointId()] = true;
+      joint.AddPoint(rp);
+    }
+
+    if (joint.GetSize() != 0)
+      joints.push_back(joint);
+  }
+
+  RoadIndex roadIndex;
+  roadIndex.Import(joints);
+  JointIndex jointIndex;
+  jointIndex.Build(roadIndex, static_cast<uint32_t>(joints.size()));
+
+  CompactRoadIndex const compactIndex(roadIndex, jointIndex);
+  TEST_EQUAL(compactIndex.GetNumRoads(), roadIndex.GetSize(), ());
+  TestEqual(roadIndex, compactIndex, kFeaturesNumber, kPointsNumber);
+}
+}  // namespace compact_road_index_test
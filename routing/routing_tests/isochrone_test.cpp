@@ -0,0 +1,114 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/fake_ending.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/isochrone.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include "base/cancellable.hpp"
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace isochrone_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+//       1
+//       |
+//  0 ---+--- 0
+//       |
+//       1
+unique_ptr<WorldGraph> BuildCrossGraph()
+{
+  auto loader = make_unique<TestGeometryLoader>();
+  loader->AddRoad(0 /* featureId */, false /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{-0.002, 0.0}, {-0.001, 0.0}, {0.0, 0.0}, {0.001, 0.0}, {0.002, 0.0}}));
+  loader->AddRoad(1 /* featureId */, false /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, -0.002}, {0.0, -0.001}, {0.0, 0.0}, {0.0, 0.001}, {0.0, 0.002}}));
+
+  traffic::TrafficCache const trafficCache;
+  return BuildWorldGraph(move(loader), CreateEstimatorForCar(trafficCache), {MakeJoint({{0, 2}, {1, 2}})});
+}
+
+map<Segment, double> ToMap(Isochrone const & isochrone)
+{
+  map<Segment, double> result;
+  for (auto const & reached : isochrone.m_segments)
+    TEST(result.emplace(reached.m_segment, reached.m_timeSec).second, (reached.m_segment));
+  return result;
+}
+
+UNIT_TEST(Isochrone_CrossGraph)
+{
+  auto graph = BuildCrossGraph();
+  auto starter = MakeStarter(MakeFakeEnding(0 /* featureId */, 0 /* segmentIdx */, m2::PointD(-0.0015, 0.0), *graph),
+                             FakeEnding{} /* finish */, *graph);
+  base::Cancellable const cancellable;
+
+  IsochroneParams params;
+  params.m_maxTimeSec = numeric_limits<double>::max();
+  params.m_hullCellSizeM = 1.0;
+
+  Isochrone full;
+  TEST(BuildIsochrone(*starter, params, cancellable, full), ());
+  auto const fullTimes = ToMap(full);
+
+  // Both directions of all the segments of the two-way roads.
+  TEST_EQUAL(fullTimes.size(), 16, ());
+  double maxTime = 0.0;
+  for (auto const & [segment, time] : fullTimes)
+  {
+    TEST_GREATER(time, 0.0, (segment));
+    maxTime = max(maxTime, time);
+  }
+
+  TEST_GREATER_OR_EQUAL(full.m_hull.size(), 4, ());
+  TEST_GREATER_OR_EQUAL(full.m_settledCount, full.m_segments.size(), ());
+
+  // Bounded wave finds exactly the segments which are reached in time with the same times.
+  params.m_maxTimeSec = maxTime / 2.0;
+  Isochrone bounded;
+  TEST(BuildIsochrone(*starter, params, cancellable, bounded), ());
+  auto const boundedTimes = ToMap(bounded);
+
+  TEST_LESS(boundedTimes.size(), fullTimes.size(), ());
+  for (auto const & [segment, time] : fullTimes)
+  {
+    auto const it = boundedTimes.find(segment);
+    if (time <= params.m_maxTimeSec)
+    {
+      TEST(it != boundedTimes.cend(), (segment, time));
+      TEST(base::AlmostEqualAbs(it->second, time, 1e-6), (segment, it->second, time));
+    }
+    else
+    {
+      TEST(it == boundedTimes.cend(), (segment, time));
+    }
+  }
+}
+
+UNIT_TEST(Isochrone_Cancelled)
+{
+  auto graph = BuildCrossGraph();
+  auto starter = MakeStarter(MakeFakeEnding(0 /* featureId */, 0 /* segmentIdx */, m2::PointD(-0.0015, 0.0), *graph),
+                             FakeEnding{} /* finish */, *graph);
+
+  base::Cancellable cancellable;
+  cancellable.Cancel();
+
+  Isochrone isochrone;
+  TEST(!BuildIsochrone(*starter, IsochroneParams(), cancellable, isochrone), ());
+}
+}  // namespace isochrone_test
@@ -0,0 +1,134 @@
+#include "testing/testing.hpp"
+
+#include "routing/road_segment_index.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "geometry/parametrized_segment.hpp"
+
+#include "base/math.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace road_segment_index_test
+{
+using namespace routing;
+using namespace std;
+
+struct Segment
+{
+  uint32_t m_featureId;
+  uint32_t m_segmentIdx;
+  VehicleMask m_mask;
+  m2::PointD m_p0;
+  m2::PointD m_p1;
+};
+
+vector<Segment> MakeSegments(uint32_t featuresCount)
+{
+  mt19937 rng(42);
+  uniform_real_distribution<double> coord(-10.0, 10.0);
+  uniform_real_distribution<double> step(-0.05, 0.05);
+
+  vector<Segment> segments;
+  for (uint32_t fid = 0; fid < featuresCount; ++fid)
+  {
+    VehicleMask const mask = fid % 3 == 0 ? kPedestrianMask : kCarMask | kBicycleMask;
+    m2::PointD p(coord(rng), coord(rng));
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+      m2::PointD const next(p.x + step(rng), p.y + step(rng));
+      segments.push_back({fid, i, mask, p, next});
+      p = next;
+    }
+  }
+  return segments;
+}
+
+unique_ptr<RoadSegmentIndex> Build(vector<Segment> const & segments, vector<uint8_t> & buffer)
+{
+  RoadSegmentIndexBuilder builder;
+  for (auto const & s : segments)
+    builder.Add(s.m_featureId, s.m_segmentIdx, s.m_mask, s.m_p0, s.m_p1);
+  TEST_EQUAL(builder.GetCount(), segments.size(), ());
+
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    builder.Serialize(writer);
+  }
+
+  MemReader reader(buffer.data(), buffer.size());
+  auto index = RoadSegmentIndex::Load(reader);
+  TEST(index, ());
+  TEST_EQUAL(index->GetCount(), segments.size(), ());
+  return index;
+}
+
+UNIT_TEST(RoadSegmentIndex_LevelSizes)
+{
+  TEST_EQUAL(road_segment_index::GetLevelSizes(0, 16), vector<uint32_t>(), ());
+  TEST_EQUAL(road_segment_index::GetLevelSizes(1, 16), vector<uint32_t>({1}), ());
+  TEST_EQUAL(road_segment_index::GetLevelSizes(16, 16), vector<uint32_t>({16, 1}), ());
+  TEST_EQUAL(road_segment_index::GetLevelSizes(300, 16), vector<uint32_t>({300, 19, 2, 1}), ());
+}
+
+UNIT_TEST(RoadSegmentIndex_Empty)
+{
+  vector<uint8_t> buffer;
+  auto const index = Build({}, buffer);
+  size_t count = 0;
+  index->ForEachNearest({0.0, 0.0}, kAllVehiclesMask, 100.0, [&](RoadSegmentIndex::Result const &) {
+    ++count;
+    return true;
+  });
+  TEST_EQUAL(count, 0, ());
+}
+
+UNIT_TEST(RoadSegmentIndex_NearestAsBruteForce)
+{
+  auto const segments = MakeSegments(1000 /* featuresCount */);
+  vector<uint8_t> buffer;
+  auto const index = Build(segments, buffer);
+
+  double constexpr kMaxDist = 1.0;
+  size_t constexpr kLimit = 20;
+  for (auto const mask : {kCarMask, kPedestrianMask})
+  {
+    for (m2::PointD const & point : {m2::PointD(0.0, 0.0), m2::PointD(3.3, -7.1), m2::PointD(-9.9, 9.9)})
+    {
+      vector<double> expected;
+      for (auto const & s : segments)
+      {
+        if ((s.m_mask & mask) == 0)
+          continue;
+        double const d = m2::ParametrizedSegment<m2::PointD>(s.m_p0, s.m_p1).SquaredDistanceToPoint(point);
+        if (d <= kMaxDist * kMaxDist)
+          expected.push_back(d);
+      }
+      sort(expected.begin(), expected.end());
+      if (expected.size() > kLimit)
+        expected.resize(kLimit);
+
+      vector<double> actual;
+      index->ForEachNearest(point, mask, kMaxDist, [&](RoadSegmentIndex::Result const & res) {
+        auto const & s = *find_if(segments.cbegin(), segments.cend(), [&](Segment const & s) {
+          return s.m_featureId == res.m_featureId && s.m_segmentIdx == res.m_segmentIdx;
+        });
+        TEST_NOT_EQUAL(s.m_mask & mask, 0, ());
+        actual.push_back(res.m_squaredDist);
+        return actual.size() < kLimit;
+      });
+
+      // Coordinates are quantized in the section.
+      TEST_EQUAL(actual.size(), expected.size(), (point, mask));
+      TEST(is_sorted(actual.cbegin(), actual.cend()), ());
+      for (size_t i = 0; i < actual.size(); ++i)
+        TEST(base::AlmostEqualAbs(sqrt(actual[i]), sqrt(expected[i]), 1e-5), (i, actual[i], expected[i]));
+    }
+  }
+}
+}  // namespace road_segment_index_test
@@ -0,0 +1,298 @@
+#include "testing/testing.hpp"
+
+#include "routing/routing_tests/index_graph_tools.hpp"
+
+#include "routing/base/astar_algorithm.hpp"
+#include "routing/fake_ending.hpp"
+#include "routing/geometry.hpp"
+#include "routing/index_graph_starter.hpp"
+#include "routing/index_router.hpp"
+#include "routing/joint_segment.hpp"
+#include "routing/speed_profiles.hpp"
+#include "routing/speed_profiles_serialization.hpp"
+
+#include "traffic/traffic_cache.hpp"
+
+#include "indexer/classificator_loader.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/writer.hpp"
+
+#include "base/math.hpp"
+#include "base/scope_guard.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace speed_profiles_test
+{
+using namespace routing;
+using namespace routing_test;
+using namespace std;
+
+// 1 January 2023 00:00 UTC, Sunday.
+time_t constexpr kSundayUtc = 1672531200;
+
+// Seconds since the week start.
+uint64_t MakeWeekTime(int day, int hour, int min)
+{
+  return static_cast<uint64_t>(((day * 24 + hour) * 60 + min) * 60);
+}
+
+SpeedProfiles::Profile MakeProfile(uint8_t value, size_t bucket, uint8_t bucketValue)
+{
+  SpeedProfiles::Profile profile;
+  profile.fill(value);
+  profile[bucket] = bucketValue;
+  return profile;
+}
+
+UNIT_TEST(SpeedProfiles_Bucket)
+{
+  TEST_EQUAL(SpeedProfiles::GetBucket(MakeWeekTime(0 /* day */, 0 /* hour */, 0 /* min */)), 0, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(MakeWeekTime(0, 8, 20)), 33, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(MakeWeekTime(1, 0, 14)), SpeedProfiles::kBucketsPerDay, ());
+  TEST_EQUAL(SpeedProfiles::GetBucket(MakeWeekTime(6, 23, 59)), SpeedProfiles::kBucketsCount - 1, ());
+  // The next Sunday.
+  TEST_EQUAL(SpeedProfiles::GetBucket(MakeWeekTime(7, 0, 30)), 2, ());
+}
+
+UNIT_TEST(SpeedProfiles_WeekTime)
+{
+  SpeedProfiles profiles;
+  TEST_EQUAL(profiles.GetWeekTime(kSundayUtc), 0, ());
+  TEST_EQUAL(profiles.GetWeekTime(kSundayUtc + 3 * 24 * 3600 + 5), MakeWeekTime(3, 0, 0) + 5, ());
+  TEST_EQUAL(profiles.GetWeekTime(kSundayUtc + 7 * 24 * 3600), 0, ());
+
+  profiles.SetUtcOffsetMinutes(180);
+  TEST_EQUAL(profiles.GetWeekTime(kSundayUtc), MakeWeekTime(0, 3, 0), ());
+
+  profiles.SetUtcOffsetMinutes(-60);
+  TEST_EQUAL(profiles.GetWeekTime(kSundayUtc), MakeWeekTime(6, 23, 0), ());
+  TEST_EQUAL(profiles.GetWeekTime(0), MakeWeekTime(3, 23, 0), ());
+}
+
+UNIT_TEST(SpeedProfiles_Quantize)
+{
+  TEST_EQUAL(SpeedProfiles::Quantize(0.0), SpeedProfiles::kNoData, ());
+  TEST_EQUAL(SpeedProfiles::Quantize(0.001), SpeedProfiles::kQuantStep, ());
+  TEST_EQUAL(SpeedProfiles::Quantize(0.52), 50, ());
+  TEST_EQUAL(SpeedProfiles::Quantize(0.53), 55, ());
+  TEST_EQUAL(SpeedProfiles::Quantize(1.0), SpeedProfiles::kFreeFlow, ());
+  TEST_EQUAL(SpeedProfiles::Quantize(1.7), SpeedProfiles::kFreeFlow, ());
+}
+
+UNIT_TEST(SpeedProfiles_SharingAndLookup)
+{
+  size_t const morningBucket = SpeedProfiles::GetBucket(MakeWeekTime(1, 8, 0));
+  auto const jam = MakeProfile(SpeedProfiles::kFreeFlow, morningBucket, 40);
+  auto const noData = MakeProfile(SpeedProfiles::kNoData, morningBucket, 80);
+
+  SpeedProfilesBuilder builder;
+  builder.Add(10 /* featureId */, 2 /* segmentIdx */, true /* forward */, jam);
+  builder.Add(10, SpeedProfiles::kAllSegments, true, noData);
+  builder.Add(5, SpeedProfiles::kAllSegments, false, jam);
+  builder.Add(7, 0, true, jam);
+  // Duplicates are ignored, the first profile wins.
+  builder.Add(7, 0, true, noData);
+  TEST_EQUAL(builder.GetProfilesCount(), 2, ());
+
+  auto const profiles = builder.Build();
+  TEST_EQUAL(profiles.GetProfiles().size(), 2, ());
+  TEST_EQUAL(profiles.GetEntries().size(), 4, ());
+
+  uint64_t const morning = MakeWeekTime(1, 8, 5);
+  uint64_t const evening = MakeWeekTime(1, 20, 0);
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(10, 2, true, morning), 0.4, 1e-9), ());
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(10, 2, true, evening), 1.0, 1e-9), ());
+  // Feature-wide profile.
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(10, 3, true, morning), 0.8, 1e-9), ());
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(10, 3, true, evening), 1.0, 1e-9), ());
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(5, 100, false, morning), 0.4, 1e-9), ());
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(7, 0, true, morning), 0.4, 1e-9), ());
+  // No profiles.
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(10, 2, false, morning), 1.0, 1e-9), ());
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(5, 0, true, morning), 1.0, 1e-9), ());
+  TEST(base::AlmostEqualAbs(profiles.GetSpeedFactor(6, 0, true, morning), 1.0, 1e-9), ());
+}
+
+UNIT_TEST(SpeedProfiles_Serialization)
+{
+  SpeedProfilesBuilder builder;
+  for (uint32_t featureId = 0; featureId < 1000; featureId += 3)
+  {
+    auto const profile = MakeProfile(SpeedProfiles::kFreeFlow, featureId % SpeedProfiles::kBucketsCount,
+                                     static_cast<uint8_t>(5 * (featureId % 20)));
+    builder.Add(featureId, featureId % 4 == 0 ? SpeedProfiles::kAllSegments : featureId % 7,
+                featureId % 2 == 0, profile);
+  }
+  auto profiles = builder.Build();
+  profiles.SetUtcOffsetMinutes(-210);
+
+  vector<uint8_t> buffer;
+  {
+    MemWriter<vector<uint8_t>> writer(buffer);
+    SpeedProfilesSerializer::Serialize(writer, profiles);
+  }
+
+  // Profiles take almost all the space.
+  TEST_LESS(buffer.size(), profiles.GetProfiles().size() * SpeedProfiles::kBucketsCount +
+                               profiles.GetEntries().size() * 4 + 16, ());
+
+  SpeedProfiles deserialized;
+  MemReader reader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> src(reader);
+  TEST(SpeedProfilesSerializer::Deserialize(src, deserialized), ());
+
+  TEST_EQUAL(profiles, deserialized, ());
+  TEST_EQUAL(src.Size(), 0, ());
+
+  // Unknown version is rejected.
+  buffer[0] = 0xFF;
+  SpeedProfiles unknown;
+  MemReader unknownReader(buffer.data(), buffer.size());
+  ReaderSource<MemReader> unknownSrc(unknownReader);
+  TEST(!SpeedProfilesSerializer::Deserialize(unknownSrc, unknown), ());
+  TEST(unknown.IsEmpty(), ());
+}
+
+// Route from (3, 0) to (0, 3) goes through the diagonal feature 2 if it's not jammed.
+//   (0, 3)
+//     ^
+//     |
+//   (0, 2)
+//     ^   \
+//     |     (1, 1)
+//     |        ^
+//     |          \
+//   (0, 0) <---- (2, 0) <---- (3, 0)
+UNIT_TEST(SpeedProfiles_TimeDependentRoute)
+{
+  classificator::Load();
+
+  // Points are about 10 meters apart, so the route takes a few minutes.
+  double constexpr kScale = 1e-4;
+  auto const buildGraph = [&]()
+  {
+    auto loader = make_unique<TestGeometryLoader>();
+    loader->AddRoad(0 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                    RoadGeometry::Points({{0.0, 0.0}, {0.0, 2.0 * kScale}}));
+    loader->AddRoad(1, true, 1.0, RoadGeometry::Points({{kScale, kScale}, {0.0, 2.0 * kScale}}));
+    loader->AddRoad(2, true, 1.0, RoadGeometry::Points({{2.0 * kScale, 0.0}, {kScale, kScale}}));
+    loader->AddRoad(3, true, 1.0,
+                    RoadGeometry::Points({{2.0 * kScale, 0.0}, {kScale, 0.0}, {0.0, 0.0}}));
+    loader->AddRoad(4, true, 1.0, RoadGeometry::Points({{0.0, 2.0 * kScale}, {0.0, 3.0 * kScale}}));
+    loader->AddRoad(5, true, 1.0, RoadGeometry::Points({{3.0 * kScale, 0.0}, {2.0 * kScale, 0.0}}));
+
+    vector<Joint> const joints = {
+        MakeJoint({{2, 0}, {3, 0}, {5, 1}}), MakeJoint({{3, 2}, {0, 0}}), MakeJoint({{2, 1}, {1, 0}}),
+        MakeJoint({{0, 1}, {1, 1}, {4, 0}}), MakeJoint({{5, 0}}),         MakeJoint({{4, 1}})};
+
+    traffic::TrafficCache const trafficCache;
+    return BuildWorldGraph(std::move(loader), CreateEstimatorForCar(trafficCache), joints);
+  };
+
+  // Feature 2 is jammed on Monday from 8:00 to 8:15 of the local time.
+  size_t const jamBucket = SpeedProfiles::GetBucket(MakeWeekTime(1 /* day */, 8 /* hour */, 0 /* min */));
+  SpeedProfilesBuilder builder;
+  builder.Add(2 /* featureId */, SpeedProfiles::kAllSegments, true /* forward */,
+              MakeProfile(SpeedProfiles::kFreeFlow, jamBucket, 10 /* bucketValue */));
+  auto profiles = make_shared<SpeedProfiles>(builder.Build());
+  profiles->SetUtcOffsetMinutes(120);
+
+  auto const getRouteFeatures = [&](time_t departure)
+  {
+    auto graph = buildGraph();
+    auto & indexGraph = graph->GetIndexGraphForTests(kTestNumMwmId);
+    indexGraph.SetCurrentTimeGetter([departure]() { return departure; });
+    indexGraph.SetSpeedProfiles(profiles);
+
+    auto starter = MakeStarter(MakeFakeEnding(5, 0, m2::PointD(3.0 * kScale, 0.0), *graph),
+                               MakeFakeEnding(4, 0, m2::PointD(0.0, 3.0 * kScale), *graph), *graph);
+
+    // The arrival time is known for the forward wave only.
+    AlgorithmForWorldGraph algorithm;
+    AlgorithmForWorldGraph::ParamsForTests<> params(*starter, starter->GetStartSegment(),
+                                                    starter->GetFinishSegment());
+    RoutingResult<Segment, RouteWeight> result;
+    TEST_EQUAL(algorithm.FindPath(params, result), AlgorithmForWorldGraph::Result::OK, ());
+
+    vector<uint32_t> features;
+    for (auto const & segment : result.m_path)
+    {
+      if (!IndexGraphStarter::IsFakeSegment(segment) &&
+          (features.empty() || features.back() != segment.GetFeatureId()))
+      {
+        features.push_back(segment.GetFeatureId());
+      }
+    }
+    return features;
+  };
+
+  // Monday 6:00 UTC is 8:00 of the local time.
+  time_t const mondayMorning = kSundayUtc + 24 * 3600 + 6 * 3600;
+  TEST_EQUAL(getRouteFeatures(mondayMorning), vector<uint32_t>({5, 3, 0, 4}), ());
+  TEST_EQUAL(getRouteFeatures(mondayMorning - 3600), vector<uint32_t>({5, 2, 1, 4}), ());
+  TEST_EQUAL(getRouteFeatures(mondayMorning + 3600), vector<uint32_t>({5, 2, 1, 4}), ());
+}
+
+// (0, 0) --> (1, 0) --> (2, 0) --> (3, 0) --> (4, 0)
+//  feature 0  |--------- feature 1 ---------------|
+UNIT_TEST(SpeedProfiles_JointArrivalTime)
+{
+  classificator::Load();
+
+  auto loader = make_unique<TestGeometryLoader>();
+  loader->AddRoad(0 /* featureId */, true /* oneWay */, 1.0 /* speed */,
+                  RoadGeometry::Points({{0.0, 0.0}, {1.0, 0.0}}));
+  loader->AddRoad(1, true, 1.0, RoadGeometry::Points({{1.0, 0.0}, {2.0, 0.0}, {3.0, 0.0}, {4.0, 0.0}}));
+  vector<Joint> const joints = {MakeJoint({{0, 0}}), MakeJoint({{0, 1}, {1, 0}}), MakeJoint({{1, 3}})};
+
+  // Every segment of feature 1 takes 10 minutes.
+  map<Segment, double> const weights = {{Segment(kTestNumMwmId, 0, 0, true), 60.0},
+                                        {Segment(kTestNumMwmId, 1, 0, true), 600.0},
+                                        {Segment(kTestNumMwmId, 1, 1, true), 600.0},
+                                        {Segment(kTestNumMwmId, 1, 2, true), 600.0}};
+  auto graph = BuildWorldGraph(std::move(loader), make_shared<WeightedEdgeEstimator>(weights), joints);
+  auto & indexGraph = graph->GetIndexGraphForTests(kTestNumMwmId);
+
+  // The last segment of feature 1 is jammed on Monday from 8:15 to 8:30.
+  size_t const jamBucket = SpeedProfiles::GetBucket(MakeWeekTime(1 /* day */, 8 /* hour */, 15 /* min */));
+  SpeedProfilesBuilder builder;
+  builder.Add(1 /* featureId */, 2 /* segmentIdx */, true /* forward */,
+              MakeProfile(SpeedProfiles::kFreeFlow, jamBucket, 50 /* bucketValue */));
+
+  // The route starts on Monday at 8:00, feature 1 is reached at 8:01 and its last segment at 8:21.
+  time_t const departure = kSundayUtc + 24 * 3600 + 8 * 3600;
+  indexGraph.SetCurrentTimeGetter([departure]() { return departure; });
+  indexGraph.SetSpeedProfiles(make_shared<SpeedProfiles>(builder.Build()));
+
+  Segment const parent(kTestNumMwmId, 0, 0, true);
+  astar::VertexData<JointSegment, RouteWeight> const parentData(JointSegment(parent, parent),
+                                                                RouteWeight(60.0));
+  IndexGraph::JointEdgeListT edges;
+  IndexGraph::WeightListT parentWeights;
+  indexGraph.GetEdgeList(parentData, parent, true /* isOutgoing */, edges, parentWeights,
+                         IndexGraph::Parents<JointSegment>());
+
+  TEST_EQUAL(edges.size(), 1, ());
+  TEST_EQUAL(edges[0].GetTarget(),
+             JointSegment(Segment(kTestNumMwmId, 1, 0, true), Segment(kTestNumMwmId, 1, 2, true)), ());
+  TEST_ALMOST_EQUAL_ABS(edges[0].GetWeight().GetWeight(), 600.0 + 600.0 + 1200.0, 1e-6, ());
+}
+
+UNIT_TEST(SpeedProfiles_TimeDependentRoutingSettings)
+{
+  bool const saved = IndexRouter::LoadTimeDependentRoutingFromSettings();
+  SCOPE_GUARD(restoreSettings, [saved]() { IndexRouter::SaveTimeDependentRoutingToSettings(saved); });
+
+  IndexRouter::SaveTimeDependentRoutingToSettings(true);
+  TEST(IndexRouter::LoadTimeDependentRoutingFromSettings(), ());
+
+  IndexRouter::SaveTimeDependentRoutingToSettings(false);
+  TEST(!IndexRouter::LoadTimeDependentRoutingFromSettings(), ());
+}
+}  // namespace speed_profiles_test
@@ -0,0 +1,141 @@
+#include "routing/speed_profiles.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <tuple>
+
+namespace routing
+{
+// SpeedProfiles::Entry ----------------------------------------------------------------------------
+bool SpeedProfiles::Entry::operator<(Entry const & rhs) const
+{
+  return std::tie(m_featureId, m_forward, m_segmentIdx) <
+         std::tie(rhs.m_featureId, rhs.m_forward, rhs.m_segmentIdx);
+}
+
+bool SpeedProfiles::Entry::operator==(Entry const & rhs) const
+{
+  return m_featureId == rhs.m_featureId && m_segmentIdx == rhs.m_segmentIdx &&
+         m_forward == rhs.m_forward && m_profileIdx == rhs.m_profileIdx;
+}
+
+// SpeedProfiles -----------------------------------------------------------------------------------
+// static
+size_t SpeedProfiles::GetBucket(uint64_t weekTime)
+{
+  return static_cast<size_t>(weekTime % kWeekDurationSec / kBucketDurationSec);
+}
+
+uint32_t SpeedProfiles::GetWeekTime(time_t time) const
+{
+  // 1 January 1970 is Thursday, so the week of the epoch starts 4 days before it.
+  int64_t constexpr kEpochWeekTime = 4 * 24 * 60 * 60;
+  int64_t const week = kWeekDurationSec;
+  int64_t const local = static_cast<int64_t>(time) + int64_t{m_utcOffsetMinutes} * 60 + kEpochWeekTime;
+  return static_cast<uint32_t>((local % week + week) % week);
+}
+
+// static
+uint8_t SpeedProfiles::Quantize(double factor)
+{
+  if (factor <= 0.0)
+    return kNoData;
+
+  auto const steps = std::lround(factor * kFreeFlow / kQuantStep);
+  return static_cast<uint8_t>(std::clamp(steps, 1L, static_cast<long>(kFreeFlow / kQuantStep)) * kQuantStep);
+}
+
+void SpeedProfiles::SetProfiles(std::vector<Profile> && profiles, std::vector<Entry> && entries)
+{
+  m_profiles = std::move(profiles);
+  m_entries = std::move(entries);
+  std::sort(m_entries.begin(), m_entries.end());
+
+  for (auto const & e : m_entries)
+    CHECK_LESS(e.m_profileIdx, m_profiles.size(), (e.m_featureId, e.m_segmentIdx));
+}
+
+double SpeedProfiles::GetSpeedFactor(uint32_t featureId, uint32_t segmentIdx, bool forward,
+                                     uint64_t weekTime) const
+{
+  Entry key;
+  key.m_featureId = featureId;
+  key.m_segmentIdx = segmentIdx;
+  key.m_forward = forward;
+
+  auto it = std::lower_bound(m_entries.cbegin(), m_entries.cend(), key);
+  auto const isSame = [&key](Entry const & e)
+  {
+    return e.m_featureId == key.m_featureId && e.m_forward == key.m_forward &&
+           e.m_segmentIdx == key.m_segmentIdx;
+  };
+
+  if (it == m_entries.cend() || !isSame(*it))
+  {
+    key.m_segmentIdx = kAllSegments;
+    it = std::lower_bound(it, m_entries.cend(), key);
+    if (it == m_entries.cend() || !isSame(*it))
+      return 1.0;
+  }
+
+  uint8_t const value = m_profiles[it->m_profileIdx][GetBucket(weekTime)];
+  if (value == kNoData)
+    return 1.0;
+
+  return static_cast<double>(std::min(value, kFreeFlow)) / kFreeFlow;
+}
+
+bool SpeedProfiles::operator==(SpeedProfiles const & rhs) const
+{
+  return m_utcOffsetMinutes == rhs.m_utcOffsetMinutes && m_profiles == rhs.m_profiles &&
+         m_entries == rhs.m_entries;
+}
+
+// SpeedProfilesBuilder ----------------------------------------------------------------------------
+void SpeedProfilesBuilder::Add(uint32_t featureId, uint32_t segmentIdx, bool forward,
+                               SpeedProfiles::Profile const & profile)
+{
+  auto const res = m_profileToIdx.emplace(profile, base::checked_cast<uint32_t>(m_profiles.size()));
+  if (res.second)
+    m_profiles.push_back(profile);
+
+  SpeedProfiles::Entry entry;
+  entry.m_featureId = featureId;
+  entry.m_segmentIdx = segmentIdx;
+  entry.m_forward = forward;
+  entry.m_profileIdx = res.first->second;
+  m_entries.push_back(entry);
+}
+
+SpeedProfiles SpeedProfilesBuilder::Build()
+{
+  // The first profile of the segment wins.
+  std::stable_sort(m_entries.begin(), m_entries.end());
+  m_entries.erase(std::unique(m_entries.begin(), m_entries.end(),
+                              [](SpeedProfiles::Entry const & lhs, SpeedProfiles::Entry const & rhs)
+                              {
+                                return !(lhs < rhs) && !(rhs < lhs);
+                              }),
+                  m_entries.end());
+
+  SpeedProfiles profiles;
+  profiles.SetProfiles(std::move(m_profiles), std::move(m_entries));
+  m_profiles.clear();
+  m_profileToIdx.clear();
+  m_entries.clear();
+  return profiles;
+}
+
+std::string DebugPrint(SpeedProfiles const & profiles)
+{
+  std::ostringstream out;
+  out << "SpeedProfiles [ utc offset: " << profiles.GetUtcOffsetMinutes()
+      << " min, profiles: " << profiles.GetProfiles().size()
+      << ", segments: " << profiles.GetEntries().size() << " ]";
+  return out.str();
+}
+}  // namespace routing
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace routing
+{
+/// Historical weekly speed profiles of road segments. A profile keeps a factor of the free flow
+/// speed for every 15 minutes of a week. Factors are quantized to kQuantStep percents, so
+/// the same profile is shared by many segments and only its index is stored per segment.
+class SpeedProfiles
+{
+public:
+  static uint32_t constexpr kBucketDurationSec = 15 * 60;
+  static size_t constexpr kBucketsPerDay = 24 * 60 * 60 / kBucketDurationSec;
+  static size_t constexpr kBucketsCount = 7 * kBucketsPerDay;
+  static uint32_t constexpr kWeekDurationSec = 7 * 24 * 60 * 60;
+
+  // Bucket value of the time without historical data.
+  static uint8_t constexpr kNoData = 0;
+  static uint8_t constexpr kFreeFlow = 100;
+  static uint8_t constexpr kQuantStep = 5;
+
+  // Profile of all the segments of the feature in one direction.
+  static uint32_t constexpr kAllSegments = std::numeric_limits<uint32_t>::max();
+
+  /// Percents of the free flow speed.
+  using Profile = std::array<uint8_t, kBucketsCount>;
+
+  struct Entry
+  {
+    bool operator<(Entry const & rhs) const;
+    bool operator==(Entry const & rhs) const;
+
+    uint32_t m_featureId = 0;
+    uint32_t m_segmentIdx = kAllSegments;
+    bool m_forward = true;
+    uint32_t m_profileIdx = 0;
+  };
+
+  /// \returns index of the bucket of |weekTime| seconds since the week start. Weeks start on
+  /// Sunday midnight, times longer than a week wrap around.
+  static size_t GetBucket(uint64_t weekTime);
+
+  /// \returns |factor| of the free flow speed quantized to a profile value.
+  /// Factors greater than 1.0 are cut to keep A* heuristics admissible.
+  static uint8_t Quantize(double factor);
+
+  /// |entries| are sorted here. All the profile indexes must be valid.
+  void SetProfiles(std::vector<Profile> && profiles, std::vector<Entry> && entries);
+
+  /// Profiles are kept in the local time of the region, which is UTC + |minutes|.
+  void SetUtcOffsetMinutes(int32_t minutes) { m_utcOffsetMinutes = minutes; }
+  int32_t GetUtcOffsetMinutes() const { return m_utcOffsetMinutes; }
+
+  /// \returns seconds since the local week start at UTC |time|. It's computed once per route,
+  /// weights of the route are added to it.
+  uint32_t GetWeekTime(time_t time) const;
+
+  /// \returns factor in (0.0, 1.0] of the free flow speed at |weekTime| on the segment. Profile of
+  /// the segment is used if there's one, otherwise the one of the whole feature. Returns 1.0
+  /// if there's no data.
+  double GetSpeedFactor(uint32_t featureId, uint32_t segmentIdx, bool forward, uint64_t weekTime) const;
+
+  std::vector<Profile> const & GetProfiles() const { return m_profiles; }
+  std::vector<Entry> const & GetEntries() const { return m_entries; }
+  bool IsEmpty() const { return m_entries.empty(); }
+
+  bool operator==(SpeedProfiles const & rhs) const;
+
+private:
+  int32_t m_utcOffsetMinutes = 0;
+  std::vector<Profile> m_profiles;
+  // Sorted by (feature id, direction, segment index), so feature-wide entries are the last ones.
+  std::vector<Entry> m_entries;
+};
+
+/// Collects profiles of the segments and merges the equal ones.
+class SpeedProfilesBuilder
+{
+public:
+  void Add(uint32_t featureId, uint32_t segmentIdx, bool forward, SpeedProfiles::Profile const & profile);
+
+  size_t GetSegmentsCount() const { return m_entries.size(); }
+  size_t GetProfilesCount() const { return m_profiles.size(); }
+
+  SpeedProfiles Build();
+
+private:
+  std::vector<SpeedProfiles::Profile> m_profiles;
+  std::map<SpeedProfiles::Profile, uint32_t> m_profileToIdx;
+  std::vector<SpeedProfiles::Entry> m_entries;
+};
+
+std::string DebugPrint(SpeedProfiles const & profiles);
+}  // namespace routing
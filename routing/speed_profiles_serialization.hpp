@@ -0,0 +1,97 @@
+#pragma once
+
+#include "routing/speed_profiles.hpp"
+
+#include "coding/reader.hpp"
+#include "coding/varint.hpp"
+#include "coding/write_to_sink.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace routing
+{
+/// Layout of speed_profiles section:
+/// header: version, UTC offset of the profiles in minutes, number of profiles and number of segments,
+/// profiles: SpeedProfiles::kBucketsCount bytes each,
+/// segments sorted by (feature id, direction, segment index): varint of feature id delta,
+/// varint of (segment index + 1, or 0 for the whole feature) << 1 | forward, varint of profile index.
+class SpeedProfilesSerializer final
+{
+public:
+  SpeedProfilesSerializer() = delete;
+
+  template <class Sink>
+  static void Serialize(Sink & sink, SpeedProfiles const & speedProfiles)
+  {
+    auto const & profiles = speedProfiles.GetProfiles();
+    auto const & entries = speedProfiles.GetEntries();
+
+    WriteToSink(sink, kLatestVersion);
+    WriteToSink(sink, speedProfiles.GetUtcOffsetMinutes());
+    WriteToSink(sink, base::checked_cast<uint32_t>(profiles.size()));
+    WriteToSink(sink, base::checked_cast<uint32_t>(entries.size()));
+
+    for (auto const & profile : profiles)
+      sink.Write(profile.data(), profile.size());
+
+    uint32_t prevFeatureId = 0;
+    for (auto const & e : entries)
+    {
+      CHECK_GREATER_OR_EQUAL(e.m_featureId, prevFeatureId, ("Entries must be sorted."));
+      WriteVarUint(sink, e.m_featureId - prevFeatureId);
+      prevFeatureId = e.m_featureId;
+
+      uint64_t const segment =
+          e.m_segmentIdx == SpeedProfiles::kAllSegments ? 0 : uint64_t{e.m_segmentIdx} + 1;
+      WriteVarUint(sink, (segment << 1) | (e.m_forward ? 1 : 0));
+      WriteVarUint(sink, e.m_profileIdx);
+    }
+  }
+
+  /// \returns false if the section has an unknown version. Static speeds should be used then.
+  template <class Source>
+  static bool Deserialize(Source & src, SpeedProfiles & speedProfiles)
+  {
+    auto const version = ReadPrimitiveFromSource<uint16_t>(src);
+    if (version != kLatestVersion)
+    {
+      LOG(LWARNING, ("Unknown version of speed profiles:", version, "latest:", kLatestVersion));
+      return false;
+    }
+
+    auto const utcOffsetMinutes = ReadPrimitiveFromSource<int32_t>(src);
+    auto const profilesCount = ReadPrimitiveFromSource<uint32_t>(src);
+    auto const entriesCount = ReadPrimitiveFromSource<uint32_t>(src);
+
+    std::vector<SpeedProfiles::Profile> profiles(profilesCount);
+    for (auto & profile : profiles)
+      src.Read(profile.data(), profile.size());
+
+    std::vector<SpeedProfiles::Entry> entries(entriesCount);
+    uint32_t featureId = 0;
+    for (auto & e : entries)
+    {
+      featureId += ReadVarUint<uint32_t>(src);
+      e.m_featureId = featureId;
+
+      auto const segment = ReadVarUint<uint64_t>(src);
+      e.m_forward = (segment & 1) != 0;
+      e.m_segmentIdx = (segment >> 1) == 0 ? SpeedProfiles::kAllSegments
+                                            : base::checked_cast<uint32_t>((segment >> 1) - 1);
+      e.m_profileIdx = ReadVarUint<uint32_t>(src);
+    }
+
+    speedProfiles.SetUtcOffsetMinutes(utcOffsetMinutes);
+    speedProfiles.SetProfiles(std::move(profiles), std::move(entries));
+    return true;
+  }
+
+private:
+  static uint16_t constexpr kLatestVersion = 0;
+};
+}  // namespace routing
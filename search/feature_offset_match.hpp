@@ -15,7 +15,6 @@
 
 #include <limits>
 #include <memory>
-#include <queue>
 #include <unordered_set>
 #include <vector>
 
@@ -46,47 +45,64 @@ template <typename ValueList, typename DFA, typename ToDo>
 bool MatchInTrie(trie::Iterator<ValueList> const & trieRoot, strings::UniChar const * rootPrefix,
                  size_t rootPrefixSize, DFA const & dfa, ToDo && toDo)
 {
-  using TrieDFAIt = std::shared_ptr<trie::Iterator<ValueList>>;
+  using TrieIt = trie::Iterator<ValueList>;
   using DFAIt = typename DFA::Iterator;
-  using State = std::pair<TrieDFAIt, DFAIt>;
-
-  std::queue<State> q;
 
+  struct State
   {
-    auto it = dfa.Begin();
-    DFAMove(it, rootPrefix, rootPrefix + rootPrefixSize);
-    if (it.Rejects())
-      return false;
-    q.emplace(trieRoot.Clone(), it);
-  }
+    TrieIt const * m_trieIt;
+    DFAIt m_dfaIt;
+    // Index of the next edge to follow.
+    size_t m_edge;
+  };
+
+  auto it = dfa.Begin();
+  DFAMove(it, rootPrefix, rootPrefix + rootPrefixSize);
+  if (it.Rejects())
+    return false;
 
   bool found = false;
-
-  while (!q.empty())
-  {
-    auto const p = q.front();
-    q.pop();
-
-    auto const & trieIt = p.first;
-    auto const & dfaIt = p.second;
-
-    if (dfaIt.Accepts())
+  auto const visit = [&found, &toDo](State const & state) {
+    if (state.m_dfaIt.Accepts())
     {
-      trieIt->m_values.ForEach(
+      auto const & dfaIt = state.m_dfaIt;
+      state.m_trieIt->m_values.ForEach(
           [&dfaIt, &toDo](auto const & v) { toDo(v, dfaIt.ErrorsMade() == 0); });
       found = true;
     }
+  };
 
-    size_t const numEdges = trieIt->m_edges.size();
-    for (size_t i = 0; i < numEdges; ++i)
-    {
-      auto const & edge = trieIt->m_edges[i];
+  // Depth-first walk. Only the iterators of the current path are alive, one per trie level.
+  std::vector<std::unique_ptr<TrieIt>> levels;
+  std::vector<State> stack;
+  stack.push_back({&trieRoot, it, 0});
+  visit(stack.back());
 
-      auto curIt = dfaIt;
-      strings::DFAMove(curIt, edge.m_label.begin(), edge.m_label.end());
-      if (!curIt.Rejects())
-        q.emplace(trieIt->GoToEdge(i), curIt);
+  while (!stack.empty())
+  {
+    auto & state = stack.back();
+    auto const & trieIt = *state.m_trieIt;
+    if (state.m_edge == trieIt.m_edges.size())
+    {
+      stack.pop_back();
+      continue;
     }
+
+    size_t const i = state.m_edge++;
+    auto const & edge = trieIt.m_edges[i];
+
+    auto curIt = state.m_dfaIt;
+    strings::DFAMove(curIt, edge.m_label.begin(), edge.m_label.end());
+    if (curIt.Rejects())
+      continue;
+
+    size_t const level = stack.size() - 1;
+    if (levels.size() == level)
+      levels.emplace_back();
+    levels[level] = trieIt.GoToEdge(i);
+
+    stack.push_back({levels[level].get(), curIt, 0});
+    visit(stack.back());
   }
 
   return found;
@@ -28,6 +28,7 @@ FeaturesLayerMatcher::FeaturesLayerMatcher(DataSource const & dataSource,
   , m_nearbyStreetsCache("FeatureToNearbyStreets")
   , m_matchingStreetsCache("BuildingToStreet")
   , m_place2address("PlaceToAddresses")
+  , m_houseNumbersCache("BuildingToHouseNumber")
   , m_loader(scales::GetUpperScale(), ReverseGeocoder::kLookupRadiusM)
   , m_cancellable(cancellable)
 {
@@ -53,6 +54,7 @@ void FeaturesLayerMatcher::OnQueryFinished()
   m_nearbyStreetsCache.ClearIfNeeded();
   m_matchingStreetsCache.ClearIfNeeded();
   m_place2address.ClearIfNeeded();
+  m_houseNumbersCache.ClearIfNeeded();
 
   m_loader.OnQueryFinished();
 }
@@ -81,6 +83,83 @@ std::vector<uint32_t> const & FeaturesLayerMatcher::GetPlaceAddrFeatures(
   return res.first;
 }
 
+// static
+void FeaturesLayerMatcher::ParseHouseNumber(FeatureType & feature, HouseNumber & houseNumber)
+{
+  houseNumber.m_interpol = ftypes::IsAddressInterpolChecker::Instance().GetInterpolType(feature);
+  if (houseNumber.m_interpol != feature::InterpolType::None)
+  {
+    houseNumber.m_range = feature.GetRef();
+    return;
+  }
+
+  auto const uniHouse = strings::MakeUniString(feature.GetHouseNumber());
+  if (uniHouse.empty())
+    return;
+
+  if (feature.GetID().IsEqualCountry({"Czech", "Slovakia"}))
+    house_numbers::ParseHouseNumberConscription(uniHouse, houseNumber.m_parses);
+  else
+    house_numbers::ParseHouseNumber(uniHouse, houseNumber.m_parses);
+}
+
+// static
+bool FeaturesLayerMatcher::HouseNumbersMatch(HouseNumber const & houseNumber,
+                                             vector<house_numbers::Token> const & queryParse)
+{
+  if (houseNumber.m_interpol != feature::InterpolType::None)
+  {
+    return house_numbers::HouseNumbersMatchRange(houseNumber.m_range, queryParse,
+                                                 houseNumber.m_interpol);
+  }
+  return house_numbers::HouseNumbersMatch(houseNumber.m_parses, queryParse);
+}
+
+FeaturesLayerMatcher::HouseNumber const & FeaturesLayerMatcher::GetHouseNumber(FeatureType & feature)
+{
+  auto const res = m_houseNumbersCache.Get(feature.GetID().m_index);
+  if (res.second)
+    ParseHouseNumber(feature, res.first);
+  return res.first;
+}
+
+FeaturesLayerMatcher::HouseNumber const & FeaturesLayerMatcher::GetHouseNumber(uint32_t houseId)
+{
+  auto const res = m_houseNumbersCache.Get(houseId);
+  if (res.second)
+  {
+    // Features which are not read (e.g. deleted by the editor) have no house number.
+    if (auto feature = GetByIndex(houseId))
+      ParseHouseNumber(*feature, res.first);
+  }
+  return res.first;
+}
+
+bool FeaturesLayerMatcher::HouseNumbersMatch(FeatureType & feature,
+                                             vector<house_numbers::Token> const & queryParse)
+{
+  if (m_context->GetEditedStatus(feature.GetID().m_index) != FeatureStatus::Untouched)
+  {
+    HouseNumber houseNumber;
+    ParseHouseNumber(feature, houseNumber);
+    return HouseNumbersMatch(houseNumber, queryParse);
+  }
+  return HouseNumbersMatch(GetHouseNumber(feature), queryParse);
+}
+
+bool FeaturesLayerMatcher::HouseNumbersMatch(uint32_t houseId,
+                                             vector<house_numbers::Token> const & queryParse)
+{
+  if (m_context->GetEditedStatus(houseId) != FeatureStatus::Untouched)
+  {
+    HouseNumber houseNumber;
+    if (auto feature = GetByIndex(houseId))
+      ParseHouseNumber(*feature, houseNumber);
+    return HouseNumbersMatch(houseNumber, queryParse);
+  }
+  return HouseNumbersMatch(GetHouseNumber(houseId), queryParse);
+}
+
 uint32_t FeaturesLayerMatcher::GetMatchingStreet(FeatureID const & houseId)
 {
   std::unique_ptr<FeatureType> feature;
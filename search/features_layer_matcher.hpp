@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -116,18 +117,26 @@ private:
 
   void BailIfCancelled() { ::search::BailIfCancelled(m_cancellable); }
 
-  static bool HouseNumbersMatch(FeatureType & feature, std::vector<house_numbers::Token> const & queryParse)
+  // House number of a building parsed once for matching with all the queries.
+  struct HouseNumber
   {
-    auto const interpol = ftypes::IsAddressInterpolChecker::Instance().GetInterpolType(feature);
-    if (interpol != feature::InterpolType::None)
-      return house_numbers::HouseNumbersMatchRange(feature.GetRef(), queryParse, interpol);
+    std::vector<house_numbers::TokensT> m_parses;
+    // Range of the address interpolation.
+    std::string m_range;
+    feature::InterpolType m_interpol = feature::InterpolType::None;
+  };
 
-    auto const uniHouse = strings::MakeUniString(feature.GetHouseNumber());
-    if (feature.GetID().IsEqualCountry({"Czech", "Slovakia"}))
-      return house_numbers::HouseNumbersMatchConscription(uniHouse, queryParse);
+  static void ParseHouseNumber(FeatureType & feature, HouseNumber & houseNumber);
+  static bool HouseNumbersMatch(HouseNumber const & houseNumber,
+                                std::vector<house_numbers::Token> const & queryParse);
 
-    return house_numbers::HouseNumbersMatch(uniHouse, queryParse);
-  }
+  HouseNumber const & GetHouseNumber(FeatureType & feature);
+  HouseNumber const & GetHouseNumber(uint32_t houseId);
+
+  // Parsed house numbers are cached across queries, the editor doesn't clear search caches.
+  // So house numbers of edited features are parsed on every match.
+  bool HouseNumbersMatch(FeatureType & feature, std::vector<house_numbers::Token> const & queryParse);
+  bool HouseNumbersMatch(uint32_t houseId, std::vector<house_numbers::Token> const & queryParse);
 
   template <typename Fn>
   void MatchPOIsWithParent(FeaturesLayer const & child, FeaturesLayer const & parent, Fn && fn)
@@ -355,14 +364,10 @@ private:
       if (m_postcodes && !m_postcodes->HasBit(houseId) && !m_postcodes->HasBit(streetId))
         return false;
 
-      std::unique_ptr<FeatureType> feature = GetByIndex(houseId);
-      if (!feature)
-        return false;
-
       if (!child.m_hasDelayedFeatures)
         return false;
 
-      return HouseNumbersMatch(*feature, queryParse);
+      return HouseNumbersMatch(houseId, queryParse);
     };
 
     // Cache is not needed since we process unique and mapped-only house->street.
@@ -424,12 +429,7 @@ private:
       if (m_postcodes && !m_postcodes->HasBit(houseId))
         return false;
 
-      /// @todo Add house -> number cache for this and MatchBuildingsWithStreets?
-      std::unique_ptr<FeatureType> feature = GetByIndex(houseId);
-      if (!feature)
-        return false;
-
-      return HouseNumbersMatch(*feature, queryParse);
+      return HouseNumbersMatch(houseId, queryParse);
     };
 
     for (uint32_t houseId : ids)
@@ -491,6 +491,10 @@ private:
   // Cache of addresses that belong to a place (city/village).
   Cache<uint32_t, std::vector<uint32_t>> m_place2address;
 
+  // Cache of parsed house numbers of buildings, a building is matched with many streets and
+  // many house number queries.
+  Cache<uint32_t, HouseNumber> m_houseNumbersCache;
+
   StreetVicinityLoader m_loader;
   base::Cancellable const & m_cancellable;
 };
@@ -348,6 +348,8 @@ Geocoder::~Geocoder() {}
 
 void Geocoder::SetParams(Params const & params)
 {
+  m_tokenFeaturesCache.OnQueryStarted();
+
   if (params.IsCategorialRequest())
   {
     SetParamsForCategorialSearch(params);
@@ -379,6 +381,10 @@ void Geocoder::SetParams(Params const & params)
     }
   }
 
+  m_tokenKeys.clear();
+  for (size_t i = 0; i < m_params.GetNumTokens(); ++i)
+    m_tokenKeys.push_back(MakeTokenKey(i));
+
   m_resultTracer.Clear();
 
   LOG(LDEBUG, (static_cast<QueryParams const &>(m_params)));
@@ -433,6 +439,7 @@ void Geocoder::ClearCaches()
   m_pivotRectsCache.Clear();
   m_localityRectsCache.Clear();
 
+  m_tokenFeaturesCache.Clear();
   m_matchersCache.clear();
   m_streetsCache.Clear();
   m_hotelsCache.Clear();
@@ -448,6 +455,7 @@ void Geocoder::SetParamsForCategorialSearch(Params const & params)
 
   m_tokenRequests.clear();
   m_prefixTokenRequest.Clear();
+  m_tokenKeys.clear();
 
   LOG(LDEBUG, (static_cast<QueryParams const &>(m_params)));
 }
@@ -541,6 +549,8 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
 {
   // base::PProf pprof("/tmp/geocoder.prof");
 
+  SearchStats::ScopedTimer const timer(m_stats, SearchStats::Stage::Geocoding);
+
   // Tries to find world and fill localities table.
   {
     m_cities.clear();
@@ -604,6 +614,8 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
     m_matcher = it->second.get();
     m_matcher->SetContext(m_context.get());
 
+    SearchStats::Add(m_stats, SearchStats::Counter::Mwms);
+
     BaseContext ctx;
     InitBaseContext(ctx);
 
@@ -652,8 +664,23 @@ void Geocoder::GoImpl(vector<MwmInfoPtr> const & infos, bool inViewport)
 
 void Geocoder::InitBaseContext(BaseContext & ctx)
 {
+  SearchStats::ScopedTimer const timer(m_stats, SearchStats::Stage::Retrieval);
+  uint64_t const hits = m_tokenFeaturesCache.GetHitsCount();
+  uint64_t const misses = m_tokenFeaturesCache.GetMissesCount();
+
   Retrieval retrieval(*m_context, m_cancellable);
 
+  // Retrieval applies the editor changes, which don't clear search caches. So features of mwms
+  // with edits are not cached.
+  bool const useCache = !Retrieval::HasEdits(m_context->GetId());
+  auto const getFeatures = [&](size_t i, auto const & request)
+  {
+    auto const retrieve = [&]() { return retrieval.RetrieveAddressFeatures(request); };
+    if (!useCache)
+      return retrieve();
+    return m_tokenFeaturesCache.Get(m_context->GetId(), m_tokenKeys[i], retrieve);
+  };
+
   size_t const numTokens = m_params.GetNumTokens();
   ctx.m_tokens.assign(numTokens, BaseContext::TOKEN_TYPE_COUNT);
   ctx.m_features.resize(numTokens);
@@ -668,15 +695,46 @@ void Geocoder::InitBaseContext(BaseContext & ctx)
     }
     else if (m_params.IsPrefixToken(i))
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_prefixTokenRequest);
+      ctx.m_features[i] = getFeatures(i, m_prefixTokenRequest);
     }
     else
     {
-      ctx.m_features[i] = retrieval.RetrieveAddressFeatures(m_tokenRequests[i]);
+      ctx.m_features[i] = getFeatures(i, m_tokenRequests[i]);
     }
   }
 
   ctx.m_cuisineFilter = m_cuisineFilter.MakeScopedFilter(*m_context, m_params.m_cuisineTypes);
+
+  SearchStats::Add(m_stats, SearchStats::Counter::TokenCacheHits,
+                   m_tokenFeaturesCache.GetHitsCount() - hits);
+  SearchStats::Add(m_stats, SearchStats::Counter::TokenCacheMisses,
+                   m_tokenFeaturesCache.GetMissesCount() - misses);
+  if (m_stats && m_stats->IsEnabled())
+  {
+    // PopCount is not free, so the features are counted only when the stats are collected.
+    for (auto const & features : ctx.m_features)
+      SearchStats::Add(m_stats, SearchStats::Counter::RetrievedFeatures, features.m_features.PopCount());
+  }
+}
+
+string Geocoder::MakeTokenKey(size_t i) const
+{
+  // Retrieval request of the token is defined by the token strings, prefix flag, types and langs.
+  string key = m_params.IsPrefixToken(i) ? "p" : "f";
+  m_params.GetToken(i).ForOriginalAndSynonyms([&key](strings::UniString const & s)
+  {
+    key += '\0';
+    key += strings::ToUtf8(s);
+  });
+
+  key += '\1';
+  for (auto const index : m_params.GetTypeIndices(i))
+    key += std::to_string(index) + ',';
+
+  key += '\1';
+  for (auto const lang : m_params.GetLangs())
+    key += std::to_string(lang) + ',';
+  return key;
 }
 
 void Geocoder::InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer)
@@ -1776,9 +1834,14 @@ void Geocoder::FindPaths(BaseContext & ctx)
     return true;
   };
 
+  for (auto const * layer : sortedLayers)
+    SearchStats::AddLayerFeatures(m_stats, layer->m_type, layer->m_sortedFeatures->size());
+
+  SearchStats::ScopedTimer const timer(m_stats, SearchStats::Stage::PathFinding);
   m_finder.ForEachReachableVertex(*m_matcher, sortedLayers, [&](IntersectionResult const & result)
   {
     ASSERT(result.IsValid(), ());
+    SearchStats::Add(m_stats, SearchStats::Counter::Intersections);
     if (result.IsFakeBuildingButStreet())
       return;
 
@@ -1846,6 +1909,21 @@ void Geocoder::EmitResult(BaseContext & ctx, FeatureID const & id,
   if (ctx.m_cuisineFilter && !ctx.m_cuisineFilter->Matches(id))
     return;
 
+  if (m_context && id.m_mwmId == m_context->GetId())
+  {
+    bool const relaxed =
+        base::IsExist(m_resultTracer.GetProvenance(), ResultTracer::Branch::Relaxed);
+    m2::PointD center;
+    if (m_preRanker.HasDistanceCutoff(relaxed) && m_context->GetCenter(id.m_index, center) &&
+        m_preRanker.IsFartherThanCutoff(center, relaxed))
+    {
+      SearchStats::Add(m_stats, SearchStats::Counter::PreRankerSkipped);
+      // The result is matched, so the relaxed fallbacks should not be tried for it.
+      ++ctx.m_numEmitted;
+      return;
+    }
+  }
+
   if (m_params.m_tracer)
     TraceResult(*m_params.m_tracer, ctx, id.m_mwmId, id.m_index, type, tokenRange);
 
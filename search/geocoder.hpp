@@ -17,7 +17,9 @@
 #include "search/mwm_context.hpp"
 #include "search/postcode_points.hpp"
 #include "search/query_params.hpp"
+#include "search/search_stats.hpp"
 #include "search/streets_matcher.hpp"
+#include "search/token_features_cache.hpp"
 #include "search/token_range.hpp"
 #include "search/tracer.hpp"
 
@@ -127,6 +129,8 @@ public:
   void CacheWorldLocalities();
   void ClearCaches();
 
+  void SetStats(SearchStats * stats) { m_stats = stats; }
+
 private:
   enum class RectId
   {
@@ -193,6 +197,9 @@ private:
   // for each token and saves it to m_addressFeatures.
   void InitBaseContext(BaseContext & ctx);
 
+  // Returns a key of the i-th token for TokenFeaturesCache.
+  std::string MakeTokenKey(size_t i) const;
+
   void InitLayer(Model::Type type, TokenRange const & tokenRange, FeaturesLayer & layer);
 
   void FillLocalityCandidates(BaseContext const & ctx, CBV const & filter,
@@ -368,6 +375,13 @@ private:
   // Path finder for interpretations.
   FeaturesLayerPathFinder m_finder;
 
+  // Features of the query tokens retrieved by the current and the previous queries.
+  TokenFeaturesCache m_tokenFeaturesCache;
+  // Keys of the query tokens for |m_tokenFeaturesCache|.
+  std::vector<std::string> m_tokenKeys;
+
+  SearchStats * m_stats = nullptr;
+
   // Search query params prepared for retrieval.
   std::vector<SearchTrieRequest<strings::LevenshteinDFA>> m_tokenRequests;
   SearchTrieRequest<strings::PrefixDFAModifier<strings::LevenshteinDFA>> m_prefixTokenRequest;
@@ -574,8 +574,15 @@ bool HouseNumbersMatch(UniString const & houseNumber, TokensT const & queryParse
 
   vector<TokensT> houseNumberParses;
   ParseHouseNumber(houseNumber, houseNumberParses);
+  return HouseNumbersMatch(houseNumberParses, queryParse);
+}
+
+bool HouseNumbersMatch(vector<TokensT> const & houseNumberParses, TokensT const & queryParse)
+{
+  if (queryParse.empty())
+    return false;
 
-  for (auto & parse : houseNumberParses)
+  for (auto const & parse : houseNumberParses)
   {
     if (parse.empty())
       continue;
@@ -603,6 +610,21 @@ bool HouseNumbersMatchConscription(UniString const & houseNumber, TokensT const
   return HouseNumbersMatch(houseNumber, queryParse);
 }
 
+void ParseHouseNumberConscription(UniString const & houseNumber, vector<TokensT> & parses)
+{
+  auto const beg = houseNumber.begin();
+  auto const end = houseNumber.end();
+  auto i = std::find(beg, end, '/');
+  if (i != end)
+  {
+    // Conscription number / street number.
+    ParseHouseNumber(UniString(beg, i), parses);
+    ParseHouseNumber(UniString(i + 1, end), parses);
+    return;
+  }
+  ParseHouseNumber(houseNumber, parses);
+}
+
 bool HouseNumbersMatchRange(std::string_view const & hnRange, TokensT const & queryParse, feature::InterpolType interpol)
 {
   ASSERT(interpol != feature::InterpolType::None, ());
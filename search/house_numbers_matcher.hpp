@@ -66,12 +66,20 @@ void Tokenize(strings::UniString s, bool isPrefix, TokensT & ts);
 // can be used to parse addr:housenumber fields.
 void ParseHouseNumber(strings::UniString const & s, std::vector<TokensT> & parses);
 
+// The same as ParseHouseNumber but "conscription number/street number" (used in Czech and
+// Slovakia) gives parses of both numbers.
+void ParseHouseNumberConscription(strings::UniString const & houseNumber,
+                                  std::vector<TokensT> & parses);
+
 // Parses a part of search query that can be a house number.
 void ParseQuery(strings::UniString const & query, bool queryIsPrefix, TokensT & parse);
 
 /// @return true if house number matches to a given parsed query.
 /// @{
 bool HouseNumbersMatch(strings::UniString const & houseNumber, TokensT const & queryParse);
+/// The same as above for the house number parsed with ParseHouseNumber (ParseHouseNumberConscription).
+/// Parses may be computed once and matched with many queries.
+bool HouseNumbersMatch(std::vector<TokensT> const & houseNumberParses, TokensT const & queryParse);
 bool HouseNumbersMatchConscription(strings::UniString const & houseNumber, TokensT const & queryParse);
 bool HouseNumbersMatchRange(std::string_view const & hnRange, TokensT const & queryParse, feature::InterpolType interpol);
 /// @}
@@ -8,6 +8,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 class MwmValue;
 
@@ -31,6 +33,15 @@ public:
 
   [[nodiscard]] bool Get(uint32_t id, m2::PointD & center);
 
+  // Calls |fn(id, center)| for all |sortedIds| which have centers, see CentersTable::GetMany.
+  template <typename Fn>
+  void GetMany(std::vector<uint32_t> const & sortedIds, Fn && fn)
+  {
+    EnsureTableLoaded();
+    if (m_state == STATE_LOADED)
+      m_table->GetMany(sortedIds, std::forward<Fn>(fn));
+  }
+
 private:
   MwmValue const & m_value;
   State m_state;
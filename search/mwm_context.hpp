@@ -111,12 +111,12 @@ public:
   MwmSet::MwmHandle m_handle;
   MwmValue & m_value;
 
-private:
   FeatureStatus GetEditedStatus(uint32_t index) const
   {
     return m_editableSource.GetFeatureStatus(index);
   }
 
+private:
   template <class Fn>
   void ForEachIndexImpl(covering::Intervals const & intervals, uint32_t scale, Fn && fn) const
   {
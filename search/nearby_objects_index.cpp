@@ -0,0 +1,209 @@
+#include "search/nearby_objects_index.hpp"
+
+#include "search/mwm_context.hpp"
+
+#include "indexer/feature.hpp"
+#include "indexer/feature_algo.hpp"
+
+#include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+#include "geometry/triangle2d.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <utility>
+
+namespace search
+{
+using namespace std;
+
+namespace
+{
+// Max number of grid cells, the cell size is increased for huge rects.
+uint64_t constexpr kMaxCellsCount = 1 << 22;
+
+double GetSegmentDistanceMeters(m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & pt)
+{
+  m2::ParametrizedSegment<m2::PointD> const segment(p1, p2);
+  return mercator::DistanceOnEarth(segment.ClosestPointTo(pt), pt);
+}
+}  // namespace
+
+// NearbyObjectsIndex::Item ------------------------------------------------------------------------
+m2::RectD NearbyObjectsIndex::Item::GetLimitRect() const
+{
+  m2::RectD rect;
+  for (uint8_t i = 0; i < m_pointsCount; ++i)
+    rect.Add(m_points[i]);
+  return rect;
+}
+
+double NearbyObjectsIndex::Item::GetDistanceMeters(m2::PointD const & pt) const
+{
+  switch (m_pointsCount)
+  {
+  case 1: return mercator::DistanceOnEarth(m_points[0], pt);
+  case 2: return GetSegmentDistanceMeters(m_points[0], m_points[1], pt);
+  case 3:
+  {
+    // The same as feature::GetMinDistanceMeters() for areas.
+    if (m2::IsPointInsideTriangle(pt, m_points[0], m_points[1], m_points[2]))
+      return 0.0;
+    return min({GetSegmentDistanceMeters(m_points[0], m_points[1], pt),
+                GetSegmentDistanceMeters(m_points[1], m_points[2], pt),
+                GetSegmentDistanceMeters(m_points[2], m_points[0], pt)});
+  }
+  }
+  UNREACHABLE();
+}
+
+// NearbyObjectsIndex ------------------------------------------------------------------------------
+NearbyObjectsIndex::NearbyObjectsIndex(MwmContext const & context, m2::RectD const & rect,
+                                       Filter const & filter, double cellSizeM)
+{
+  context.ForEachFeature(rect, [&](FeatureType & ft)
+  {
+    if (filter(ft))
+      AddFeature(ft, rect);
+  });
+
+  BuildGrid(rect, cellSizeM);
+}
+
+vector<NearbyObjectsIndex::Object> NearbyObjectsIndex::GetNearbyObjects(m2::PointD const & center,
+                                                                        double radiusM) const
+{
+  m2::RectD const rect = mercator::RectByCenterXYAndSizeInMeters(center, radiusM);
+
+  // Pairs of an object index and a distance to one of the object items.
+  vector<pair<uint32_t, double>> distances;
+  ForEachCell(rect, [&](size_t cell)
+  {
+    for (uint32_t i = m_cellOffsets[cell]; i < m_cellOffsets[cell + 1]; ++i)
+    {
+      auto const & item = m_items[m_cellItems[i]];
+      if (item.GetLimitRect().IsIntersect(rect))
+        distances.emplace_back(item.m_objectIdx, item.GetDistanceMeters(center));
+    }
+  });
+
+  // Items which are in several cells are met several times, the min distance is the same as
+  // for a single item.
+  sort(distances.begin(), distances.end());
+
+  vector<Object> objects;
+  for (size_t i = 0; i < distances.size(); ++i)
+  {
+    if (i > 0 && distances[i].first == distances[i - 1].first)
+      continue;
+
+    objects.push_back(m_objects[distances[i].first]);
+    objects.back().m_distanceMeters = distances[i].second;
+  }
+
+  sort(objects.begin(), objects.end(), base::LessBy(&Object::m_distanceMeters));
+  return objects;
+}
+
+void NearbyObjectsIndex::AddFeature(FeatureType & ft, m2::RectD const & rect)
+{
+  string_view const name = ft.GetReadableName();
+  if (name.empty())
+    return;
+
+  auto const objectIdx = base::checked_cast<uint32_t>(m_objects.size());
+  size_t const itemsCount = m_items.size();
+  auto const addItem = [&](initializer_list<m2::PointD> points)
+  {
+    Item item;
+    for (auto const & p : points)
+      item.m_points[item.m_pointsCount++] = p;
+    item.m_objectIdx = objectIdx;
+
+    if (item.GetLimitRect().IsIntersect(rect))
+      m_items.push_back(item);
+  };
+
+  switch (ft.GetGeomType())
+  {
+  case feature::GeomType::Point: addItem({ft.GetCenter()}); break;
+  case feature::GeomType::Line:
+  {
+    ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+    size_t const count = ft.GetPointsCount();
+    for (size_t i = 1; i < count; ++i)
+      addItem({ft.GetPoint(i - 1), ft.GetPoint(i)});
+    break;
+  }
+  default:
+  {
+    ASSERT_EQUAL(ft.GetGeomType(), feature::GeomType::Area, ());
+    ft.ForEachTriangle([&](m2::PointD const & p1, m2::PointD const & p2, m2::PointD const & p3)
+    {
+      addItem({p1, p2, p3});
+    }, FeatureType::BEST_GEOMETRY);
+    break;
+  }
+  }
+
+  if (m_items.size() != itemsCount)
+    m_objects.emplace_back(ft.GetID(), 0.0 /* dist */, name, ft.GetNames());
+}
+
+void NearbyObjectsIndex::BuildGrid(m2::RectD const & rect, double cellSizeM)
+{
+  CHECK_GREATER(cellSizeM, 0.0, ());
+
+  m_origin = rect.LeftBottom();
+  m_cellSize = mercator::RectByCenterXYAndSizeInMeters(rect.Center(), cellSizeM).SizeX() / 2;
+  auto const getCellsCount = [this](double size)
+  {
+    return static_cast<uint64_t>(ceil(size / m_cellSize)) + 1;
+  };
+  while (getCellsCount(rect.SizeX()) * getCellsCount(rect.SizeY()) > kMaxCellsCount)
+    m_cellSize *= 2;
+  m_cellsX = static_cast<uint32_t>(getCellsCount(rect.SizeX()));
+  m_cellsY = static_cast<uint32_t>(getCellsCount(rect.SizeY()));
+
+  // Counting sort of the items by cells.
+  m_cellOffsets.assign(static_cast<size_t>(m_cellsX) * m_cellsY + 1, 0);
+  for (auto const & item : m_items)
+    ForEachCell(item.GetLimitRect(), [this](size_t cell) { ++m_cellOffsets[cell + 1]; });
+
+  for (size_t i = 1; i < m_cellOffsets.size(); ++i)
+    m_cellOffsets[i] += m_cellOffsets[i - 1];
+
+  m_cellItems.resize(m_cellOffsets.back());
+  vector<uint32_t> positions(m_cellOffsets.begin(), m_cellOffsets.end() - 1);
+  for (uint32_t i = 0; i < m_items.size(); ++i)
+    ForEachCell(m_items[i].GetLimitRect(), [&](size_t cell) { m_cellItems[positions[cell]++] = i; });
+}
+
+template <typename Fn>
+void NearbyObjectsIndex::ForEachCell(m2::RectD const & rect, Fn && fn) const
+{
+  if (m_cellsX == 0 || m_cellsY == 0)
+    return;
+
+  auto const toCell = [this](double coord, double origin, uint32_t cellsCount)
+  {
+    double const cell = floor((coord - origin) / m_cellSize);
+    return static_cast<uint32_t>(base::Clamp(cell, 0.0, static_cast<double>(cellsCount - 1)));
+  };
+
+  uint32_t const minX = toCell(rect.minX(), m_origin.x, m_cellsX);
+  uint32_t const maxX = toCell(rect.maxX(), m_origin.x, m_cellsX);
+  uint32_t const minY = toCell(rect.minY(), m_origin.y, m_cellsY);
+  uint32_t const maxY = toCell(rect.maxY(), m_origin.y, m_cellsY);
+  for (uint32_t y = minY; y <= maxY; ++y)
+  {
+    for (uint32_t x = minX; x <= maxX; ++x)
+      fn(static_cast<size_t>(y) * m_cellsX + x);
+  }
+}
+}  // namespace search
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "search/reverse_geocoder.hpp"
+
+#include "geometry/point2d.hpp"
+#include "geometry/rect2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class FeatureType;
+
+namespace search
+{
+class MwmContext;
+
+/// In-memory spatial index of the named streets (places) of an mwm for the bulk reverse geocoding.
+/// Geometry of the objects is split into points, segments and triangles which are packed into
+/// a uniform grid, so nearby objects of a point are found without reading and parsing features.
+/// Answers are the same as ReverseGeocoder::GetNearbyStreets(context, center, radiusM) gives
+/// for the objects which intersect the lookup rect.
+/// \note The index is immutable after construction, queries are thread-safe.
+class NearbyObjectsIndex
+{
+public:
+  using Object = ReverseGeocoder::Street;
+  using Filter = std::function<bool(FeatureType & ft)>;
+
+  /// Indexes named features from |context| which pass |filter| and intersect |rect|.
+  /// |cellSizeM| is the grid cell size, it should be comparable with the lookup radius.
+  NearbyObjectsIndex(MwmContext const & context, m2::RectD const & rect, Filter const & filter,
+                     double cellSizeM = 500.0);
+
+  /// \returns objects intersecting the lookup rect of |center| sorted by distance to |center|.
+  std::vector<Object> GetNearbyObjects(m2::PointD const & center, double radiusM) const;
+
+  size_t GetObjectsCount() const { return m_objects.size(); }
+  size_t GetItemsCount() const { return m_items.size(); }
+
+private:
+  // A point, a segment or a triangle of an object geometry.
+  struct Item
+  {
+    m2::RectD GetLimitRect() const;
+    double GetDistanceMeters(m2::PointD const & pt) const;
+
+    m2::PointD m_points[3];
+    uint8_t m_pointsCount = 0;
+    uint32_t m_objectIdx = 0;
+  };
+
+  void AddFeature(FeatureType & ft, m2::RectD const & rect);
+  void BuildGrid(m2::RectD const & rect, double cellSizeM);
+  // Calls |fn| for every cell intersecting |rect|.
+  template <typename Fn>
+  void ForEachCell(m2::RectD const & rect, Fn && fn) const;
+
+  std::vector<Object> m_objects;
+  std::vector<Item> m_items;
+
+  // Items of the cell (x, y) are m_cellItems[m_cellOffsets[i]...m_cellOffsets[i + 1]), where
+  // i = y * m_cellsX + x.
+  m2::PointD m_origin;
+  double m_cellSize = 0.0;
+  uint32_t m_cellsX = 0;
+  uint32_t m_cellsY = 0;
+  std::vector<uint32_t> m_cellOffsets;
+  std::vector<uint32_t> m_cellItems;
+};
+}  // namespace search
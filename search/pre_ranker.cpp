@@ -15,6 +15,8 @@
 
 #include "base/stl_helpers.hpp"
 
+#include "std/boost_container_hash.hpp"
+
 #include <algorithm>
 #include <iterator>
 #include <random>
@@ -82,10 +84,19 @@ void PreRanker::Init(Params const & params)
   m_haveFullyMatchedResult = false;
   m_results.clear();
   m_relaxedResults.clear();
+  m_numFilledResults = 0;
+  m_distanceCutoff.reset();
+  m_relaxedDistanceCutoff.reset();
   m_params = params;
   m_currEmit.clear();
 }
 
+bool PreRanker::IsFartherThanCutoff(m2::PointD const & center, bool relaxed) const
+{
+  auto const & cutoff = relaxed ? m_relaxedDistanceCutoff : m_distanceCutoff;
+  return cutoff && mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center) > *cutoff;
+}
+
 void PreRanker::Finish(bool cancelled)
 {
   m_ranker.Finish(cancelled);
@@ -97,10 +108,12 @@ void PreRanker::FillMissingFieldsInPreResults()
   MwmSet::MwmHandle mwmHandle;
   unique_ptr<RankTable> ranks = make_unique<DummyRankTable>();
   unique_ptr<RankTable> popularityRanks = make_unique<DummyRankTable>();
-  unique_ptr<LazyCentersTable> centers;
+  // Centers of the current mwm results sorted by feature index. They are read in one pass,
+  // so every block of the centers table is decoded once.
+  vector<pair<uint32_t, m2::PointD>> centers;
   bool pivotFeaturesInitialized = false;
 
-  ForEachMwmOrder(m_results, [&](PreRankerResult & r)
+  ForEachMwmOrder(m_results, m_numFilledResults, [&](PreRankerResult & r)
   {
     FeatureID const & id = r.GetId();
     if (id.m_mwmId != mwmId)
@@ -109,14 +122,26 @@ void PreRanker::FillMissingFieldsInPreResults()
       mwmHandle = m_dataSource.GetMwmHandleById(mwmId);
 
       ranks.reset();
-      centers.reset();
+      centers.clear();
       if (mwmHandle.IsAlive())
       {
         auto const * value = mwmHandle.GetValue();
 
         ranks = RankTable::Load(value->m_cont, SEARCH_RANKS_FILE_TAG);
         popularityRanks = RankTable::Load(value->m_cont, POPULARITY_RANKS_FILE_TAG);
-        centers = make_unique<LazyCentersTable>(*value);
+
+        vector<uint32_t> ids;
+        for (size_t i = m_numFilledResults; i < m_results.size(); ++i)
+        {
+          if (m_results[i].GetId().m_mwmId == mwmId)
+            ids.push_back(m_results[i].GetId().m_index);
+        }
+        base::SortUnique(ids);
+
+        LazyCentersTable(*value).GetMany(ids, [&centers](uint32_t id, m2::PointD const & center)
+        {
+          centers.emplace_back(id, center);
+        });
       }
       if (!ranks)
         ranks = make_unique<DummyRankTable>();
@@ -128,8 +153,14 @@ void PreRanker::FillMissingFieldsInPreResults()
     r.SetPopularity(popularityRanks->Get(id.m_index));
 
     m2::PointD center;
-    if (centers && centers->Get(id.m_index, center))
+    auto const it = lower_bound(centers.begin(), centers.end(), id.m_index,
+                                [](pair<uint32_t, m2::PointD> const & lhs, uint32_t rhs)
+                                {
+                                  return lhs.first < rhs;
+                                });
+    if (it != centers.end() && it->first == id.m_index)
     {
+      center = it->second;
       r.SetDistanceToPivot(mercator::DistanceOnEarth(m_params.m_accuratePivotCenter, center));
       r.SetCenter(center);
     }
@@ -156,32 +187,39 @@ void PreRanker::FillMissingFieldsInPreResults()
       }
     }
   });
+
+  m_numFilledResults = m_results.size();
 }
 
 namespace
 {
+// Compares results by |cmp| and breaks ties by the pseudo random |keys| of the results, so the
+// best results of any criterion don't depend on the order in which the results were emitted.
 template <class CompT, class ContT> class CompareIndices
 {
   CompT m_cmp;
   ContT const & m_cont;
+  vector<size_t> const & m_keys;
 
 public:
-  CompareIndices(CompT const & cmp, ContT const & cont) : m_cmp(cmp), m_cont(cont) {}
+  CompareIndices(CompT const & cmp, ContT const & cont, vector<size_t> const & keys)
+    : m_cmp(cmp), m_cont(cont), m_keys(keys)
+  {
+  }
+
   bool operator()(size_t l, size_t r) const
   {
-    return m_cmp(m_cont[l], m_cont[r]);
+    if (m_cmp(m_cont[l], m_cont[r]))
+      return true;
+    if (m_cmp(m_cont[r], m_cont[l]))
+      return false;
+    if (m_keys[l] != m_keys[r])
+      return m_keys[l] < m_keys[r];
+    return m_cont[l].GetId() < m_cont[r].GetId();
   }
 };
-} // namespace
-
-void PreRanker::DbgFindAndLog(std::set<uint32_t> const & ids) const
-{
-  for (auto const & r : m_results)
-    if (ids.count(r.GetId().m_index) > 0)
-      LOG(LDEBUG, (r));
-}
 
-void PreRanker::Filter()
+void RemoveDuplicates(vector<PreRankerResult> & results)
 {
   auto const lessForUnique = [](PreRankerResult const & lhs, PreRankerResult const & rhs)
   {
@@ -193,40 +231,68 @@ void PreRanker::Filter()
     return PreRankerResult::CompareByTokensMatch(lhs, rhs) == -1;
   };
 
+  base::SortUnique(results, lessForUnique, base::EqualsBy(&PreRankerResult::GetId));
+}
+} // namespace
+
+void PreRanker::DbgFindAndLog(std::set<uint32_t> const & ids) const
+{
+  for (auto const & r : m_results)
+    if (ids.count(r.GetId().m_index) > 0)
+      LOG(LDEBUG, (r));
+}
+
+void PreRanker::Filter()
+{
   /// @DebugNote
   /// Use DbgFindAndLog to check needed ids before and after filtering
 
-  base::SortUnique(m_results, lessForUnique, base::EqualsBy(&PreRankerResult::GetId));
-
   if (m_params.m_viewportSearch)
+  {
+    RemoveDuplicates(m_results);
     FilterForViewportSearch();
+    // Viewport search ends here.
+    return;
+  }
 
-  // Viewport search ends here.
-  if (m_results.size() <= BatchSize())
+  FilterBest(m_results);
+}
+
+void PreRanker::FilterBest(PreResultsContainerT & results) const
+{
+  RemoveDuplicates(results);
+  if (results.size() <= BatchSize())
     return;
 
-  std::vector<size_t> indices(m_results.size());
+  std::vector<size_t> indices(results.size());
   std::generate(indices.begin(), indices.end(), [n = 0] () mutable { return n++; });
   std::unordered_set<size_t> filtered;
 
+  std::vector<size_t> keys(results.size());
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    keys[i] = m_rndSeed;
+    boost::hash_combine(keys[i], std::hash<FeatureID>()(results[i].GetId()));
+  }
+
   auto const iBeg = indices.begin();
   auto const iMiddle = iBeg + BatchSize();
   auto const iEnd = indices.end();
 
-  std::nth_element(iBeg, iMiddle, iEnd, CompareIndices(&PreRankerResult::LessDistance, m_results));
+  std::nth_element(iBeg, iMiddle, iEnd, CompareIndices(&PreRankerResult::LessDistance, results, keys));
   filtered.insert(iBeg, iMiddle);
 
   if (!m_params.m_categorialRequest)
   {
-    std::nth_element(iBeg, iMiddle, iEnd, CompareIndices(&PreRankerResult::LessRankAndPopularity, m_results));
+    std::nth_element(iBeg, iMiddle, iEnd,
+                     CompareIndices(&PreRankerResult::LessRankAndPopularity, results, keys));
     filtered.insert(iBeg, iMiddle);
 
-    // Shuffle to give a chance to far results, not only closest ones (see above).
-    // Search is not stable in rare cases, but we avoid increasing m_everywhereBatchSize.
+    // Ties are broken by the random keys to give a chance to far results, not only closest ones
+    // (see above). Search is not stable in rare cases, but we avoid increasing m_everywhereBatchSize.
     /// @todo Move up, when we will have _enough_ ranks and popularities.
-    std::shuffle(iBeg, iEnd, std::mt19937(m_rndSeed));
-
-    std::nth_element(iBeg, iMiddle, iEnd, CompareIndices(&PreRankerResult::LessByExactMatch, m_results));
+    std::nth_element(iBeg, iMiddle, iEnd,
+                     CompareIndices(&PreRankerResult::LessByExactMatch, results, keys));
     filtered.insert(iBeg, iMiddle);
   }
   else
@@ -240,31 +306,84 @@ void PreRanker::Filter()
                                  2 * kPedestrianRadiusMeters;
     comparator.m_viewport = m_params.m_viewport;
 
-    std::nth_element(iBeg, iMiddle, iEnd, CompareIndices(comparator, m_results));
+    std::nth_element(iBeg, iMiddle, iEnd, CompareIndices(comparator, results, keys));
     filtered.insert(iBeg, iMiddle);
   }
 
   PreResultsContainerT newResults;
   newResults.reserve(filtered.size());
   for (size_t idx : filtered)
-    newResults.push_back(m_results[idx]);
-  m_results.swap(newResults);
+    newResults.push_back(std::move(results[idx]));
+  results.swap(newResults);
 }
 
 void PreRanker::UpdateResults(bool lastUpdate)
 {
-  FilterRelaxedResults(lastUpdate);
-  FillMissingFieldsInPreResults();
-  Filter();
+  {
+    SearchStats::ScopedTimer const timer(m_stats, SearchStats::Stage::PreRanking);
+    // Fields are filled before the relaxed results are put aside, so all the relaxed results
+    // are filled when they are flushed.
+    FillMissingFieldsInPreResults();
+    FilterRelaxedResults(lastUpdate);
+    Filter();
+  }
   m_numSentResults += m_results.size();
+  SearchStats::Add(m_stats, SearchStats::Counter::RankerCandidates, m_results.size());
   m_ranker.AddPreRankerResults(std::move(m_results));
   m_results.clear();
+  m_numFilledResults = 0;
+  m_distanceCutoff.reset();
+  if (lastUpdate)
+    m_relaxedDistanceCutoff.reset();
   m_ranker.UpdateResults(lastUpdate);
 
   if (lastUpdate && !m_currEmit.empty())
     m_currEmit.swap(m_prevEmit);
 }
 
+void PreRanker::Compact()
+{
+  SearchStats::ScopedTimer const timer(m_stats, SearchStats::Stage::PreRanking);
+
+  // Relaxed results are not sent to Ranker until the last update, so they are compacted
+  // separately, the same as FilterRelaxedResults(false /* lastUpdate */) does.
+  FillMissingFieldsInPreResults();
+  FilterRelaxedResults(false /* lastUpdate */);
+
+  size_t const numResults = m_results.size() + m_relaxedResults.size();
+  FilterBest(m_results);
+  FilterBest(m_relaxedResults);
+  m_numFilledResults = m_results.size();
+
+  // A compaction may only replace the kept results with closer ones, so the cutoffs decrease
+  // until the results are sent to Ranker.
+  if (IsSelectedByDistanceOnly())
+  {
+    m_distanceCutoff = GetDistanceCutoff(m_results);
+    m_relaxedDistanceCutoff = GetDistanceCutoff(m_relaxedResults);
+  }
+
+  LOG(LDEBUG, ("Compacted pre-results:", numResults, "->", m_results.size() + m_relaxedResults.size()));
+}
+
+bool PreRanker::IsSelectedByDistanceOnly() const
+{
+  // The same as CategoriesComparator::m_positionIsInsideViewport in FilterBest().
+  return !m_params.m_viewportSearch && m_params.m_categorialRequest && m_params.m_position &&
+         m_params.m_viewport.IsPointInside(*m_params.m_position);
+}
+
+optional<double> PreRanker::GetDistanceCutoff(PreResultsContainerT const & results) const
+{
+  if (results.size() < BatchSize())
+    return {};
+
+  double cutoff = 0.0;
+  for (auto const & result : results)
+    cutoff = max(cutoff, result.GetDistance());
+  return cutoff;
+}
+
 void PreRanker::ClearCaches()
 {
   m_pivotFeatures.Clear();
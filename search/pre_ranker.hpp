@@ -3,6 +3,7 @@
 #include "search/intermediate_result.hpp"
 #include "search/nested_rects_cache.hpp"
 #include "search/ranker.hpp"
+#include "search/search_stats.hpp"
 
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
@@ -74,8 +75,12 @@ public:
       return;
 
     m_results.emplace_back(std::forward<Args>(args)...);
+    SearchStats::Add(m_stats, SearchStats::Counter::PreRankerCandidates);
     if (m_results.back().GetInfo().m_allTokensUsed)
       m_haveFullyMatchedResult = true;
+
+    if (m_results.size() / kCompactionFactor >= BatchSize())
+      Compact();
   }
 
   // Emit a new batch of results up the pipeline (i.e. to ranker).
@@ -89,6 +94,17 @@ public:
                                      : m_params.m_everywhereBatchSize;
   }
   size_t NumSentResults() const { return m_numSentResults; }
+
+  // Results of categorial requests are selected only by the distance to the pivot when the position
+  // is inside the viewport. Then after a compaction the results which are farther than BatchSize()
+  // collected results can't be sent to Ranker, so Geocoder may skip them. Relaxed results are
+  // selected separately from the other ones and have their own cutoff.
+  bool HasDistanceCutoff(bool relaxed) const
+  {
+    return relaxed ? m_relaxedDistanceCutoff.has_value() : m_distanceCutoff.has_value();
+  }
+  bool IsFartherThanCutoff(m2::PointD const & center, bool relaxed) const;
+
   bool HaveFullyMatchedResult() const { return m_haveFullyMatchedResult; }
   size_t Limit() const { return m_params.m_limit; }
 
@@ -96,14 +112,21 @@ public:
   // Made it "static template" for easy unit tests implementing.
   template <class T, class FnT>
   static void ForEachMwmOrder(std::vector<T> & vec, FnT && fn)
+  {
+    ForEachMwmOrder(vec, 0 /* first */, fn);
+  }
+
+  // The same for the elements starting from |first|.
+  template <class T, class FnT>
+  static void ForEachMwmOrder(std::vector<T> & vec, size_t first, FnT && fn)
   {
     size_t const count = vec.size();
-    if (count == 0)
+    if (first >= count)
       return;
 
     std::set<MwmSet::MwmId> processed;
 
-    size_t next = 0;
+    size_t next = first;
     bool nextAssigned;
 
     do
@@ -133,26 +156,56 @@ public:
 
   void ClearCaches();
 
+  void SetStats(SearchStats * stats) { m_stats = stats; }
+
 private:
-  // Computes missing fields for all pre-results.
+  using PreResultsContainerT = std::vector<PreRankerResult>;
+
+  // Results are compacted when their number reaches kCompactionFactor * BatchSize().
+  // Compaction keeps up to 3 * BatchSize() results, so at least 3 * BatchSize() new results
+  // are collected between compactions.
+  static size_t constexpr kCompactionFactor = 6;
+
+  // Computes missing fields for the pre-results which are not filled yet.
   void FillMissingFieldsInPreResults();
   void DbgFindAndLog(std::set<uint32_t> const & ids) const;
 
   void FilterForViewportSearch();
   void Filter();
+  // Removes duplicates and keeps BatchSize() best |results| by every criterion. Ties are broken
+  // by the feature ids hashed with |m_rndSeed|, so the kept results don't depend on their order.
+  void FilterBest(PreResultsContainerT & results) const;
   void FilterRelaxedResults(bool lastUpdate);
 
+  // True iff FilterBest() selects the results only by the distance to the pivot.
+  bool IsSelectedByDistanceOnly() const;
+  // Returns the max distance to the pivot of the compacted |results| when there are BatchSize()
+  // of them.
+  std::optional<double> GetDistanceCutoff(PreResultsContainerT const & results) const;
+
+  // Streaming top-k: applies FilterBest() to the results collected so far, so the memory and
+  // the time of Filter() do not grow with the number of results emitted by Geocoder.
+  // Every criterion is a strict order, so the best results by it of a subset include all the
+  // results of the whole set which are the best by this criterion, and the results sent to Ranker
+  // are the same as without compaction.
+  void Compact();
+
   DataSource const & m_dataSource;
   Ranker & m_ranker;
 
-  using PreResultsContainerT = std::vector<PreRankerResult>;
   PreResultsContainerT m_results, m_relaxedResults;
 
+  // Number of the first |m_results| with the filled missing fields.
+  size_t m_numFilledResults = 0;
+
   Params m_params;
 
   // Amount of results sent up the pipeline.
   size_t m_numSentResults = 0;
 
+  // See HasDistanceCutoff(). The cutoff of |m_results| is reset when they are sent to Ranker.
+  std::optional<double> m_distanceCutoff, m_relaxedDistanceCutoff;
+
   // True iff there is at least one result with all tokens used (not relaxed).
   bool m_haveFullyMatchedResult = false;
 
@@ -169,6 +222,8 @@ private:
 
   unsigned m_rndSeed;
 
+  SearchStats * m_stats = nullptr;
+
   DISALLOW_COPY_AND_MOVE(PreRanker);
 };
 }  // namespace search
@@ -174,6 +174,10 @@ Processor::Processor(DataSource const & dataSource, CategoriesHolder const & cat
                m_localitiesCaches, static_cast<base::Cancellable const &>(*this))
   , m_bookmarksProcessor(m_emitter, static_cast<base::Cancellable const &>(*this))
 {
+  m_ranker.SetStats(&m_stats);
+  m_preRanker.SetStats(&m_stats);
+  m_geocoder.SetStats(&m_stats);
+
   // Current and input langs are to be set later.
   m_keywordsScorer.SetLanguages(
       LanguageTier::LANGUAGE_TIER_EN_AND_INTERNATIONAL,
@@ -565,6 +569,8 @@ void Processor::Search(SearchParams params)
 
   m_emitter.Init(std::move(params.m_onResults));
 
+  m_stats.Reset(static_cast<bool>(params.m_onStats));
+
   bool const viewportSearch = params.m_mode == Mode::Viewport;
 
   auto const & viewport = params.m_viewport;
@@ -589,43 +595,52 @@ void Processor::Search(SearchParams params)
   case Mode::Viewport:    // fallthrough
   case Mode::Downloader:
   {
-    Geocoder::Params geocoderParams;
-    InitGeocoder(geocoderParams, params);
-    InitPreRanker(geocoderParams, params);
-    InitRanker(geocoderParams, params);
-
-    try
     {
-      if (!SearchCoordinates() && !SearchDebug())
+      SearchStats::ScopedTimer const timer(&m_stats, SearchStats::Stage::Total);
+
+      Geocoder::Params geocoderParams;
+      InitGeocoder(geocoderParams, params);
+      InitPreRanker(geocoderParams, params);
+      InitRanker(geocoderParams, params);
+
+      try
       {
-        SearchPlusCode();
-        SearchPostcode();
-        if (viewportSearch)
-        {
-          m_geocoder.GoInViewport();
-        }
-        else
+        if (!SearchCoordinates() && !SearchDebug())
         {
-          if (m_query.m_tokens.empty())
-            m_ranker.SuggestStrings();
-          m_geocoder.GoEverywhere();
+          SearchPlusCode();
+          SearchPostcode();
+          if (viewportSearch)
+          {
+            m_geocoder.GoInViewport();
+          }
+          else
+          {
+            if (m_query.m_tokens.empty())
+              m_ranker.SuggestStrings();
+            m_geocoder.GoEverywhere();
+          }
         }
       }
-    }
-    catch (CancelException const &)
-    {
-      LOG(LDEBUG, ("Search has been cancelled. Reason:", CancellationStatus()));
-    }
+      catch (CancelException const &)
+      {
+        LOG(LDEBUG, ("Search has been cancelled. Reason:", CancellationStatus()));
+      }
 
-    cancellationStatus = CancellationStatus();
-    if (cancellationStatus != base::Cancellable::Status::CancelCalled)
-    {
-      m_lastUpdate = true;
-      // Cancellable is effectively disabled now, so
-      // this call must not result in a CancelException.
-      m_preRanker.UpdateResults(true /* lastUpdate */);
+      cancellationStatus = CancellationStatus();
+      if (cancellationStatus != base::Cancellable::Status::CancelCalled)
+      {
+        m_lastUpdate = true;
+        // Cancellable is effectively disabled now, so
+        // this call must not result in a CancelException.
+        m_preRanker.UpdateResults(true /* lastUpdate */);
+      }
     }
 
+    // Stats are reported before the finish marker, so they are ready when the client
+    // gets the last results.
+    if (params.m_onStats)
+      params.m_onStats(m_stats);
+
     // Emit finish marker to client.
     m_geocoder.Finish(cancellationStatus == Cancellable::Status::CancelCalled);
     break;
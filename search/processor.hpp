@@ -169,6 +169,7 @@ protected:
 
   KeywordLangMatcher m_keywordsScorer;
   Emitter m_emitter;
+  SearchStats m_stats;
   Ranker m_ranker;
   PreRanker m_preRanker;
   Geocoder m_geocoder;
@@ -22,8 +22,12 @@
 #include "base/string_utils.hpp"
 
 #include <algorithm>
+#include <map>
 #include <memory>
+#include <numeric>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace search
 {
@@ -421,21 +425,19 @@ public:
   }
 
 private:
-  bool IsSameLoader(FeatureID const & id) const
+  FeaturesLoaderGuard & GetLoader(MwmSet::MwmId const & id)
   {
-    return (m_loader && m_loader->GetId() == id.m_mwmId);
+    // Results are made in (mwm, index) order, but cities are loaded from World.mwm, so keep
+    // a loader per mwm instead of reopening them.
+    auto & loader = m_loaders[id];
+    if (!loader)
+      loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id);
+    return *loader;
   }
 
   unique_ptr<FeatureType> LoadFeature(FeatureID const & id)
   {
-    if (!IsSameLoader(id))
-      m_loader = make_unique<FeaturesLoaderGuard>(m_dataSource, id.m_mwmId);
-    return LoadFeatureImpl(id, *m_loader);
-  }
-
-  static unique_ptr<FeatureType> LoadFeatureImpl(FeatureID const & id, FeaturesLoaderGuard & loader)
-  {
-    auto ft = loader.GetFeatureByIndex(id.m_index);
+    auto ft = GetLoader(id.m_mwmId).GetFeatureByIndex(id.m_index);
     if (ft)
     {
       ASSERT(id.IsValid(), ());
@@ -444,6 +446,15 @@ private:
     return ft;
   }
 
+  // Streets, suburbs, complex POIs and cities are shared by many results, so they are loaded once.
+  FeatureType * LoadSharedFeature(FeatureID const & id)
+  {
+    auto it = m_sharedFeatures.find(id);
+    if (it == m_sharedFeatures.end())
+      it = m_sharedFeatures.emplace(id, LoadFeature(id)).first;
+    return it->second.get();
+  }
+
   bool GetExactAddress(FeatureType & ft, m2::PointD const & center, ReverseGeocoder::Address & addr) const
   {
     if (m_reverseGeocoder.GetExactAddress(ft, addr, true /* placeAsStreet */))
@@ -453,7 +464,19 @@ private:
     return addr.IsValid();
   }
 
-  // For the best performance, incoming ids should be sorted by id.first (mwm file id).
+  string const & GetStreetName(FeatureID const & id)
+  {
+    auto it = m_streetNames.find(id);
+    if (it == m_streetNames.end())
+    {
+      string name;
+      if (auto * street = LoadSharedFeature(id))
+        m_ranker.GetBestMatchName(*street, name);
+      it = m_streetNames.emplace(id, std::move(name)).first;
+    }
+    return it->second;
+  }
+
   unique_ptr<FeatureType> LoadFeature(FeatureID const & id, m2::PointD & center, string & name,
                                       string & country)
   {
@@ -462,11 +485,11 @@ private:
       return ft;
 
     // Country (region) name is a file name if feature isn't from World.mwm.
-    ASSERT(m_loader && m_loader->GetId() == id.m_mwmId, ());
-    if (m_loader->IsWorld())
+    auto const & loader = GetLoader(id.m_mwmId);
+    if (loader.IsWorld())
       country.clear();
     else
-      country = m_loader->GetCountryFileName();
+      country = loader.GetCountryFileName();
 
     center = feature::GetCenter(*ft);
     m_ranker.GetBestMatchName(*ft, name);
@@ -477,25 +500,9 @@ private:
       ReverseGeocoder::Address addr;
       if (GetExactAddress(*ft, center, addr))
       {
-        unique_ptr<FeatureType> streetFeature;
-
-        // We can't change m_loader here, because of the following RankerResult. So do this trick:
-        if (IsSameLoader(addr.m_street.m_id))
-        {
-          streetFeature = LoadFeatureImpl(addr.m_street.m_id, *m_loader);
-        }
-        else
-        {
-          auto loader = make_unique<FeaturesLoaderGuard>(m_dataSource, addr.m_street.m_id.m_mwmId);
-          streetFeature = LoadFeatureImpl(addr.m_street.m_id, *loader);
-        }
-
-        if (streetFeature)
-        {
-          string streetName;
-          m_ranker.GetBestMatchName(*streetFeature, streetName);
+        auto const & streetName = GetStreetName(addr.m_street.m_id);
+        if (!streetName.empty())
           name = streetName + ", " + addr.GetHouseNumber();
-        }
       }
     }
 
@@ -564,7 +571,7 @@ private:
       {
         if (info.m_type != type && dependID != IntersectionResult::kInvalidId)
         {
-          if (auto p = LoadFeature({ ft.GetID().m_mwmId, dependID }))
+          if (auto * p = LoadSharedFeature({ ft.GetID().m_mwmId, dependID }))
             updateScoreForFeature(*p, type);
         }
       };
@@ -575,7 +582,7 @@ private:
 
       if (!Model::IsLocalityType(info.m_type) && preInfo.m_cityId.IsValid())
       {
-        if (auto city = LoadFeature(preInfo.m_cityId))
+        if (auto * city = LoadSharedFeature(preInfo.m_cityId))
         {
           auto type = Model::TYPE_CITY;
           if (preInfo.m_tokenRanges[type].Empty())
@@ -672,7 +679,9 @@ private:
   Geocoder::Params const & m_params;
   bool m_isViewportMode;
 
-  unique_ptr<FeaturesLoaderGuard> m_loader;
+  map<MwmSet::MwmId, unique_ptr<FeaturesLoaderGuard>> m_loaders;
+  unordered_map<FeatureID, unique_ptr<FeatureType>> m_sharedFeatures;
+  unordered_map<FeatureID, string> m_streetNames;
 };
 
 Ranker::Ranker(DataSource const & dataSource, CitiesBoundariesTable const & boundariesTable,
@@ -773,6 +782,8 @@ void Ranker::SuggestStrings()
 
 void Ranker::UpdateResults(bool lastUpdate)
 {
+  SearchStats::ScopedTimer const timer(m_stats, SearchStats::Stage::Ranking);
+
   if (!lastUpdate)
     BailIfCancelled();
 
@@ -818,7 +829,8 @@ void Ranker::UpdateResults(bool lastUpdate)
   }
 
   // Emit feature results.
-  size_t count = m_emitter.GetResults().GetCount();
+  size_t const initialCount = m_emitter.GetResults().GetCount();
+  size_t count = initialCount;
   size_t i = 0;
   for (; i < m_tentativeResults.size(); ++i)
   {
@@ -864,6 +876,8 @@ void Ranker::UpdateResults(bool lastUpdate)
     }
   }
 
+  SearchStats::Add(m_stats, SearchStats::Counter::Results, count - initialCount);
+
   /// @todo Use deque for m_tentativeResults?
   m_tentativeResults.erase(m_tentativeResults.begin(), m_tentativeResults.begin() + i);
 
@@ -888,18 +902,34 @@ void Ranker::MakeRankerResults()
 {
   LOG(LDEBUG, ("PreRankerResults number =", m_preRankerResults.size()));
 
-  RankerResultMaker maker(*this, m_dataSource, m_infoGetter, m_reverseGeocoder, m_geocoderParams);
-  for (auto const & r : m_preRankerResults)
+  // Features are loaded in (mwm, index) order, so the features of an mwm are read sequentially
+  // and the streets and cities shared by the results are loaded once. The results keep
+  // the pre-ranker order.
+  vector<size_t> order(m_preRankerResults.size());
+  iota(order.begin(), order.end(), 0);
+  sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+    return m_preRankerResults[lhs].GetId() < m_preRankerResults[rhs].GetId();
+  });
+
+  vector<optional<RankerResult>> results(m_preRankerResults.size());
+  {
+    RankerResultMaker maker(*this, m_dataSource, m_infoGetter, m_reverseGeocoder, m_geocoderParams);
+    for (size_t const i : order)
+      results[i] = maker(m_preRankerResults[i]);
+  }
+
+  for (size_t i = 0; i < results.size(); ++i)
   {
-    auto p = maker(r);
+    auto & p = results[i];
     if (!p)
       continue;
 
-    ASSERT(m_geocoderParams.m_mode != Mode::Viewport || m_geocoderParams.m_pivot.IsPointInside(p->GetCenter()), (r));
+    ASSERT(m_geocoderParams.m_mode != Mode::Viewport || m_geocoderParams.m_pivot.IsPointInside(p->GetCenter()),
+           (m_preRankerResults[i]));
 
     // Do not filter any _duplicates_ here. Leave it for high level Results class.
     m_tentativeResults.push_back(std::move(*p));
-  };
+  }
 
   m_preRankerResults.clear();
 }
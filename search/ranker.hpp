@@ -9,6 +9,7 @@
 #include "search/region_info_getter.hpp"
 #include "search/result.hpp"
 #include "search/reverse_geocoder.hpp"
+#include "search/search_stats.hpp"
 #include "search/suggest.hpp"
 
 #include "geometry/point2d.hpp"
@@ -96,6 +97,8 @@ public:
 
   void LoadCountriesTree();
 
+  void SetStats(SearchStats * stats) { m_stats = stats; }
+
 private:
   friend class RankerResultMaker;
 
@@ -125,5 +128,7 @@ private:
 
   std::vector<PreRankerResult> m_preRankerResults;
   std::vector<RankerResult> m_tentativeResults;
+
+  SearchStats * m_stats = nullptr;
 };
 }  // namespace search
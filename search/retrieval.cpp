@@ -375,6 +375,15 @@ Retrieval::Retrieval(MwmContext const & context, base::Cancellable const & cance
   m_root = ReadTrie<Uint64IndexValue>(m_reader);
 }
 
+// static
+bool Retrieval::HasEdits(MwmSet::MwmId const & id)
+{
+  auto & editor = Editor::Instance();
+  return !editor.GetFeaturesByStatus(id, FeatureStatus::Deleted).empty() ||
+         !editor.GetFeaturesByStatus(id, FeatureStatus::Modified).empty() ||
+         !editor.GetFeaturesByStatus(id, FeatureStatus::Created).empty();
+}
+
 Retrieval::ExtendedFeatures Retrieval::RetrieveAddressFeatures(
     SearchTrieRequest<UniStringDFA> const & request) const
 {
@@ -4,6 +4,8 @@
 #include "search/feature_offset_match.hpp"
 #include "search/query_params.hpp"
 
+#include "indexer/mwm_set.hpp"
+
 #include "platform/mwm_traits.hpp"
 
 #include "coding/reader.hpp"
@@ -88,6 +90,10 @@ public:
 
   Retrieval(MwmContext const & context, base::Cancellable const & cancellable);
 
+  // Returns true if the editor has created, modified or deleted features of the mwm |id|.
+  // Features retrieved from such mwms depend on the editor state.
+  static bool HasEdits(MwmSet::MwmId const & id);
+
   // Following functions retrieve all features matching to |request| from the search index.
   ExtendedFeatures RetrieveAddressFeatures(
       SearchTrieRequest<strings::UniStringDFA> const & request) const;
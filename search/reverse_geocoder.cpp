@@ -3,6 +3,7 @@
 #include "search/city_finder.hpp"
 #include "search/house_to_street_table.hpp"
 #include "search/mwm_context.hpp"
+#include "search/nearby_objects_index.hpp"
 #include "search/region_info_getter.hpp"
 
 #include "storage/country_info_getter.hpp"
@@ -16,12 +17,17 @@
 #include "indexer/ftypes_matcher.hpp"
 #include "indexer/scales.hpp"
 
+#include "base/assert.hpp"
 #include "base/stl_helpers.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <limits>
+#include <map>
+#include <utility>
 
 namespace search
 {
@@ -32,6 +38,9 @@ namespace
 int constexpr kQueryScale = scales::GetUpperScale();
 /// Max number of tries (nearest houses with housenumber) to check when getting point address.
 size_t constexpr kMaxNumTriesToApproxAddress = 10;
+/// Side of the square tiles which group centers of the bulk streets lookup, in lookup radii.
+/// NearbyObjectsIndex is built per tile, so spread-out centers do not make an index of the whole mwm.
+double constexpr kBulkLookupTileSizeInRadii = 8.0;
 
 using AppendStreet = function<void(FeatureType & ft)>;
 using FillStreets =
@@ -101,11 +110,42 @@ vector<ObjT> GetNearbyObjects(search::MwmContext & context, m2::PointD const & c
 vector<ReverseGeocoder::Street> ReverseGeocoder::GetNearbyStreets(
     search::MwmContext & context, m2::PointD const & center, double radiusM)
 {
-  return GetNearbyObjects<Street>(context, center, radiusM, [](FeatureType & ft)
+  return GetNearbyObjects<Street>(context, center, radiusM, &ReverseGeocoder::IsStreetFeature);
+}
+
+vector<vector<ReverseGeocoder::Street>> ReverseGeocoder::GetNearbyStreets(
+    search::MwmContext const & context, vector<m2::PointD> const & centers, double radiusM)
+{
+  if (centers.empty())
+    return {};
+
+  CHECK_GREATER(radiusM, 0.0, ());
+
+  // The tile side is taken at the first center, mercator scale differences only change the
+  // clusters granularity.
+  double const tileSize =
+      kBulkLookupTileSizeInRadii * GetLookupRect(centers.front(), radiusM).SizeX() / 2;
+  map<pair<int64_t, int64_t>, vector<size_t>> tiles;
+  for (size_t i = 0; i < centers.size(); ++i)
   {
-    return ((ft.GetGeomType() == feature::GeomType::Line && ftypes::IsWayChecker::Instance()(ft)) ||
-            ftypes::IsSquareChecker::Instance()(ft));
-  });
+    auto const & center = centers[i];
+    tiles[{static_cast<int64_t>(floor(center.x / tileSize)),
+           static_cast<int64_t>(floor(center.y / tileSize))}]
+        .push_back(i);
+  }
+
+  vector<vector<Street>> streets(centers.size());
+  for (auto const & tile : tiles)
+  {
+    m2::RectD rect;
+    for (auto const i : tile.second)
+      rect.Add(GetLookupRect(centers[i], radiusM));
+
+    NearbyObjectsIndex const index(context, rect, &ReverseGeocoder::IsStreetFeature, radiusM);
+    for (auto const i : tile.second)
+      streets[i] = index.GetNearbyObjects(centers[i], radiusM);
+  }
+  return streets;
 }
 
 vector<ReverseGeocoder::Street> ReverseGeocoder::GetNearbyStreets(
@@ -129,11 +169,21 @@ vector<ReverseGeocoder::Street> ReverseGeocoder::GetNearbyStreets(FeatureType &
 std::vector<ReverseGeocoder::Place> ReverseGeocoder::GetNearbyPlaces(
     search::MwmContext & context, m2::PointD const & center, double radiusM)
 {
-  return GetNearbyObjects<Place>(context, center, radiusM, [](FeatureType & ft)
-  {
-    return (ftypes::IsLocalityChecker::Instance().GetType(ft) >= ftypes::LocalityType::City ||
-            ftypes::IsSuburbChecker::Instance()(ft));
-  });
+  return GetNearbyObjects<Place>(context, center, radiusM, &ReverseGeocoder::IsPlaceFeature);
+}
+
+// static
+bool ReverseGeocoder::IsStreetFeature(FeatureType & ft)
+{
+  return ((ft.GetGeomType() == feature::GeomType::Line && ftypes::IsWayChecker::Instance()(ft)) ||
+          ftypes::IsSquareChecker::Instance()(ft));
+}
+
+// static
+bool ReverseGeocoder::IsPlaceFeature(FeatureType & ft)
+{
+  return (ftypes::IsLocalityChecker::Instance().GetType(ft) >= ftypes::LocalityType::City ||
+          ftypes::IsSuburbChecker::Instance()(ft));
 }
 
 string ReverseGeocoder::GetFeatureStreetName(FeatureType & ft) const
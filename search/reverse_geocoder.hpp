@@ -124,9 +124,21 @@ public:
   std::vector<Street> GetNearbyStreets(MwmSet::MwmId const & id, m2::PointD const & center) const;
   std::vector<Street> GetNearbyStreets(FeatureType & ft) const;
 
+  /// Bulk version of GetNearbyStreets(context, center, radiusM): |centers| are grouped by tiles of
+  /// a few lookup radii and nearby streets of every tile are collected into NearbyObjectsIndex once,
+  /// so features are not read again for every center.
+  /// @return Sorted by distance streets vector for every center of |centers|.
+  static std::vector<std::vector<Street>> GetNearbyStreets(search::MwmContext const & context,
+                                                           std::vector<m2::PointD> const & centers,
+                                                           double radiusM = kLookupRadiusM);
+
   static std::vector<Place> GetNearbyPlaces(
       search::MwmContext & context, m2::PointD const & center, double radiusM);
 
+  /// Filters of GetNearbyStreets and GetNearbyPlaces, features should be named also.
+  static bool IsStreetFeature(FeatureType & ft);
+  static bool IsPlaceFeature(FeatureType & ft);
+
   /// @return feature street name.
   /// Returns empty string when there is no street the feature belongs to.
   std::string GetFeatureStreetName(FeatureType & ft) const;
@@ -5,6 +5,7 @@
 #include "search/emitter.hpp"
 #include "search/intermediate_result.hpp"
 #include "search/model.hpp"
+#include "search/mwm_context.hpp"
 #include "search/pre_ranker.hpp"
 #include "search/ranker.hpp"
 #include "search/search_tests_support/helpers.hpp"
@@ -32,6 +33,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <vector>
 
 namespace pre_ranker_test
@@ -58,6 +60,7 @@ public:
   }
 
   inline bool Finished() const { return m_finished; }
+  void Reset() { m_finished = false; }
 
   // Ranker overrides:
   void AddPreRankerResults(vector<PreRankerResult> && preRankerResults) override
@@ -86,6 +89,87 @@ public:
   base::Cancellable m_cancellable;
 };
 
+// Cafes on the 21x21 grid with the 0.5 step around the origin and the pre-ranker with
+// the batch size much less than the number of the cafes.
+class PreRankerCompactionTest : public PreRankerTest
+{
+public:
+  static size_t constexpr kBatchSize = 10;
+
+  PreRankerCompactionTest()
+    : m_boundariesTable(m_dataSource)
+    , m_villagesCache(m_cancellable)
+    , m_keywordsScorer(0 /* maxLanguageTiers */)
+  {
+    for (int x = -10; x <= 10; ++x)
+    {
+      for (int y = -10; y <= 10; ++y)
+      {
+        m_pois.emplace_back(m2::PointD(x / 2.0, y / 2.0), "cafe", "en");
+        m_pois.back().SetTypes({{"amenity", "cafe"}});
+      }
+    }
+
+    m_mwmId = BuildCountry("Cafeland", [&](TestMwmBuilder & builder)
+    {
+      for (auto const & poi : m_pois)
+        builder.Add(poi);
+    });
+
+    m_ranker = make_unique<TestRanker>(m_dataSource, m_engine.GetCountryInfoGetter(),
+                                       m_boundariesTable, m_keywordsScorer, m_emitter, m_suggests,
+                                       m_villagesCache, m_cancellable, m_pois.size(), m_results);
+    m_preRanker = make_unique<PreRanker>(m_dataSource, *m_ranker);
+
+    // The pivot is not on the grid, so the nearest results are defined without ties.
+    m_params.m_accuratePivotCenter = m2::PointD(0.05, 0.13);
+    m_params.m_viewport = m2::RectD(-5, -5, 5, 5);
+    m_params.m_scale = scales::GetUpperScale();
+    m_params.m_everywhereBatchSize = kBatchSize;
+    m_params.m_limit = m_pois.size();
+    m_params.m_viewportSearch = false;
+  }
+
+  void Init()
+  {
+    m_results.clear();
+    m_ranker->Reset();
+    m_preRanker->Init(m_params);
+  }
+
+  void Emplace(uint32_t index)
+  {
+    ResultTracer::Provenance provenance;
+    m_preRanker->Emplace(FeatureID(m_mwmId, index),
+                         PreRankingInfo(Model::TYPE_SUBPOI, TokenRange(0, 1)), provenance);
+  }
+
+  // Sends the results to the ranker and returns the sorted indices of the selected features.
+  vector<uint32_t> Finish()
+  {
+    m_preRanker->UpdateResults(true /* lastUpdate */);
+    TEST(m_ranker->Finished(), ());
+
+    vector<uint32_t> selected;
+    for (auto const & result : m_results)
+      selected.push_back(result.GetId().m_index);
+    sort(selected.begin(), selected.end());
+    return selected;
+  }
+
+  vector<TestPOI> m_pois;
+  MwmSet::MwmId m_mwmId;
+  PreRanker::Params m_params;
+
+  vector<PreRankerResult> m_results;
+  Emitter m_emitter;
+  CitiesBoundariesTable m_boundariesTable;
+  VillagesCache m_villagesCache;
+  KeywordLangMatcher m_keywordsScorer;
+  unique_ptr<TestRanker> m_ranker;
+  unique_ptr<PreRanker> m_preRanker;
+};
+
 UNIT_CLASS_TEST(PreRankerTest, Smoke)
 {
   // Tests that PreRanker correctly computes distances to pivot when
@@ -168,4 +252,96 @@ UNIT_CLASS_TEST(PreRankerTest, Smoke)
     checked[index] = true;
   }
 }
+
+UNIT_CLASS_TEST(PreRankerCompactionTest, Compaction)
+{
+  // Tests that compaction of the results, which happens when many more results than
+  // the batch size are emplaced, keeps the results nearest to the pivot.
+
+  Init();
+
+  vector<double> distances(m_pois.size());
+
+  FeaturesVectorTest fv(m_mwmId.GetInfo()->GetLocalFile().GetPath(MapFileType::Map));
+  fv.GetVector().ForEach([&](FeatureType & ft, uint32_t index)
+  {
+    Emplace(index);
+
+    TEST_LESS(index, m_pois.size(), ());
+    distances[index] =
+        mercator::DistanceOnEarth(feature::GetCenter(ft), m_params.m_accuratePivotCenter);
+
+    // Results are compacted, so there are never too many of them.
+    TEST_LESS(m_preRanker->Size(), 10 * kBatchSize, ());
+  });
+
+  auto const selected = Finish();
+  TEST_LESS_OR_EQUAL(selected.size(), 3 * kBatchSize, ());
+
+  vector<double> sortedDistances = distances;
+  sort(sortedDistances.begin(), sortedDistances.end());
+  double const maxDistance = sortedDistances[kBatchSize - 1];
+
+  for (size_t i = 0; i < m_pois.size(); ++i)
+  {
+    if (distances[i] <= maxDistance)
+      TEST(binary_search(selected.begin(), selected.end(), i), (i, distances[i]));
+  }
+}
+
+UNIT_CLASS_TEST(PreRankerCompactionTest, CompactionOrder)
+{
+  // Tests that the results selected by rank and by exact match, which tie for all the results
+  // here, don't depend on the order in which the results are emplaced and compacted.
+
+  auto const getSelected = [&](bool reversed)
+  {
+    Init();
+    for (size_t i = 0; i < m_pois.size(); ++i)
+      Emplace(static_cast<uint32_t>(reversed ? m_pois.size() - 1 - i : i));
+    return Finish();
+  };
+
+  auto const selected = getSelected(false /* reversed */);
+  // Far results are selected too, not only the nearest ones.
+  TEST_GREATER(selected.size(), kBatchSize, ());
+  TEST_EQUAL(selected, getSelected(true /* reversed */), ());
+}
+
+UNIT_CLASS_TEST(PreRankerCompactionTest, DistanceCutoff)
+{
+  // Tests that the results of a categorial request skipped by the distance cutoff, as Geocoder
+  // does, don't change the selection.
+
+  m_params.m_categorialRequest = true;
+  m_params.m_position = m_params.m_accuratePivotCenter;
+
+  MwmContext context(m_dataSource.GetMwmHandleById(m_mwmId));
+  auto const getSelected = [&](bool skip, size_t & skipped)
+  {
+    Init();
+    skipped = 0;
+    for (uint32_t i = 0; i < m_pois.size(); ++i)
+    {
+      m2::PointD center;
+      TEST(context.GetCenter(i, center), (i));
+      if (skip && m_preRanker->IsFartherThanCutoff(center, false /* relaxed */))
+      {
+        ++skipped;
+        continue;
+      }
+      Emplace(i);
+    }
+    TEST(m_preRanker->HasDistanceCutoff(false /* relaxed */), ());
+    TEST(!m_preRanker->HasDistanceCutoff(true /* relaxed */), ());
+    return Finish();
+  };
+
+  size_t skipped = 0;
+  auto const selected = getSelected(false /* skip */, skipped);
+  TEST_EQUAL(selected.size(), kBatchSize, ());
+  TEST_EQUAL(selected, getSelected(true /* skip */, skipped), ());
+  TEST_GREATER(skipped, 0, ());
+  TEST(!m_preRanker->HasDistanceCutoff(false /* relaxed */), ());
+}
 } // namespace pre_ranker_test
@@ -13,6 +13,7 @@
 #include "search/features_layer_path_finder.hpp"
 #include "search/mwm_context.hpp"
 #include "search/retrieval.hpp"
+#include "search/reverse_geocoder.hpp"
 #include "search/token_range.hpp"
 #include "search/token_slice.hpp"
 
@@ -23,11 +24,15 @@
 #include "geometry/rect2d.hpp"
 
 #include "base/checked_cast.hpp"
+#include "base/math.hpp"
 #include "base/scope_guard.hpp"
 #include "base/string_utils.hpp"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace processor_test
@@ -430,6 +435,117 @@ UNIT_CLASS_TEST(ProcessorTest, Smoke)
   }
 }
 
+UNIT_CLASS_TEST(ProcessorTest, SearchAsYouType)
+{
+  TestStreet feynmanStreet({{9.999, 9.999}, {10, 10}, {10.001, 10.001}}, "Feynman street", "en");
+  TestStreet bohrStreet({{9.999, 10.001}, {10, 10}, {10.001, 9.999}}, "Bohr street", "en");
+  TestPOI feynmanCafe({10.0005, 10.0005}, "Feynman cafe", "en");
+  TestPOI quantumTeleport({10, 10}, "Quantum teleport", "en");
+  quantumTeleport.SetHouseNumber("3");
+  quantumTeleport.SetStreetName(feynmanStreet.GetName("en"));
+
+  auto const wonderlandId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder)
+  {
+    builder.Add(feynmanStreet);
+    builder.Add(bohrStreet);
+    builder.Add(feynmanCafe);
+    builder.Add(quantumTeleport);
+  });
+
+  SetViewport(m2::RectD(9.9, 9.9, 10.1, 10.1));
+
+  auto const getIds = [](vector<Result> const & results)
+  {
+    vector<FeatureID> ids;
+    for (auto const & r : results)
+    {
+      if (r.GetResultType() == Result::Type::Feature)
+        ids.push_back(r.GetFeatureID());
+    }
+    sort(ids.begin(), ids.end());
+    return ids;
+  };
+
+  // Every keystroke reuses features of the tokens shared with the previous query, results should
+  // be the same as for the query with the cleared caches.
+  for (string const query : {"feynman street 3", "feynman cafe", "bohr street"})
+  {
+    for (size_t i = 1; i <= query.size(); ++i)
+    {
+      string const prefix = query.substr(0, i);
+      auto const typed = getIds(MakeRequest(prefix)->Results());
+      m_engine.ClearCaches();
+      auto const fresh = getIds(MakeRequest(prefix)->Results());
+      TEST_EQUAL(typed, fresh, (prefix));
+    }
+  }
+
+  TEST(ResultsMatch("feynman street 3", {ExactMatch(wonderlandId, quantumTeleport)}), ());
+}
+
+UNIT_CLASS_TEST(ProcessorTest, NearbyStreetsBatch)
+{
+  TestStreet feynmanStreet({{9.999, 9.999}, {10, 10}, {10.001, 10.001}}, "Feynman street", "en");
+  TestStreet bohrStreet({{9.999, 10.001}, {10, 10}, {10.001, 9.999}}, "Bohr street", "en");
+  TestStreet diracStreet({{10.01, 10.0}, {10.02, 10.0}}, "Dirac street", "en");
+  TestStreet unnamedStreet({{10.0, 10.01}, {10.0, 10.02}}, "", "en");
+  TestPOI quantumTeleport({10, 10}, "Quantum teleport", "en");
+
+  auto const wonderlandId = BuildCountry("Wonderland", [&](TestMwmBuilder & builder)
+  {
+    builder.Add(feynmanStreet);
+    builder.Add(bohrStreet);
+    builder.Add(diracStreet);
+    builder.Add(unnamedStreet);
+    builder.Add(quantumTeleport);
+  });
+
+  double constexpr kRadiusM = 500.0;
+  vector<m2::PointD> centers;
+  for (int i = 0; i < 10; ++i)
+  {
+    for (int j = 0; j < 10; ++j)
+      centers.emplace_back(9.998 + 0.003 * i, 9.998 + 0.003 * j);
+  }
+  // Spread-out centers are looked up in their own tiles.
+  centers.emplace_back(9.5, 9.5);
+  centers.emplace_back(10.015, 10.5);
+  centers.emplace_back(10.015, 10.0);
+
+  MwmContext context(m_dataSource.GetMwmHandleById(wonderlandId));
+  auto const batch = ReverseGeocoder::GetNearbyStreets(context, centers, kRadiusM);
+  TEST_EQUAL(batch.size(), centers.size(), ());
+
+  size_t found = 0;
+  for (size_t i = 0; i < centers.size(); ++i)
+  {
+    auto const expected = ReverseGeocoder::GetNearbyStreets(context, centers[i], kRadiusM);
+    // The batch index gives the streets which intersect the lookup rect, the per-center lookup
+    // may give more streets from the same scale index cells.
+    for (auto const & street : batch[i])
+    {
+      auto const it = find_if(expected.begin(), expected.end(),
+                              [&](auto const & s) { return s.m_id == street.m_id; });
+      TEST(it != expected.end(), (street.m_name, centers[i]));
+      TEST_EQUAL(it->m_name, street.m_name, ());
+      TEST(base::AlmostEqualAbs(it->m_distanceMeters, street.m_distanceMeters, 1e-6),
+           (it->m_distanceMeters, street.m_distanceMeters));
+    }
+
+    for (auto const & street : expected)
+    {
+      if (street.m_distanceMeters >= kRadiusM / 2)
+        continue;
+      auto const it = find_if(batch[i].begin(), batch[i].end(),
+                              [&](auto const & s) { return s.m_id == street.m_id; });
+      TEST(it != batch[i].end(), (street.m_name, centers[i]));
+    }
+
+    found += batch[i].size();
+  }
+  TEST_GREATER(found, 0, ());
+}
+
 UNIT_CLASS_TEST(ProcessorTest, SearchInWorld)
 {
   string const countryName = "Wonderland";
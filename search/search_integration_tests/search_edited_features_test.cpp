@@ -79,6 +79,54 @@ UNIT_CLASS_TEST(SearchEditedFeaturesTest, NonamePoi)
   }
 }
 
+UNIT_CLASS_TEST(SearchEditedFeaturesTest, RepeatedQuery)
+{
+  TestCafe cafe(m2::PointD(0, 0), "Bar", "default");
+  auto & editor = osm::Editor::Instance();
+
+  auto const id = BuildCountry("Wonderland", [&](TestMwmBuilder & builder) { builder.Add(cafe); });
+
+  FeatureID cafeId(id, 0 /* index */);
+
+  // Features of the tokens of the previous query are reused by the next one, the edits must not
+  // be hidden by them.
+  TEST(ResultsMatch("Drunken Clam", Rules{}), ());
+  EditFeature(cafeId, [](osm::EditableMapObject & emo) {
+    emo.SetName("The Drunken Clam", StringUtf8Multilang::kEnglishCode);
+  });
+  TEST(ResultsMatch("Drunken Clam", {ExactMatch(id, cafe)}), ());
+
+  auto const created = TestPOI::AddWithEditor(editor, id, "Drunken Clam 2", {0.001, 0.001});
+  TEST(ResultsMatch("Drunken Clam", {ExactMatch(id, cafe), ExactMatch(id, created.first)}), ());
+
+  editor.DeleteFeature(cafeId);
+  TEST(ResultsMatch("Drunken Clam", {ExactMatch(id, created.first)}), ());
+}
+
+UNIT_CLASS_TEST(SearchEditedFeaturesTest, HouseNumber)
+{
+  TestStreet street({{-0.001, -0.001}, {0.001, 0.001}}, "Feynman street", "en");
+  TestBuilding building(m2::PointD(0.0002, 0.0002), "", "1", street.GetName("en"), "en");
+
+  auto const id = BuildCountry("Wonderland", [&](TestMwmBuilder & builder)
+  {
+    builder.Add(street);
+    builder.Add(building);
+  });
+
+  SetViewport({-0.01, -0.01, 0.01, 0.01});
+
+  Rules const rules = {ExactMatch(id, building)};
+  auto request = MakeRequest("Feynman street 1 ");
+  TEST(ResultsMatch(request->Results(), rules), ());
+
+  // House numbers of the matched buildings are cached by the first query.
+  EditFeature(request->Results()[0].GetFeatureID(),
+              [](osm::EditableMapObject & emo) { emo.SetHouseNumber("2"); });
+
+  TEST(ResultsMatch("Feynman street 2 ", rules), ());
+}
+
 UNIT_CLASS_TEST(SearchEditedFeaturesTest, SearchInViewport)
 {
   TestCity city(m2::PointD(0, 0), "Canterlot", "default", 100 /* rank */);
@@ -3,6 +3,7 @@
 #include "search/bookmarks/types.hpp"
 #include "search/filtering_params.hpp"
 #include "search/mode.hpp"
+#include "search/search_stats.hpp"
 
 #include "geometry/point2d.hpp"
 #include "geometry/rect2d.hpp"
@@ -33,6 +34,7 @@ struct SearchParams
 
   using OnStarted = std::function<void()>;
   using OnResults = std::function<void(Results const &)>;
+  using OnStats = std::function<void(SearchStats const &)>;
 
   bool IsEqualCommon(SearchParams const & rhs) const;
 
@@ -59,6 +61,10 @@ struct SearchParams
   // the search may decide against duplicating calls but no guarantees are given.
   OnResults m_onResults;
 
+  // Called once after the search is finished with the timings of the search stages and
+  // the hot paths counters. The stats are collected only when this callback is set.
+  OnStats m_onStats;
+
   std::string m_query;
   std::string m_inputLocale;
 
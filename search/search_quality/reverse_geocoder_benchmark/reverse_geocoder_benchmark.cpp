@@ -0,0 +1,193 @@
+#include "search/search_quality/helpers.hpp"
+
+#include "search/mwm_context.hpp"
+#include "search/reverse_geocoder.hpp"
+
+#include "indexer/classificator_loader.hpp"
+#include "indexer/data_source.hpp"
+#include "indexer/feature_algo.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "platform/platform_tests_support/helpers.hpp"
+
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+DEFINE_string(data_path, "", "Path to data directory (resources dir).");
+DEFINE_string(mwm_path, "", "Path to mwm files (writable dir).");
+DEFINE_string(mwm_list_path, "", "Path to a file containing the names of the mwms to be processed.");
+DEFINE_uint64(points_per_mwm, 10000, "Number of points to reverse geocode in each mwm.");
+DEFINE_double(radius, search::ReverseGeocoder::kLookupRadiusM, "Lookup radius (meters).");
+DEFINE_uint64(seed, 42, "Seed of the random points.");
+
+using namespace search::search_quality;
+using namespace search;
+using namespace std;
+
+namespace
+{
+// Spread-out points are the centers of random features, so they are distributed over the whole mwm
+// like the real addresses.
+vector<m2::PointD> GetSpreadPoints(DataSource const & dataSource, MwmSet::MwmId const & mwmId,
+                                   size_t count, mt19937 & rnd)
+{
+  vector<m2::PointD> points;
+  FeaturesLoaderGuard guard(dataSource, mwmId);
+  auto const featuresCount = static_cast<uint32_t>(guard.GetNumFeatures());
+  if (featuresCount == 0)
+    return points;
+
+  uniform_int_distribution<uint32_t> dist(0, featuresCount - 1);
+  points.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    auto ft = guard.GetFeatureByIndex(dist(rnd));
+    if (ft)
+      points.push_back(feature::GetCenter(*ft));
+  }
+
+  sort(points.begin(), points.end());
+  return points;
+}
+
+// Track points are a random walk from the first spread-out point with steps of a quarter of
+// the lookup radius, like a batch of GPS points where close points follow each other.
+vector<m2::PointD> GetTrackPoints(vector<m2::PointD> const & spreadPoints, double radiusM,
+                                  mt19937 & rnd)
+{
+  vector<m2::PointD> points;
+  if (spreadPoints.empty())
+    return points;
+
+  uniform_real_distribution<double> dist(-1.0, 1.0);
+  points.reserve(spreadPoints.size());
+  points.push_back(spreadPoints.front());
+  while (points.size() < spreadPoints.size())
+  {
+    auto point = points.back();
+    double const step = mercator::RectByCenterXYAndSizeInMeters(point, radiusM / 4).SizeX() / 2;
+    point.x += dist(rnd) * step;
+    point.y += dist(rnd) * step;
+    mercator::ClampPoint(point);
+    points.push_back(point);
+  }
+  return points;
+}
+
+void PrintSpeed(string const & name, size_t pointsCount, size_t streetsCount, double seconds)
+{
+  cout << fixed << setprecision(3) << name << ": " << pointsCount << " points in " << seconds
+       << " seconds, " << (seconds > 0 ? pointsCount / seconds : 0.0) << " points/second, "
+       << streetsCount << " streets" << endl;
+}
+
+struct Stats
+{
+  void Add(Stats const & rhs)
+  {
+    m_points += rhs.m_points;
+    m_perPointStreets += rhs.m_perPointStreets;
+    m_bulkStreets += rhs.m_bulkStreets;
+    m_perPointS += rhs.m_perPointS;
+    m_bulkS += rhs.m_bulkS;
+  }
+
+  void Print(string const & name) const
+  {
+    cout << "  " << name << endl;
+    PrintSpeed("    Per point", m_points, m_perPointStreets, m_perPointS);
+    PrintSpeed("    Bulk", m_points, m_bulkStreets, m_bulkS);
+  }
+
+  size_t m_points = 0;
+  size_t m_perPointStreets = 0;
+  size_t m_bulkStreets = 0;
+  double m_perPointS = 0.0;
+  double m_bulkS = 0.0;
+};
+
+Stats Run(MwmContext & context, vector<m2::PointD> const & points, double radiusM)
+{
+  Stats stats;
+  stats.m_points = points.size();
+
+  base::Timer timer;
+  for (auto const & point : points)
+    stats.m_perPointStreets += ReverseGeocoder::GetNearbyStreets(context, point, radiusM).size();
+  stats.m_perPointS = timer.ElapsedSeconds();
+
+  timer.Reset();
+  for (auto const & streets : ReverseGeocoder::GetNearbyStreets(context, points, radiusM))
+    stats.m_bulkStreets += streets.size();
+  stats.m_bulkS = timer.ElapsedSeconds();
+  return stats;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  platform::tests_support::ChangeMaxNumberOfOpenFiles(kMaxOpenFiles);
+
+  gflags::SetUsageMessage(
+      "Benchmark of the per point and the bulk ReverseGeocoder::GetNearbyStreets.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  SetPlatformDirs(FLAGS_data_path, FLAGS_mwm_path);
+
+  classificator::Load();
+  FrozenDataSource dataSource;
+  InitDataSource(dataSource, FLAGS_mwm_list_path);
+
+  mt19937 rnd(static_cast<mt19937::result_type>(FLAGS_seed));
+
+  Stats totalSpread;
+  Stats totalTrack;
+
+  vector<shared_ptr<MwmInfo>> mwmInfos;
+  dataSource.GetMwmsInfo(mwmInfos);
+  for (auto const & mwmInfo : mwmInfos)
+  {
+    MwmSet::MwmId const mwmId(mwmInfo);
+    auto handle = dataSource.GetMwmHandleById(mwmId);
+    // WorldCoasts.
+    if (!handle.GetValue()->HasSearchIndex())
+      continue;
+
+    auto const spreadPoints = GetSpreadPoints(dataSource, mwmId, FLAGS_points_per_mwm, rnd);
+    if (spreadPoints.empty())
+      continue;
+    auto const trackPoints = GetTrackPoints(spreadPoints, FLAGS_radius, rnd);
+
+    MwmContext context(std::move(handle));
+
+    LOG(LINFO, ("Processing", mwmId));
+
+    auto const spread = Run(context, spreadPoints, FLAGS_radius);
+    auto const track = Run(context, trackPoints, FLAGS_radius);
+
+    cout << mwmInfo->GetCountryName() << endl;
+    spread.Print("Spread-out points");
+    track.Print("Track points");
+
+    totalSpread.Add(spread);
+    totalTrack.Add(track);
+  }
+
+  cout << "Total" << endl;
+  totalSpread.Print("Spread-out points");
+  totalTrack.Print("Track points");
+  return EXIT_SUCCESS;
+}
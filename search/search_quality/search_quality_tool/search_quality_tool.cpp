@@ -6,9 +6,11 @@
 #include "search/ranking_info.hpp"
 #include "search/result.hpp"
 #include "search/search_params.hpp"
+#include "search/search_stats.hpp"
 
 #include "indexer/classificator_loader.hpp"
 #include "indexer/data_source.hpp"
+#include "indexer/feature_cache.hpp"
 #include "indexer/mwm_set.hpp"
 
 #include "platform/platform_tests_support/helpers.hpp"
@@ -58,6 +60,9 @@ DEFINE_int32(top, 1, "Number of top results to show for every query");
 DEFINE_string(viewport, "", "Viewport to use when searching (default, moscow, london, zurich)");
 DEFINE_string(check_completeness, "", "Path to the file with completeness data");
 DEFINE_string(ranking_csv_file, "", "File ranking info will be exported to");
+DEFINE_string(stats_path, "",
+              "File per query stats will be exported to as JSON lines, the last line is the histogram");
+DEFINE_int32(feature_cache_mb, 0, "Size of the shared feature cache in MB, 0 disables the cache");
 
 string const kDefaultQueriesPathSuffix =
     "/../search/search_quality/search_quality_tool/queries.txt";
@@ -290,7 +295,8 @@ void CheckCompleteness(string const & path, DataSource & dataSource, TestSearchE
 }
 
 void RunRequests(TestSearchEngine & engine, m2::RectD const & viewport, string queriesPath,
-                 string const & locale, string const & rankingCSVFile, size_t top)
+                 string const & locale, string const & rankingCSVFile, string const & statsFile,
+                 size_t top)
 {
   vector<string> queries;
   {
@@ -324,6 +330,21 @@ void RunRequests(TestSearchEngine & engine, m2::RectD const & viewport, string q
     csv << endl;
   }
 
+  ofstream stats;
+  if (!statsFile.empty())
+  {
+    stats.open(statsFile);
+    if (!stats.is_open())
+      LOG(LERROR, ("Can't open file for stats dump:", statsFile));
+  }
+
+  if (stats.is_open())
+  {
+    for (auto & request : requests)
+      request->EnableStats();
+  }
+  SearchStatsHistogram histogram;
+
   vector<double> responseTimes(queries.size());
   for (size_t i = 0; i < queries.size(); ++i)
   {
@@ -340,6 +361,27 @@ void RunRequests(TestSearchEngine & engine, m2::RectD const & viewport, string q
         csv << endl;
       }
     }
+
+    if (stats.is_open())
+    {
+      auto const & requestStats = requests[i]->Stats();
+      stats << requestStats.ToJSON() << endl;
+      histogram.Add(requestStats);
+    }
+  }
+
+  if (stats.is_open())
+  {
+    stats << histogram.ToJSON() << endl;
+
+    cout << endl;
+    for (auto const stage : {SearchStats::Stage::Total, SearchStats::Stage::Geocoding,
+                             SearchStats::Stage::Retrieval, SearchStats::Stage::PathFinding,
+                             SearchStats::Stage::PreRanking, SearchStats::Stage::Ranking})
+    {
+      cout << DebugPrint(stage) << " p50 <= " << histogram.GetQuantileMs(stage, 0.5)
+           << "ms, p99 <= " << histogram.GetQuantileMs(stage, 0.99) << "ms" << endl;
+    }
   }
 
   double averageTime;
@@ -367,6 +409,9 @@ int main(int argc, char * argv[])
 
   classificator::Load();
 
+  if (FLAGS_feature_cache_mb > 0)
+    FeatureCache::Instance().SetBudget(static_cast<size_t>(FLAGS_feature_cache_mb) * 1024 * 1024);
+
   FrozenDataSource dataSource;
   InitDataSource(dataSource, FLAGS_mwm_list_path);
 
@@ -385,6 +430,9 @@ int main(int argc, char * argv[])
   }
 
   RunRequests(*engine, viewport, FLAGS_queries_path, FLAGS_locale, FLAGS_ranking_csv_file,
-              static_cast<size_t>(FLAGS_top));
+              FLAGS_stats_path, static_cast<size_t>(FLAGS_top));
+
+  if (FeatureCache::Instance().IsEnabled())
+    cout << DebugPrint(FeatureCache::Instance().GetStats()) << endl;
   return 0;
 }
@@ -0,0 +1,171 @@
+#include "search/search_stats.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace search
+{
+using namespace std;
+
+namespace
+{
+uint64_t ToMicroseconds(SearchStats::Clock::duration d)
+{
+  return static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(d).count());
+}
+
+template <typename Enum, typename Fn>
+void ForEachEnum(Enum count, Fn && fn)
+{
+  for (size_t i = 0; i < static_cast<size_t>(count); ++i)
+    fn(static_cast<Enum>(i));
+}
+}  // namespace
+
+// SearchStats::ScopedTimer ------------------------------------------------------------------------
+SearchStats::ScopedTimer::ScopedTimer(SearchStats * stats, Stage stage)
+  : m_stats(stats && stats->m_enabled ? stats : nullptr), m_stage(stage)
+{
+  if (m_stats)
+    m_start = Clock::now();
+}
+
+SearchStats::ScopedTimer::~ScopedTimer()
+{
+  if (m_stats)
+    m_stats->m_times[static_cast<size_t>(m_stage)] += Clock::now() - m_start;
+}
+
+// SearchStats -------------------------------------------------------------------------------------
+void SearchStats::Reset(bool enabled)
+{
+  m_enabled = enabled;
+  m_times.fill(Clock::duration::zero());
+  m_counters.fill(0);
+  m_layerFeatures.fill(0);
+}
+
+string SearchStats::ToJSON() const
+{
+  ostringstream os;
+  os << "{\"timesUs\":{";
+  ForEachEnum(Stage::Count, [&](Stage stage)
+  {
+    if (stage != Stage::Total)
+      os << ',';
+    os << '"' << DebugPrint(stage) << "\":" << ToMicroseconds(GetTime(stage));
+  });
+
+  os << "},\"counters\":{";
+  ForEachEnum(Counter::Count, [&](Counter counter)
+  {
+    if (counter != Counter::Mwms)
+      os << ',';
+    os << '"' << DebugPrint(counter) << "\":" << GetCount(counter);
+  });
+
+  os << "},\"layerFeatures\":{";
+  bool first = true;
+  ForEachEnum(Model::TYPE_COUNT, [&](Model::Type type)
+  {
+    if (GetLayerFeatures(type) == 0)
+      return;
+    if (!first)
+      os << ',';
+    first = false;
+    os << '"' << DebugPrint(type) << "\":" << GetLayerFeatures(type);
+  });
+  os << "}}";
+  return os.str();
+}
+
+// SearchStatsHistogram ----------------------------------------------------------------------------
+void SearchStatsHistogram::Add(SearchStats const & stats)
+{
+  ++m_queriesCount;
+  ForEachEnum(SearchStats::Stage::Count, [&](SearchStats::Stage stage)
+  {
+    auto const ms = chrono::duration_cast<chrono::milliseconds>(stats.GetTime(stage)).count();
+    size_t bucket = 0;
+    while (bucket + 1 < kBucketsCount && (int64_t{1} << bucket) <= ms)
+      ++bucket;
+    ++m_buckets[static_cast<size_t>(stage)][bucket];
+  });
+}
+
+uint64_t SearchStatsHistogram::GetBucket(SearchStats::Stage stage, size_t bucket) const
+{
+  CHECK_LESS(bucket, kBucketsCount, ());
+  return m_buckets[static_cast<size_t>(stage)][bucket];
+}
+
+double SearchStatsHistogram::GetQuantileMs(SearchStats::Stage stage, double p) const
+{
+  ASSERT(p >= 0.0 && p <= 1.0, (p));
+  auto const & buckets = m_buckets[static_cast<size_t>(stage)];
+  auto const needed = static_cast<uint64_t>(p * m_queriesCount);
+  uint64_t count = 0;
+  for (size_t i = 0; i < kBucketsCount; ++i)
+  {
+    count += buckets[i];
+    if (count > needed || count == m_queriesCount)
+      return static_cast<double>(uint64_t{1} << i);
+  }
+  return static_cast<double>(uint64_t{1} << (kBucketsCount - 1));
+}
+
+string SearchStatsHistogram::ToJSON() const
+{
+  ostringstream os;
+  os << "{\"queries\":" << m_queriesCount << ",\"bucketsMs\":{";
+  ForEachEnum(SearchStats::Stage::Count, [&](SearchStats::Stage stage)
+  {
+    if (stage != SearchStats::Stage::Total)
+      os << ',';
+    os << '"' << DebugPrint(stage) << "\":[";
+    auto const & buckets = m_buckets[static_cast<size_t>(stage)];
+    for (size_t i = 0; i < kBucketsCount; ++i)
+      os << (i == 0 ? "" : ",") << buckets[i];
+    os << ']';
+  });
+  os << "}}";
+  return os.str();
+}
+
+string DebugPrint(SearchStats::Stage stage)
+{
+  switch (stage)
+  {
+  case SearchStats::Stage::Total: return "Total";
+  case SearchStats::Stage::Geocoding: return "Geocoding";
+  case SearchStats::Stage::Retrieval: return "Retrieval";
+  case SearchStats::Stage::PathFinding: return "PathFinding";
+  case SearchStats::Stage::PreRanking: return "PreRanking";
+  case SearchStats::Stage::Ranking: return "Ranking";
+  case SearchStats::Stage::Count: return "Count";
+  }
+  UNREACHABLE();
+}
+
+string DebugPrint(SearchStats::Counter counter)
+{
+  switch (counter)
+  {
+  case SearchStats::Counter::Mwms: return "Mwms";
+  case SearchStats::Counter::RetrievedFeatures: return "RetrievedFeatures";
+  case SearchStats::Counter::TokenCacheHits: return "TokenCacheHits";
+  case SearchStats::Counter::TokenCacheMisses: return "TokenCacheMisses";
+  case SearchStats::Counter::Intersections: return "Intersections";
+  case SearchStats::Counter::PreRankerCandidates: return "PreRankerCandidates";
+  case SearchStats::Counter::PreRankerSkipped: return "PreRankerSkipped";
+  case SearchStats::Counter::RankerCandidates: return "RankerCandidates";
+  case SearchStats::Counter::Results: return "Results";
+  case SearchStats::Counter::Count: return "Count";
+  }
+  UNREACHABLE();
+}
+
+string DebugPrint(SearchStats const & stats) { return stats.ToJSON(); }
+}  // namespace search
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "search/model.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace search
+{
+// Timings of the search stages and counters of the hot paths collected for a single query.
+// Collecting is switched off by default, the disabled stats cost a branch per call.
+class SearchStats
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Stages may be nested, e.g. Retrieval and PathFinding are parts of Geocoding,
+  // the nested time is not subtracted.
+  enum class Stage
+  {
+    Total,
+    Geocoding,
+    Retrieval,
+    PathFinding,
+    PreRanking,
+    Ranking,
+    Count
+  };
+
+  enum class Counter
+  {
+    // Number of the mwms processed by Geocoder.
+    Mwms,
+    // Number of features retrieved for all the tokens in all the mwms.
+    RetrievedFeatures,
+    TokenCacheHits,
+    TokenCacheMisses,
+    // Number of the intersections of the layers found by the path finder.
+    Intersections,
+    PreRankerCandidates,
+    // Number of the results skipped by Geocoder as farther than the pre-ranker distance cutoff.
+    PreRankerSkipped,
+    RankerCandidates,
+    Results,
+    Count
+  };
+
+  // Measures time of |stage| in the scope. Does nothing for the null or the disabled stats.
+  class ScopedTimer
+  {
+  public:
+    ScopedTimer(SearchStats * stats, Stage stage);
+    ~ScopedTimer();
+
+  private:
+    SearchStats * m_stats;
+    Stage m_stage;
+    Clock::time_point m_start;
+  };
+
+  // Clears the stats and enables (disables) collecting.
+  void Reset(bool enabled);
+  bool IsEnabled() const { return m_enabled; }
+
+  static void Add(SearchStats * stats, Counter counter, uint64_t value = 1)
+  {
+    if (stats && stats->m_enabled)
+      stats->m_counters[static_cast<size_t>(counter)] += value;
+  }
+
+  // Number of features of |type| in the layers passed to the path finder.
+  static void AddLayerFeatures(SearchStats * stats, Model::Type type, uint64_t value)
+  {
+    if (stats && stats->m_enabled)
+      stats->m_layerFeatures[static_cast<size_t>(type)] += value;
+  }
+
+  Clock::duration GetTime(Stage stage) const { return m_times[static_cast<size_t>(stage)]; }
+  uint64_t GetCount(Counter counter) const { return m_counters[static_cast<size_t>(counter)]; }
+  uint64_t GetLayerFeatures(Model::Type type) const
+  {
+    return m_layerFeatures[static_cast<size_t>(type)];
+  }
+
+  // Returns the stats as a single line JSON object, times are in microseconds.
+  std::string ToJSON() const;
+
+private:
+  bool m_enabled = false;
+  std::array<Clock::duration, static_cast<size_t>(Stage::Count)> m_times = {};
+  std::array<uint64_t, static_cast<size_t>(Counter::Count)> m_counters = {};
+  std::array<uint64_t, Model::TYPE_COUNT> m_layerFeatures = {};
+};
+
+// Aggregates stage timings of many queries into histograms with power of two buckets
+// in milliseconds: [0, 1), [1, 2), [2, 4), ... The last bucket is unbounded.
+class SearchStatsHistogram
+{
+public:
+  static size_t constexpr kBucketsCount = 16;
+
+  void Add(SearchStats const & stats);
+
+  uint64_t GetQueriesCount() const { return m_queriesCount; }
+  uint64_t GetBucket(SearchStats::Stage stage, size_t bucket) const;
+
+  // Returns the upper bound of the bucket which contains the |p|-th quantile of |stage| times,
+  // |p| is in [0, 1].
+  double GetQuantileMs(SearchStats::Stage stage, double p) const;
+
+  std::string ToJSON() const;
+
+private:
+  using Buckets = std::array<uint64_t, kBucketsCount>;
+
+  std::array<Buckets, static_cast<size_t>(SearchStats::Stage::Count)> m_buckets = {};
+  uint64_t m_queriesCount = 0;
+};
+
+std::string DebugPrint(SearchStats::Stage stage);
+std::string DebugPrint(SearchStats::Counter counter);
+std::string DebugPrint(SearchStats const & stats);
+}  // namespace search
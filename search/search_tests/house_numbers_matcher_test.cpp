@@ -18,14 +18,28 @@ bool HouseNumbersMatch(string const & houseNumber, string const & query, bool qu
 {
   vector<Token> queryParse;
   ParseQuery(MakeUniString(query), queryIsPrefix, queryParse);
-  return search::house_numbers::HouseNumbersMatch(MakeUniString(houseNumber), queryParse);
+  bool const res = search::house_numbers::HouseNumbersMatch(MakeUniString(houseNumber), queryParse);
+
+  // Precomputed parses of the house number should give the same result.
+  vector<vector<Token>> houseNumberParses;
+  ParseHouseNumber(MakeUniString(houseNumber), houseNumberParses);
+  TEST_EQUAL(res, search::house_numbers::HouseNumbersMatch(houseNumberParses, queryParse),
+             (houseNumber, query));
+  return res;
 }
 
 bool HouseNumbersMatchConscription(string const & houseNumber, string const & query, bool queryIsPrefix = false)
 {
   vector<Token> queryParse;
   ParseQuery(MakeUniString(query), queryIsPrefix, queryParse);
-  return search::house_numbers::HouseNumbersMatchConscription(MakeUniString(houseNumber), queryParse);
+  bool const res =
+      search::house_numbers::HouseNumbersMatchConscription(MakeUniString(houseNumber), queryParse);
+
+  vector<vector<Token>> houseNumberParses;
+  ParseHouseNumberConscription(MakeUniString(houseNumber), houseNumberParses);
+  TEST_EQUAL(res, search::house_numbers::HouseNumbersMatch(houseNumberParses, queryParse),
+             (houseNumber, query));
+  return res;
 }
 
 bool HouseNumbersMatchRange(string_view const & hnRange, string const & query, feature::InterpolType interpol)
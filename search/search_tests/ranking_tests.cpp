@@ -297,5 +297,15 @@ UNIT_TEST(PreRanker_ForEachMwmOrder)
     std::vector<MwmIdWrapper> test{id1, id2, id1, id3, id2};
     TEST_EQUAL(3, UniqueMwmIdCount(test), ());
   }
+
+  {
+    std::vector<MwmIdWrapper> test{id1, id2, id1, id3, id2};
+    std::vector<MwmSet::MwmId> order;
+    PreRanker::ForEachMwmOrder(test, 2 /* first */, [&](MwmIdWrapper & w)
+    {
+      order.push_back(w.GetId().m_mwmId);
+    });
+    TEST_EQUAL(order, std::vector<MwmSet::MwmId>({id1, id3, id2}), ());
+  }
 }
 } // namespace ranking_tests
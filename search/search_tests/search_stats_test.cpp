@@ -0,0 +1,75 @@
+#include "testing/testing.hpp"
+
+#include "search/model.hpp"
+#include "search/search_stats.hpp"
+
+#include <string>
+
+namespace search_stats_test
+{
+using namespace search;
+using namespace std;
+
+bool Contains(string const & s, string const & sub) { return s.find(sub) != string::npos; }
+
+UNIT_TEST(SearchStats_Disabled)
+{
+  SearchStats stats;
+  stats.Reset(false /* enabled */);
+  {
+    SearchStats::ScopedTimer const timer(&stats, SearchStats::Stage::Total);
+    SearchStats::Add(&stats, SearchStats::Counter::Results, 10);
+    SearchStats::AddLayerFeatures(&stats, Model::TYPE_STREET, 5);
+  }
+
+  TEST_EQUAL(stats.GetTime(SearchStats::Stage::Total).count(), 0, ());
+  TEST_EQUAL(stats.GetCount(SearchStats::Counter::Results), 0, ());
+  TEST_EQUAL(stats.GetLayerFeatures(Model::TYPE_STREET), 0, ());
+
+  // Null stats are allowed too.
+  SearchStats::Add(nullptr, SearchStats::Counter::Results);
+  SearchStats::ScopedTimer const timer(nullptr, SearchStats::Stage::Total);
+}
+
+UNIT_TEST(SearchStats_Smoke)
+{
+  SearchStats stats;
+  stats.Reset(true /* enabled */);
+  SearchStats::Add(&stats, SearchStats::Counter::Mwms);
+  SearchStats::Add(&stats, SearchStats::Counter::Mwms);
+  SearchStats::Add(&stats, SearchStats::Counter::Results, 7);
+  SearchStats::AddLayerFeatures(&stats, Model::TYPE_BUILDING, 3);
+
+  TEST_EQUAL(stats.GetCount(SearchStats::Counter::Mwms), 2, ());
+  TEST_EQUAL(stats.GetCount(SearchStats::Counter::Results), 7, ());
+  TEST_EQUAL(stats.GetLayerFeatures(Model::TYPE_BUILDING), 3, ());
+
+  auto const json = stats.ToJSON();
+  TEST(Contains(json, "\"Total\":"), (json));
+  TEST(Contains(json, "\"PathFinding\":"), (json));
+  TEST(Contains(json, "\"Mwms\":2"), (json));
+  TEST(Contains(json, "\"Results\":7"), (json));
+  TEST(Contains(json, "\"layerFeatures\":{\"Building\":3}"), (json));
+
+  stats.Reset(true /* enabled */);
+  TEST_EQUAL(stats.GetCount(SearchStats::Counter::Mwms), 0, ());
+  TEST_EQUAL(stats.ToJSON().find("Building"), string::npos, ());
+}
+
+UNIT_TEST(SearchStatsHistogram_Smoke)
+{
+  SearchStats stats;
+  stats.Reset(true /* enabled */);
+
+  SearchStatsHistogram histogram;
+  for (size_t i = 0; i < 10; ++i)
+    histogram.Add(stats);
+
+  TEST_EQUAL(histogram.GetQueriesCount(), 10, ());
+  TEST_EQUAL(histogram.GetBucket(SearchStats::Stage::Total, 0), 10, ());
+  TEST_EQUAL(histogram.GetBucket(SearchStats::Stage::Total, 1), 0, ());
+  TEST_EQUAL(histogram.GetQuantileMs(SearchStats::Stage::Total, 0.5), 1.0, ());
+  TEST_EQUAL(histogram.GetQuantileMs(SearchStats::Stage::Total, 1.0), 1.0, ());
+  TEST(Contains(histogram.ToJSON(), "\"queries\":10"), ());
+}
+}  // namespace search_stats_test
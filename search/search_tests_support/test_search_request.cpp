@@ -52,6 +52,15 @@ TestSearchRequest::TestSearchRequest(TestSearchEngine & engine, string const & q
   SetUpResultParams();
 }
 
+void TestSearchRequest::EnableStats()
+{
+  m_params.m_onStats = [this](SearchStats const & stats)
+  {
+    lock_guard<mutex> lock(m_mu);
+    m_stats = stats;
+  };
+}
+
 void TestSearchRequest::Run()
 {
   Start();
@@ -72,6 +81,13 @@ vector<search::Result> const & TestSearchRequest::Results() const
   return m_results;
 }
 
+SearchStats const & TestSearchRequest::Stats() const
+{
+  lock_guard<mutex> lock(m_mu);
+  CHECK(m_done, ("This function may be called only when request is processed."));
+  return m_stats;
+}
+
 void TestSearchRequest::Start()
 {
   m_engine.Search(m_params);
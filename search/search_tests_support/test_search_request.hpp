@@ -31,6 +31,9 @@ public:
 
   void SetCategorial() { m_params.m_categorialRequest = true; }
 
+  // Makes the engine collect stats of the request, see SearchParams::m_onStats.
+  void EnableStats();
+
   // Initiates the search and waits for it to finish.
   void Run();
 
@@ -44,6 +47,7 @@ public:
   using TimeDurationT = base::Timer::DurationT;
   TimeDurationT ResponseTime() const;
   std::vector<search::Result> const & Results() const;
+  SearchStats const & Stats() const;
 
 protected:
   TestSearchRequest(TestSearchEngine & engine, std::string const & query,
@@ -64,6 +68,7 @@ protected:
   mutable std::mutex m_mu;
 
   std::vector<search::Result> m_results;
+  SearchStats m_stats;
   bool m_done = false;
 
   base::Timer m_timer;
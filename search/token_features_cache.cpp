@@ -0,0 +1,27 @@
+#include "search/token_features_cache.hpp"
+
+namespace search
+{
+void TokenFeaturesCache::OnQueryStarted()
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (it->second.m_used)
+    {
+      it->second.m_used = false;
+      ++it;
+    }
+    else
+    {
+      it = m_entries.erase(it);
+    }
+  }
+}
+
+void TokenFeaturesCache::Clear()
+{
+  m_entries.clear();
+  m_hitsCount = 0;
+  m_missesCount = 0;
+}
+}  // namespace search
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "search/retrieval.hpp"
+
+#include "indexer/mwm_set.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace search
+{
+// This class keeps features retrieved for the query tokens in all mwms during the current and
+// the previous queries. While the user types, successive queries share all the tokens but
+// the last one, so only features of the changed token are retrieved on every keystroke.
+// The features are keyed by the token string (see QueryParams), so a token which
+// turns from a prefix into a full one is retrieved again.
+//
+// *NOTE* This class is not thread-safe.
+class TokenFeaturesCache
+{
+public:
+  using Features = Retrieval::ExtendedFeatures;
+
+  // Returns features of the token |key| in the mwm |id|. Calls |fn| to retrieve them when they are
+  // not cached.
+  template <typename Fn>
+  Features Get(MwmSet::MwmId const & id, std::string const & key, Fn && fn)
+  {
+    auto it = m_entries.find(std::make_pair(id, key));
+    if (it != m_entries.end())
+    {
+      ++m_hitsCount;
+      it->second.m_used = true;
+      return it->second.m_features;
+    }
+
+    ++m_missesCount;
+    Features features = fn();
+    m_entries.emplace(std::make_pair(id, key), Entry{features, true /* used */});
+    return features;
+  }
+
+  // Removes features which were not used by the previous query. Should be called when a new query
+  // starts.
+  void OnQueryStarted();
+
+  void Clear();
+
+  uint64_t GetHitsCount() const { return m_hitsCount; }
+  uint64_t GetMissesCount() const { return m_missesCount; }
+
+private:
+  struct Entry
+  {
+    Features m_features;
+    bool m_used = false;
+  };
+
+  std::map<std::pair<MwmSet::MwmId, std::string>, Entry> m_entries;
+  uint64_t m_hitsCount = 0;
+  uint64_t m_missesCount = 0;
+};
+}  // namespace search
@@ -0,0 +1,279 @@
+#include "track_analyzing/hmm_matcher.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+namespace track_analyzing
+{
+using namespace routing;
+using namespace std;
+
+namespace
+{
+double constexpr kInf = numeric_limits<double>::infinity();
+}  // namespace
+
+HmmMatcher::HmmMatcher(Graph & graph, Params const & params, MatchedPointFn && fn)
+  : m_graph(graph), m_params(params), m_fn(std::move(fn))
+{
+  CHECK_GREATER(m_params.m_sigmaM, 0.0, ());
+  CHECK_GREATER(m_params.m_betaM, 0.0, ());
+  CHECK_GREATER(m_params.m_maxCandidatesNumber, 0, ());
+  CHECK_GREATER(m_params.m_maxLag, 0, ());
+  CHECK(m_fn, ());
+}
+
+void HmmMatcher::Push(DataPoint const & dataPoint)
+{
+  ++m_pointsCount;
+
+  Step step;
+  step.m_dataPoint = dataPoint;
+  step.m_point = mercator::FromLatLon(dataPoint.m_latLon);
+
+  vector<Candidate> candidates;
+  m_graph.GetCandidates(step.m_point, m_params.m_maxCandidateDistanceM, candidates);
+  if (candidates.empty())
+  {
+    // The point is skipped, the next one is connected to the previous matched point.
+    ++m_nonMatchedPointsCount;
+    return;
+  }
+
+  sort(candidates.begin(), candidates.end(), [](Candidate const & lhs, Candidate const & rhs) {
+    return lhs.m_distanceM < rhs.m_distanceM;
+  });
+  if (candidates.size() > m_params.m_maxCandidatesNumber)
+    candidates.resize(m_params.m_maxCandidatesNumber);
+
+  step.m_states.reserve(candidates.size());
+  for (auto const & candidate : candidates)
+    step.m_states.push_back({candidate, -kInf, kNoPrev});
+
+  bool connected = false;
+  if (!m_window.empty())
+  {
+    Step const & prevStep = m_window.back();
+    double const straightM = mercator::DistanceOnEarth(prevStep.m_point, step.m_point);
+    double const maxRouteM = straightM * m_params.m_maxRouteFactor + m_params.m_maxRouteExtraM;
+
+    vector<double> routeDistances;
+    for (size_t i = 0; i < prevStep.m_states.size(); ++i)
+    {
+      State const & prevState = prevStep.m_states[i];
+      if (!prevState.IsAlive())
+        continue;
+
+      GetRouteDistances(prevState.m_candidate, step.m_states, maxRouteM, routeDistances);
+      for (size_t j = 0; j < step.m_states.size(); ++j)
+      {
+        if (routeDistances[j] == kInf)
+          continue;
+
+        State & state = step.m_states[j];
+        double const logProb = prevState.m_logProb + GetEmissionLogProb(state.m_candidate) -
+                               fabs(routeDistances[j] - straightM) / m_params.m_betaM;
+        if (logProb > state.m_logProb)
+        {
+          state.m_logProb = logProb;
+          state.m_prev = i;
+          connected = true;
+        }
+      }
+    }
+
+    if (!connected)
+      Flush();
+  }
+
+  if (!connected)
+  {
+    ++m_tracksCount;
+    for (auto & state : step.m_states)
+      state.m_logProb = GetEmissionLogProb(state.m_candidate);
+  }
+
+  // Probabilities are normalized to keep them in double range on long tracks.
+  double maxLogProb = -kInf;
+  for (auto const & state : step.m_states)
+    maxLogProb = max(maxLogProb, state.m_logProb);
+  for (auto & state : step.m_states)
+  {
+    if (state.IsAlive())
+      state.m_logProb -= maxLogProb;
+  }
+
+  m_window.push_back(std::move(step));
+  MatchDecided();
+}
+
+void HmmMatcher::Flush()
+{
+  if (m_window.empty())
+    return;
+
+  vector<size_t> path(m_window.size());
+  path.back() = GetBestBackState();
+  for (size_t i = m_window.size() - 1; i > 0; --i)
+    path[i - 1] = m_window[i].m_states[path[i]].m_prev;
+
+  for (size_t i = 0; i < m_window.size(); ++i)
+  {
+    auto const & step = m_window[i];
+    m_fn(MatchedTrackPoint(step.m_dataPoint, step.m_states[path[i]].m_candidate.m_segment),
+         m_tracksCount - 1);
+  }
+
+  m_window.clear();
+}
+
+double HmmMatcher::GetEmissionLogProb(Candidate const & candidate) const
+{
+  double const x = candidate.m_distanceM / m_params.m_sigmaM;
+  return -0.5 * x * x;
+}
+
+void HmmMatcher::GetRouteDistances(Candidate const & from, vector<State> const & to,
+                                   double maxDistanceM, vector<double> & routeDistances)
+{
+  routeDistances.assign(to.size(), kInf);
+
+  double const fromLengthM = m_graph.GetLengthM(from.m_segment);
+  for (size_t j = 0; j < to.size(); ++j)
+  {
+    // Small backward moves along the same segment are gps noise usually.
+    if (to[j].m_candidate.m_segment == from.m_segment)
+      routeDistances[j] = fabs(to[j].m_candidate.m_part - from.m_part) * fromLengthM;
+  }
+
+  // Dijkstra by lengths of segments from the end of |from| segment.
+  // Distances are to the starts of segments.
+  using QueueItem = pair<double, Segment>;
+  priority_queue<QueueItem, vector<QueueItem>, greater<QueueItem>> queue;
+  unordered_map<Segment, double> distances;
+
+  auto const relax = [&](Segment const & segment, double distance) {
+    if (distance > maxDistanceM)
+      return;
+
+    auto const [it, inserted] = distances.emplace(segment, distance);
+    if (!inserted)
+    {
+      if (it->second <= distance)
+        return;
+      it->second = distance;
+    }
+    queue.emplace(distance, segment);
+  };
+
+  vector<Segment> outgoing;
+  m_graph.GetOutgoingSegments(from.m_segment, outgoing);
+  for (auto const & segment : outgoing)
+    relax(segment, (1.0 - from.m_part) * fromLengthM);
+
+  while (!queue.empty())
+  {
+    auto const [distance, segment] = queue.top();
+    queue.pop();
+    if (distances[segment] < distance)
+      continue;
+
+    double const lengthM = m_graph.GetLengthM(segment);
+    for (size_t j = 0; j < to.size(); ++j)
+    {
+      if (to[j].m_candidate.m_segment == segment)
+        routeDistances[j] = min(routeDistances[j], distance + to[j].m_candidate.m_part * lengthM);
+    }
+
+    outgoing.clear();
+    m_graph.GetOutgoingSegments(segment, outgoing);
+    for (auto const & next : outgoing)
+      relax(next, distance + lengthM);
+  }
+}
+
+void HmmMatcher::MatchDecided()
+{
+  // The last step is kept to connect the next point.
+  while (m_window.size() > 1)
+  {
+    size_t stateIdx = GetCommonFrontState();
+    if (stateIdx == kNoPrev)
+    {
+      if (m_window.size() <= m_params.m_maxLag)
+        return;
+
+      // The lag is exceeded, the first point is matched by the most probable path for now.
+      stateIdx = GetBestBackState();
+      for (size_t i = m_window.size() - 1; i > 0; --i)
+        stateIdx = m_window[i].m_states[stateIdx].m_prev;
+    }
+
+    MatchFront(stateIdx);
+  }
+}
+
+void HmmMatcher::MatchFront(size_t stateIdx)
+{
+  Step const & front = m_window.front();
+  CHECK_LESS(stateIdx, front.m_states.size(), ());
+  m_fn(MatchedTrackPoint(front.m_dataPoint, front.m_states[stateIdx].m_candidate.m_segment),
+       m_tracksCount - 1);
+  m_window.pop_front();
+
+  for (auto & state : m_window.front().m_states)
+  {
+    if (state.m_prev != stateIdx)
+      state.m_logProb = -kInf;
+    state.m_prev = kNoPrev;
+  }
+
+  for (size_t i = 1; i < m_window.size(); ++i)
+  {
+    auto const & prevStates = m_window[i - 1].m_states;
+    for (auto & state : m_window[i].m_states)
+    {
+      if (state.IsAlive() && !prevStates[state.m_prev].IsAlive())
+        state.m_logProb = -kInf;
+    }
+  }
+}
+
+size_t HmmMatcher::GetCommonFrontState() const
+{
+  size_t common = kNoPrev;
+  auto const & backStates = m_window.back().m_states;
+  for (size_t j = 0; j < backStates.size(); ++j)
+  {
+    if (!backStates[j].IsAlive())
+      continue;
+
+    size_t stateIdx = j;
+    for (size_t i = m_window.size() - 1; i > 0; --i)
+      stateIdx = m_window[i].m_states[stateIdx].m_prev;
+
+    if (common == kNoPrev)
+      common = stateIdx;
+    else if (common != stateIdx)
+      return kNoPrev;
+  }
+  return common;
+}
+
+size_t HmmMatcher::GetBestBackState() const
+{
+  auto const & states = m_window.back().m_states;
+  CHECK(!states.empty(), ());
+  auto const it = max_element(states.begin(), states.end(), [](State const & lhs, State const & rhs) {
+    return lhs.m_logProb < rhs.m_logProb;
+  });
+  return static_cast<size_t>(distance(states.begin(), it));
+}
+}  // namespace track_analyzing
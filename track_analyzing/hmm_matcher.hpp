@@ -0,0 +1,132 @@
+#pragma once
+
+#include "track_analyzing/track.hpp"
+
+#include "routing/segment.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace track_analyzing
+{
+/// Map matcher based on hidden Markov model (P. Newson, J. Krumm "Hidden Markov Map Matching
+/// Through Noise and Sparseness"). Hidden states are the road segments near track points.
+/// Emission probability depends on the distance from a point to a segment, transition probability
+/// depends on the difference between the route distance and the straight line distance of
+/// consecutive points. Route distances are found by the searches bounded by the straight line
+/// distance.
+///
+/// The most probable sequence of segments is found by Viterbi algorithm online: a point is matched
+/// as soon as all the surviving paths pass the same segment at it, but not later than
+/// |Params::m_maxLag| points after it. When no path goes on from the previous points the track
+/// is broken and matching starts over.
+class HmmMatcher final
+{
+public:
+  struct Candidate
+  {
+    routing::Segment m_segment;
+    // Distance from the point to the segment in meters.
+    double m_distanceM = 0.0;
+    // Position of the point projection from the start (0.0) to the end (1.0) of the segment
+    // in the segment direction.
+    double m_part = 0.0;
+  };
+
+  class Graph
+  {
+  public:
+    virtual ~Graph() = default;
+
+    /// Appends segments closer than |maxDistanceM| to |point| (mercator) to |candidates|.
+    virtual void GetCandidates(m2::PointD const & point, double maxDistanceM,
+                               std::vector<Candidate> & candidates) = 0;
+    /// Appends segments which may follow |segment| to |segments|.
+    virtual void GetOutgoingSegments(routing::Segment const & segment,
+                                     std::vector<routing::Segment> & segments) = 0;
+    virtual double GetLengthM(routing::Segment const & segment) = 0;
+  };
+
+  struct Params
+  {
+    // Standard deviation of gps noise in meters.
+    double m_sigmaM = 4.07;
+    // Scale of exponential distribution of differences between route and straight line distances
+    // of consecutive points in meters.
+    double m_betaM = 3.0;
+    double m_maxCandidateDistanceM = 20.0;
+    size_t m_maxCandidatesNumber = 8;
+    // Route between candidates of consecutive points is searched up to
+    // |m_maxRouteFactor| * straight line distance + |m_maxRouteExtraM|.
+    double m_maxRouteFactor = 2.0;
+    double m_maxRouteExtraM = 100.0;
+    // The max number of the received points which are not matched yet.
+    size_t m_maxLag = 10;
+  };
+
+  /// Is called for matched points in the order of their pushing. |trackIdx| is increased
+  /// on every track break.
+  using MatchedPointFn = std::function<void(MatchedTrackPoint const & point, size_t trackIdx)>;
+
+  HmmMatcher(Graph & graph, Params const & params, MatchedPointFn && fn);
+
+  void Push(DataPoint const & dataPoint);
+  /// Matches all the pushed points. It should be called at the end of a track.
+  void Flush();
+
+  uint64_t GetTracksCount() const { return m_tracksCount; }
+  uint64_t GetPointsCount() const { return m_pointsCount; }
+  uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
+  size_t GetLag() const { return m_window.size(); }
+
+private:
+  static size_t constexpr kNoPrev = std::numeric_limits<size_t>::max();
+
+  struct State
+  {
+    bool IsAlive() const { return m_logProb != -std::numeric_limits<double>::infinity(); }
+
+    Candidate m_candidate;
+    double m_logProb = -std::numeric_limits<double>::infinity();
+    // Index of the previous state in the previous step.
+    size_t m_prev = kNoPrev;
+  };
+
+  struct Step
+  {
+    DataPoint m_dataPoint;
+    m2::PointD m_point;
+    std::vector<State> m_states;
+  };
+
+  double GetEmissionLogProb(Candidate const & candidate) const;
+  // Fills |routeDistances| with route distances from |from| to |to| candidates or infinity
+  // if a route is longer than |maxDistanceM|.
+  void GetRouteDistances(Candidate const & from, std::vector<State> const & to, double maxDistanceM,
+                         std::vector<double> & routeDistances);
+
+  // Matches the points which are decided or out of the lag.
+  void MatchDecided();
+  // Matches the first step of the window to state |stateIdx|, removes the other paths through it.
+  void MatchFront(size_t stateIdx);
+  // @returns the index of the state in the first step which all alive paths go through or kNoPrev.
+  size_t GetCommonFrontState() const;
+  size_t GetBestBackState() const;
+
+  Graph & m_graph;
+  Params const m_params;
+  MatchedPointFn m_fn;
+
+  std::deque<Step> m_window;
+
+  uint64_t m_tracksCount = 0;
+  uint64_t m_pointsCount = 0;
+  uint64_t m_nonMatchedPointsCount = 0;
+};
+}  // namespace track_analyzing
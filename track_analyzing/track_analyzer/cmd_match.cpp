@@ -23,10 +23,13 @@
 #include "base/timer.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <exception>
+#include <map>
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
 
 using namespace routing;
 using namespace std;
@@ -35,10 +38,13 @@ using namespace track_analyzing;
 
 namespace
 {
-using Iter = typename vector<string>::iterator;
+double GetPointsPerSecond(uint64_t pointsCount, double seconds)
+{
+  return seconds > 0.0 ? static_cast<double>(pointsCount) / seconds : 0.0;
+}
 
 void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & storage,
-                 NumMwmIds const & numMwmIds, MwmToMatchedTracks & mwmToMatchedTracks)
+                 NumMwmIds const & numMwmIds, bool hmm, MwmToMatchedTracks & mwmToMatchedTracks)
 {
   base::Timer timer;
 
@@ -59,7 +65,10 @@ void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & stora
       auto & matchedTracks = userToMatchedTracks[user];
       try
       {
-        matcher.MatchTrack(it.second, matchedTracks);
+        if (hmm)
+          matcher.MatchTrackHmm(it.second, matchedTracks);
+        else
+          matcher.MatchTrack(it.second, matchedTracks);
       }
       catch (RootException const & e)
       {
@@ -85,23 +94,39 @@ void MatchTracks(MwmToTracks const & mwmToTracks, storage::Storage const & stora
 
   ForTracksSortedByMwmName(mwmToTracks, numMwmIds, processMwm);
 
+  double const seconds = timer.ElapsedSeconds();
   LOG(LINFO,
-      ("Matching finished, elapsed:", timer.ElapsedSeconds(), "seconds, tracks:", tracksCount,
-       ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount));
+      ("Matching finished, elapsed:", seconds, "seconds, tracks:", tracksCount,
+       ", points:", pointsCount, ", non matched points:", nonMatchedPointsCount,
+       ", points per second:", GetPointsPerSecond(pointsCount, seconds)));
+}
+
+// Segments of matched points by user and timestamp.
+using MatchedSegments = map<pair<string, uint64_t>, Segment>;
+
+void AddMatchedSegments(string const & user, vector<MatchedTrack> const & matchedTracks,
+                        MatchedSegments & segments)
+{
+  for (auto const & track : matchedTracks)
+  {
+    for (auto const & point : track)
+      segments.emplace(make_pair(user, point.GetDataPoint().m_timestamp), point.GetSegment());
+  }
 }
 }  // namespace
 
 namespace track_analyzing
 {
 void CmdMatch(string const & logFile, string const & trackFile,
-              shared_ptr<NumMwmIds> const & numMwmIds, Storage const & storage, Stats & stats)
+              shared_ptr<NumMwmIds> const & numMwmIds, Storage const & storage, bool hmm,
+              Stats & stats)
 {
   MwmToTracks mwmToTracks;
   ParseTracks(logFile, numMwmIds, mwmToTracks);
   stats.AddTracksStats(mwmToTracks, *numMwmIds, storage);
 
   MwmToMatchedTracks mwmToMatchedTracks;
-  MatchTracks(mwmToTracks, storage, *numMwmIds, mwmToMatchedTracks);
+  MatchTracks(mwmToTracks, storage, *numMwmIds, hmm, mwmToMatchedTracks);
 
   FileWriter writer(trackFile, FileWriter::OP_WRITE_TRUNCATE);
   MwmToMatchedTracksSerializer serializer(numMwmIds);
@@ -109,7 +134,8 @@ void CmdMatch(string const & logFile, string const & trackFile,
   LOG(LINFO, ("Matched tracks were saved to", trackFile));
 }
 
-void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution)
+void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution,
+              bool hmm)
 {
   LOG(LINFO, ("Matching", logFile));
   Storage storage;
@@ -117,19 +143,21 @@ void CmdMatch(string const & logFile, string const & trackFile, string const & i
   shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
 
   Stats stats;
-  CmdMatch(logFile, trackFile, numMwmIds, storage, stats);
+  CmdMatch(logFile, trackFile, numMwmIds, storage, hmm, stats);
   stats.SaveMwmDistributionToCsv(inputDistribution);
   stats.Log();
 }
 
-void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
+// Files are taken by the threads one by one, so threads which got small files don't stay idle.
+void UnzipAndMatch(vector<string> & files, atomic<size_t> & nextFile, string const & trackExt,
+                   bool hmm, Stats & stats)
 {
   Storage storage;
   storage.RegisterAllLocalMaps();
   shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
-  for (auto it = begin; it != end; ++it)
+  for (size_t i = nextFile++; i < files.size(); i = nextFile++)
   {
-    auto & file = *it;
+    auto & file = files[i];
     string data;
     try
     {
@@ -158,12 +186,13 @@ void UnzipAndMatch(Iter begin, Iter end, string const & trackExt, Stats & stats)
       continue;
     }
 
-    CmdMatch(file, file + trackExt, numMwmIds, storage, stats);
+    CmdMatch(file, file + trackExt, numMwmIds, storage, hmm, stats);
     FileWriter::DeleteFileX(file);
   }
 }
 
-void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution)
+void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution,
+                 bool hmm)
 {
   LOG(LINFO,
       ("Matching dir:", logDir, ". Input distribution will be saved to:", inputDistribution));
@@ -201,18 +230,16 @@ void CmdMatchDir(string const & logDir, string const & trackExt, string const &
   CHECK_GREATER(hardwareConcurrency, 0, ("No available threads."));
   LOG(LINFO, ("Number of available threads =", hardwareConcurrency));
   auto const threadsCount = min(size, hardwareConcurrency);
-  auto const blockSize = size / threadsCount;
+  atomic<size_t> nextFile{0};
   vector<thread> threads(threadsCount - 1);
   vector<Stats> stats(threadsCount);
-  auto begin = filesList.begin();
   for (size_t i = 0; i < threadsCount - 1; ++i)
   {
-    auto end = begin + blockSize;
-    threads[i] = thread(UnzipAndMatch, begin, end, trackExt, ref(stats[i]));
-    begin = end;
+    threads[i] = thread(UnzipAndMatch, ref(filesList), ref(nextFile), trackExt, hmm,
+                        ref(stats[i]));
   }
 
-  UnzipAndMatch(begin, filesList.end(), trackExt, ref(stats[threadsCount - 1]));
+  UnzipAndMatch(filesList, nextFile, trackExt, hmm, stats[threadsCount - 1]);
   for (auto & t : threads)
     t.join();
 
@@ -223,4 +250,88 @@ void CmdMatchDir(string const & logDir, string const & trackExt, string const &
   statSum.SaveMwmDistributionToCsv(inputDistribution);
   statSum.Log();
 }
+
+void CmdMatchBenchmark(string const & logFile)
+{
+  LOG(LINFO, ("Matching benchmark", logFile));
+  Storage storage;
+  storage.RegisterAllLocalMaps();
+  shared_ptr<NumMwmIds> numMwmIds = CreateNumMwmIds(storage);
+
+  MwmToTracks mwmToTracks;
+  ParseTracks(logFile, numMwmIds, mwmToTracks);
+
+  uint64_t pointsCount = 0;
+  uint64_t greedyFailed = 0;
+  uint64_t hmmFailed = 0;
+  uint64_t greedyMatched = 0;
+  uint64_t hmmMatched = 0;
+  uint64_t bothMatched = 0;
+  uint64_t sameSegments = 0;
+  double greedySeconds = 0.0;
+  double hmmSeconds = 0.0;
+
+  ForTracksSortedByMwmName(mwmToTracks, *numMwmIds, [&](string const & mwmName,
+                                                        UserToTrack const & userToTrack) {
+    auto const countryFile = platform::CountryFile(mwmName);
+    TrackMatcher matcher(storage, numMwmIds->GetId(countryFile), countryFile);
+
+    MatchedSegments greedySegments;
+    MatchedSegments hmmSegments;
+    for (auto const & [user, track] : userToTrack)
+    {
+      pointsCount += track.size();
+
+      vector<MatchedTrack> matchedTracks;
+      base::Timer timer;
+      try
+      {
+        matcher.MatchTrack(track, matchedTracks);
+      }
+      catch (RootException const & e)
+      {
+        LOG(LERROR, ("Can't match track for mwm:", mwmName, ", user:", user, e.what()));
+        ++greedyFailed;
+      }
+      greedySeconds += timer.ElapsedSeconds();
+      AddMatchedSegments(user, matchedTracks, greedySegments);
+
+      matchedTracks.clear();
+      timer.Reset();
+      try
+      {
+        matcher.MatchTrackHmm(track, matchedTracks);
+      }
+      catch (RootException const & e)
+      {
+        LOG(LERROR, ("Can't match track by HMM for mwm:", mwmName, ", user:", user, e.what()));
+        ++hmmFailed;
+      }
+      hmmSeconds += timer.ElapsedSeconds();
+      AddMatchedSegments(user, matchedTracks, hmmSegments);
+    }
+
+    greedyMatched += greedySegments.size();
+    hmmMatched += hmmSegments.size();
+    for (auto const & [key, segment] : greedySegments)
+    {
+      auto const it = hmmSegments.find(key);
+      if (it == hmmSegments.cend())
+        continue;
+
+      ++bothMatched;
+      if (it->second == segment)
+        ++sameSegments;
+    }
+  });
+
+  LOG(LINFO, ("Points:", pointsCount));
+  LOG(LINFO, ("Greedy matcher: failed tracks:", greedyFailed, ", matched points:", greedyMatched,
+              ", elapsed:", greedySeconds,
+              "seconds, points per second:", GetPointsPerSecond(pointsCount, greedySeconds)));
+  LOG(LINFO, ("HMM matcher: failed tracks:", hmmFailed, ", matched points:", hmmMatched,
+              ", elapsed:", hmmSeconds,
+              "seconds, points per second:", GetPointsPerSecond(pointsCount, hmmSeconds)));
+  LOG(LINFO, ("Points matched by both:", bothMatched, ", to the same segments:", sameSegments));
+}
 }  // namespace track_analyzing
@@ -36,6 +36,8 @@ DEFINE_string_ext(cmd, "",
                   "project in gz files and extracted.\n"
                   "match_dir - the same as match but applies to the directory with raw logs in gz format."
                   "Process files in several threads.\n"
+                  "match_benchmark - matches raw logs by greedy and HMM matchers and compares "
+                  "their speed in points per second and results.\n"
                   "unmatched_tracks - based on raw logs gathers points to tracks\n"
                   "and save tracks to csv. Track points save as lat, log, timestamp in seconds\n"
                   "tracks - prints track statistics\n"
@@ -66,6 +68,7 @@ DEFINE_uint64(
     "for balancing. This param should be used with balance_csv command.");
 
 DEFINE_string(track_extension, ".track", "track files extension");
+DEFINE_bool(hmm, false, "match tracks by HMM matcher, it may be used with match and match_dir commands");
 DEFINE_bool(no_world_logs, false, "don't print world summary logs");
 DEFINE_bool(no_mwm_logs, false, "don't print logs per mwm");
 DEFINE_bool(no_track_logs, false, "don't print logs per track");
@@ -100,9 +103,13 @@ namespace track_analyzing
 void CmdCppTrack(string const & trackFile, string const & mwmName, string const & user,
                  size_t trackIdx);
 // Match raw gps logs to tracks.
-void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution);
+void CmdMatch(string const & logFile, string const & trackFile, string const & inputDistribution,
+              bool hmm);
 // The same as match but applies for the directory with raw logs.
-void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution);
+void CmdMatchDir(string const & logDir, string const & trackExt, string const & inputDistribution,
+                 bool hmm);
+// Match raw gps logs by greedy and HMM matchers and compare them.
+void CmdMatchBenchmark(string const & logFile);
 // Parse |logFile| and save tracks (mwm name, aloha id, lats, lons, timestamps in seconds in csv).
 void CmdUnmatchedTracks(string const & logFile, string const & trackFileCsv);
 // Print aggregated tracks to csv table.
@@ -131,12 +138,17 @@ int main(int argc, char ** argv)
     if (cmd == "match")
     {
       string const & logFile = Checked_in();
-      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out, FLAGS_input_distribution);
+      CmdMatch(logFile, FLAGS_out.empty() ? logFile + ".track" : FLAGS_out, FLAGS_input_distribution,
+               FLAGS_hmm);
     }
     else if (cmd == "match_dir")
     {
       string const & logDir = Checked_in();
-      CmdMatchDir(logDir, FLAGS_track_extension, FLAGS_input_distribution);
+      CmdMatchDir(logDir, FLAGS_track_extension, FLAGS_input_distribution, FLAGS_hmm);
+    }
+    else if (cmd == "match_benchmark")
+    {
+      CmdMatchBenchmark(Checked_in());
     }
     else if (cmd == "unmatched_tracks")
     {
@@ -0,0 +1,178 @@
+#include "testing/testing.hpp"
+
+#include "track_analyzing/hmm_matcher.hpp"
+#include "track_analyzing/track.hpp"
+
+#include "routing/segment.hpp"
+
+#include "geometry/distance_on_sphere.hpp"
+#include "geometry/latlon.hpp"
+#include "geometry/mercator.hpp"
+#include "geometry/parametrized_segment.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace hmm_matcher_tests
+{
+using namespace routing;
+using namespace std;
+using namespace track_analyzing;
+
+NumMwmId constexpr kMwmId = 0;
+
+// Two-way roads which are not connected to each other. Road points are in lat lon.
+class TestGraph final : public HmmMatcher::Graph
+{
+public:
+  explicit TestGraph(vector<vector<ms::LatLon>> const & roads) : m_roads(roads) {}
+
+  // HmmMatcher::Graph overrides:
+  void GetCandidates(m2::PointD const & point, double maxDistanceM,
+                     vector<HmmMatcher::Candidate> & candidates) override
+  {
+    for (uint32_t featureId = 0; featureId < m_roads.size(); ++featureId)
+    {
+      auto const & road = m_roads[featureId];
+      for (uint32_t segIdx = 0; segIdx + 1 < road.size(); ++segIdx)
+      {
+        m2::PointD const p0 = mercator::FromLatLon(road[segIdx]);
+        m2::PointD const p1 = mercator::FromLatLon(road[segIdx + 1]);
+        m2::PointD const projection = m2::ParametrizedSegment<m2::PointD>(p0, p1).ClosestPointTo(point);
+        double const distanceM = mercator::DistanceOnEarth(point, projection);
+        if (distanceM >= maxDistanceM)
+          continue;
+
+        double const part = p0.Length(projection) / p0.Length(p1);
+        candidates.push_back({Segment(kMwmId, featureId, segIdx, true), distanceM, part});
+        candidates.push_back({Segment(kMwmId, featureId, segIdx, false), distanceM, 1.0 - part});
+      }
+    }
+  }
+
+  void GetOutgoingSegments(Segment const & segment, vector<Segment> & segments) override
+  {
+    uint32_t const segIdx = segment.GetSegmentIdx();
+    if (segment.IsForward() && segIdx + 2 < m_roads[segment.GetFeatureId()].size())
+      segments.emplace_back(kMwmId, segment.GetFeatureId(), segIdx + 1, true);
+    if (!segment.IsForward() && segIdx > 0)
+      segments.emplace_back(kMwmId, segment.GetFeatureId(), segIdx - 1, false);
+  }
+
+  double GetLengthM(Segment const & segment) override
+  {
+    auto const & road = m_roads[segment.GetFeatureId()];
+    return ms::DistanceOnEarth(road[segment.GetPointId(false /* front */)],
+                               road[segment.GetPointId(true /* front */)]);
+  }
+
+private:
+  vector<vector<ms::LatLon>> m_roads;
+};
+
+vector<ms::LatLon> MakeRoad(double lat, double lonFrom, double lonTo, size_t pointsNumber)
+{
+  vector<ms::LatLon> road;
+  for (size_t i = 0; i < pointsNumber; ++i)
+    road.emplace_back(lat, lonFrom + (lonTo - lonFrom) * i / (pointsNumber - 1));
+  return road;
+}
+
+DataPoint MakeDataPoint(uint64_t timestamp, double lat, double lon)
+{
+  return DataPoint(timestamp, ms::LatLon(lat, lon), 0 /* traffic */);
+}
+
+struct Result
+{
+  vector<Segment> m_segments;
+  vector<size_t> m_trackIdxs;
+};
+
+// Roads 0 and 1 are parallel at about 33 meters from each other, road 2 is far from them.
+TestGraph MakeTestGraph()
+{
+  return TestGraph({MakeRoad(0.0, 0.0, 0.01, 11), MakeRoad(0.0003, 0.0, 0.01, 11),
+                    MakeRoad(1.0, 0.0, 0.01, 11)});
+}
+
+UNIT_TEST(HmmMatcher_NoisyTrack)
+{
+  auto graph = MakeTestGraph();
+  Result result;
+  HmmMatcher matcher(graph, HmmMatcher::Params(), [&](MatchedTrackPoint const & point, size_t trackIdx) {
+    result.m_segments.push_back(point.GetSegment());
+    result.m_trackIdxs.push_back(trackIdx);
+  });
+
+  // Points go along road 0 eastwards every ~44 meters with noise. Some points are closer
+  // to road 1, the nearest segment is wrong for them.
+  vector<double> const noiseLats = {0.00002, -0.00003, 0.00016, 0.00001, 0.00017, -0.00002,
+                                    0.00003, 0.00016, 0.0, -0.00001};
+  for (size_t i = 0; i < noiseLats.size(); ++i)
+    matcher.Push(MakeDataPoint(i, noiseLats[i], 0.0003 + 0.0004 * i));
+  matcher.Flush();
+
+  TEST_EQUAL(result.m_segments.size(), noiseLats.size(), ());
+  for (size_t i = 0; i < result.m_segments.size(); ++i)
+  {
+    auto const & segment = result.m_segments[i];
+    TEST_EQUAL(segment.GetFeatureId(), 0, (i));
+    TEST(segment.IsForward(), (i));
+    TEST_EQUAL(segment.GetSegmentIdx(), static_cast<uint32_t>((0.0003 + 0.0004 * i) / 0.001), (i));
+    TEST_EQUAL(result.m_trackIdxs[i], 0, ());
+  }
+
+  TEST_EQUAL(matcher.GetTracksCount(), 1, ());
+  TEST_EQUAL(matcher.GetPointsCount(), noiseLats.size(), ());
+  TEST_EQUAL(matcher.GetNonMatchedPointsCount(), 0, ());
+}
+
+UNIT_TEST(HmmMatcher_BoundedLag)
+{
+  auto graph = MakeTestGraph();
+  HmmMatcher::Params params;
+  params.m_maxLag = 3;
+
+  size_t matchedCount = 0;
+  HmmMatcher matcher(graph, params, [&](MatchedTrackPoint const &, size_t) { ++matchedCount; });
+
+  size_t constexpr kPointsNumber = 20;
+  for (size_t i = 0; i < kPointsNumber; ++i)
+  {
+    // Points are between the roads, so the paths along both of them survive.
+    matcher.Push(MakeDataPoint(i, 0.00015, 0.0003 + 0.0004 * i));
+    TEST_LESS_OR_EQUAL(matcher.GetLag(), params.m_maxLag, ());
+    TEST_EQUAL(matchedCount + matcher.GetLag(), i + 1, ());
+  }
+
+  matcher.Flush();
+  TEST_EQUAL(matchedCount, kPointsNumber, ());
+  TEST_EQUAL(matcher.GetLag(), 0, ());
+}
+
+UNIT_TEST(HmmMatcher_TrackBreak)
+{
+  auto graph = MakeTestGraph();
+  Result result;
+  HmmMatcher matcher(graph, HmmMatcher::Params(), [&](MatchedTrackPoint const & point, size_t trackIdx) {
+    result.m_segments.push_back(point.GetSegment());
+    result.m_trackIdxs.push_back(trackIdx);
+  });
+
+  matcher.Push(MakeDataPoint(0, 0.0, 0.0002));
+  matcher.Push(MakeDataPoint(1, 0.0, 0.0006));
+  // The point is far from all the roads.
+  matcher.Push(MakeDataPoint(2, 0.5, 0.0006));
+  // Road 2 is not connected to road 0.
+  matcher.Push(MakeDataPoint(3, 1.0, 0.0002));
+  matcher.Push(MakeDataPoint(4, 1.0, 0.0006));
+  matcher.Flush();
+
+  TEST_EQUAL(result.m_trackIdxs, vector<size_t>({0, 0, 1, 1}), ());
+  TEST_EQUAL(result.m_segments[1].GetFeatureId(), 0, ());
+  TEST_EQUAL(result.m_segments[2].GetFeatureId(), 2, ());
+  TEST_EQUAL(matcher.GetTracksCount(), 2, ());
+  TEST_EQUAL(matcher.GetNonMatchedPointsCount(), 1, ());
+}
+}  // namespace hmm_matcher_tests
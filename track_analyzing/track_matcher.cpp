@@ -8,6 +8,7 @@
 
 #include "indexer/scales.hpp"
 
+#include "geometry/distance_on_sphere.hpp"
 #include "geometry/parametrized_segment.hpp"
 
 #include "base/stl_helpers.hpp"
@@ -53,6 +54,87 @@ bool EdgesContain(IndexGraph::SegmentEdgeListT const & edges, Segment const & se
 }
 }  // namespace
 
+// TrackMatcher::HmmGraph --------------------------------------------------------------------------
+class TrackMatcher::HmmGraph final : public HmmMatcher::Graph
+{
+public:
+  HmmGraph(DataSource const & dataSource, IndexGraph & graph,
+           VehicleModelInterface const & vehicleModel, NumMwmId mwmId)
+    : m_dataSource(dataSource), m_graph(graph), m_vehicleModel(vehicleModel), m_mwmId(mwmId)
+  {
+  }
+
+  // HmmMatcher::Graph overrides:
+  void GetCandidates(m2::PointD const & point, double maxDistanceM,
+                     vector<HmmMatcher::Candidate> & candidates) override
+  {
+    m_dataSource.ForEachInRect([&](FeatureType & ft)
+    {
+      if (!ft.GetID().IsValid())
+        return;
+
+      if (ft.GetID().m_mwmId.GetInfo()->GetType() != MwmInfo::COUNTRY)
+        return;
+
+      feature::TypesHolder const types(ft);
+      if (!m_vehicleModel.IsRoad(types))
+        return;
+
+      bool const oneWay = m_vehicleModel.IsOneWay(types);
+      ft.ParseGeometry(FeatureType::BEST_GEOMETRY);
+
+      for (size_t segIdx = 0; segIdx + 1 < ft.GetPointsCount(); ++segIdx)
+      {
+        m2::ParametrizedSegment<m2::PointD> const segment(ft.GetPoint(segIdx), ft.GetPoint(segIdx + 1));
+        m2::PointD const projection = segment.ClosestPointTo(point);
+        double const distanceM = mercator::DistanceOnEarth(point, projection);
+        if (distanceM >= maxDistanceM)
+          continue;
+
+        double const length = segment.GetP0().Length(segment.GetP1());
+        double const part = length > 0.0 ? segment.GetP0().Length(projection) / length : 0.0;
+
+        for (bool const forward : {true, false})
+        {
+          if (!forward && oneWay)
+            break;
+
+          Segment const candidate(m_mwmId, ft.GetID().m_index, static_cast<uint32_t>(segIdx), forward);
+          if (m_graph.GetAccessType(candidate) == RoadAccess::Type::Yes)
+            candidates.push_back({candidate, distanceM, forward ? part : 1.0 - part});
+        }
+      }
+    },
+    mercator::RectByCenterXYAndSizeInMeters(point, maxDistanceM),
+    scales::GetUpperScale());
+  }
+
+  void GetOutgoingSegments(Segment const & segment, vector<Segment> & segments) override
+  {
+    m_edges.clear();
+    m_graph.GetEdgeList(segment, true /* isOutgoing */, true /* useRoutingOptions */, m_edges);
+    for (auto const & edge : m_edges)
+    {
+      if (!segment.IsInverse(edge.GetTarget()))
+        segments.push_back(edge.GetTarget());
+    }
+  }
+
+  double GetLengthM(Segment const & segment) override
+  {
+    auto const & road = m_graph.GetRoadGeometry(segment.GetFeatureId());
+    return ms::DistanceOnEarth(road.GetPoint(segment.GetPointId(false /* front */)),
+                               road.GetPoint(segment.GetPointId(true /* front */)));
+  }
+
+private:
+  DataSource const & m_dataSource;
+  IndexGraph & m_graph;
+  VehicleModelInterface const & m_vehicleModel;
+  NumMwmId const m_mwmId;
+  IndexGraph::SegmentEdgeListT m_edges;
+};
+
 // TrackMatcher ------------------------------------------------------------------------------------
 TrackMatcher::TrackMatcher(storage::Storage const & storage, NumMwmId mwmId,
                            platform::CountryFile const & countryFile)
@@ -73,6 +155,39 @@ TrackMatcher::TrackMatcher(storage::Storage const & storage, NumMwmId mwmId,
         nullptr /* dataSource */, nullptr /* numMvmIds */));
 
   DeserializeIndexGraph(*handle.GetValue(), VehicleType::Car, *m_graph);
+
+  m_hmmGraph = make_unique<HmmGraph>(m_dataSource, *m_graph, *m_vehicleModel, m_mwmId);
+}
+
+TrackMatcher::~TrackMatcher() = default;
+
+void TrackMatcher::MatchTrackHmm(vector<DataPoint> const & track,
+                                 vector<MatchedTrack> & matchedTracks,
+                                 HmmMatcher::Params const & params)
+{
+  size_t lastTrackIdx = numeric_limits<size_t>::max();
+  HmmMatcher matcher(*m_hmmGraph, params, [&](MatchedTrackPoint const & point, size_t trackIdx) {
+    if (trackIdx != lastTrackIdx)
+    {
+      matchedTracks.push_back({});
+      lastTrackIdx = trackIdx;
+    }
+    matchedTracks.back().push_back(point);
+  });
+
+  for (auto const & point : track)
+    matcher.Push(point);
+  matcher.Flush();
+
+  m_tracksCount += matcher.GetTracksCount();
+  m_pointsCount += matcher.GetPointsCount();
+  m_nonMatchedPointsCount += matcher.GetNonMatchedPointsCount();
+}
+
+unique_ptr<HmmMatcher> TrackMatcher::CreateHmmMatcher(HmmMatcher::Params const & params,
+                                                      HmmMatcher::MatchedPointFn && fn)
+{
+  return make_unique<HmmMatcher>(*m_hmmGraph, params, std::move(fn));
 }
 
 void TrackMatcher::MatchTrack(vector<DataPoint> const & track, vector<MatchedTrack> & matchedTracks)
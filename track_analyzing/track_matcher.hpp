@@ -1,5 +1,6 @@
 #pragma once
 
+#include "track_analyzing/hmm_matcher.hpp"
 #include "track_analyzing/track.hpp"
 
 #include "routing/index_graph.hpp"
@@ -24,9 +25,19 @@ class TrackMatcher final
 public:
   TrackMatcher(storage::Storage const & storage, routing::NumMwmId mwmId,
                platform::CountryFile const & countryFile);
+  ~TrackMatcher();
 
   void MatchTrack(std::vector<DataPoint> const & track, std::vector<MatchedTrack> & matchedTracks);
 
+  /// The same as MatchTrack() but by HmmMatcher.
+  void MatchTrackHmm(std::vector<DataPoint> const & track, std::vector<MatchedTrack> & matchedTracks,
+                     HmmMatcher::Params const & params = {});
+
+  /// @returns matcher for streaming matching of points on the mwm graph. It's valid while
+  /// the TrackMatcher is alive. Its points are not included in the counters of TrackMatcher.
+  std::unique_ptr<HmmMatcher> CreateHmmMatcher(HmmMatcher::Params const & params,
+                                               HmmMatcher::MatchedPointFn && fn);
+
   uint64_t GetTracksCount() const { return m_tracksCount; }
   uint64_t GetPointsCount() const { return m_pointsCount; }
   uint64_t GetNonMatchedPointsCount() const { return m_nonMatchedPointsCount; }
@@ -75,10 +86,13 @@ private:
     std::vector<Candidate> m_candidates;
   };
 
+  class HmmGraph;
+
   routing::NumMwmId const m_mwmId;
   FrozenDataSource m_dataSource;
   std::shared_ptr<routing::VehicleModelInterface> m_vehicleModel;
   std::unique_ptr<routing::IndexGraph> m_graph;
+  std::unique_ptr<HmmGraph> m_hmmGraph;
   uint64_t m_tracksCount = 0;
   uint64_t m_pointsCount = 0;
   uint64_t m_nonMatchedPointsCount = 0;
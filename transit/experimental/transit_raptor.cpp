@@ -0,0 +1,631 @@
+#include "transit/experimental/transit_raptor.hpp"
+
+#include "transit/transit_schedule.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/checked_cast.hpp"
+#include "base/logging.hpp"
+#include "base/stl_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+namespace transit
+{
+namespace experimental
+{
+namespace
+{
+DayTime constexpr kSecondsInDay = 24 * 60 * 60;
+
+DayTime ToDayTime(::transit::Time const & time)
+{
+  return time.m_hour * 3600 + time.m_minute * 60 + time.m_second;
+}
+
+std::vector<DayTime> GetDepartures(Schedule const & schedule, time_t serviceDay)
+{
+  std::vector<DayTime> departures;
+  auto const * frequencies = schedule.GetFrequencyIntervals(serviceDay);
+  if (!frequencies)
+  {
+    // Lines without service dates run all the day with the default frequency.
+    Frequency const frequency = schedule.GetFrequency();
+    if (schedule.GetServiceIntervals().empty() && schedule.GetServiceExceptions().empty() &&
+        frequency != kDefaultFrequency)
+    {
+      for (DayTime t = 0; t < kSecondsInDay; t += frequency)
+        departures.push_back(t);
+    }
+    return departures;
+  }
+
+  for (auto const & [interval, frequency] : frequencies->GetFrequencies())
+  {
+    if (frequency == kDefaultFrequency)
+      continue;
+
+    auto const & [startTime, endTime] = interval.Extract();
+    for (DayTime t = ToDayTime(startTime); t <= ToDayTime(endTime); t += frequency)
+      departures.push_back(t);
+  }
+
+  base::SortUnique(departures);
+  return departures;
+}
+}  // namespace
+
+// Timetable ---------------------------------------------------------------------------------------
+Timetable::Timetable(TransitData const & data, time_t serviceDay, Params const & params,
+                     WalkTimeFn const & walkTimeFn)
+  : Timetable(data.GetStops(), data.GetLines(), data.GetEdges(), data.GetTransfers(), serviceDay,
+              params, walkTimeFn)
+{
+}
+
+Timetable::Timetable(std::vector<Stop> const & stops, std::vector<Line> const & lines,
+                     std::vector<Edge> const & edges, std::vector<Transfer> const & transfers,
+                     time_t serviceDay, Params const & params, WalkTimeFn const & walkTimeFn)
+  : m_minTransferTimeS(params.m_minTransferTimeS)
+{
+  CHECK_GREATER(params.m_pedestrianSpeedMpS, 0.0, ());
+
+  m_stopIds.reserve(stops.size());
+  for (auto const & stop : stops)
+  {
+    auto const idx = base::checked_cast<uint32_t>(m_stopIds.size());
+    CHECK(m_stopIdToIdx.emplace(stop.GetId(), idx).second, ("Duplicated stop", stop.GetId()));
+    m_stopIds.push_back(stop.GetId());
+  }
+
+  AddRoutes(lines, edges, serviceDay);
+  AddFootpaths(stops, transfers, params, walkTimeFn);
+
+  LOG(LINFO, ("Timetable: stops", m_stopIds.size(), "routes", m_routes.size(), "trips",
+              GetTripsCount(), "footpaths", GetFootpathsCount()));
+}
+
+std::optional<uint32_t> Timetable::GetStopIdx(TransitId stopId) const
+{
+  auto const it = m_stopIdToIdx.find(stopId);
+  if (it == m_stopIdToIdx.cend())
+    return {};
+  return it->second;
+}
+
+TransitId Timetable::GetStopId(uint32_t stopIdx) const
+{
+  CHECK_LESS(stopIdx, m_stopIds.size(), ());
+  return m_stopIds[stopIdx];
+}
+
+std::vector<Timetable::RouteStop> const & Timetable::GetRouteStops(uint32_t stopIdx) const
+{
+  CHECK_LESS(stopIdx, m_stopRoutes.size(), ());
+  return m_stopRoutes[stopIdx];
+}
+
+std::vector<Timetable::Footpath> const & Timetable::GetFootpaths(uint32_t stopIdx) const
+{
+  CHECK_LESS(stopIdx, m_footpaths.size(), ());
+  return m_footpaths[stopIdx];
+}
+
+size_t Timetable::GetTripsCount() const
+{
+  size_t count = 0;
+  for (auto const & route : m_routes)
+    count += route.m_departures.size();
+  return count;
+}
+
+size_t Timetable::GetFootpathsCount() const
+{
+  size_t count = 0;
+  for (auto const & footpaths : m_footpaths)
+    count += footpaths.size();
+  return count;
+}
+
+void Timetable::AddRoutes(std::vector<Line> const & lines, std::vector<Edge> const & edges,
+                          time_t serviceDay)
+{
+  // Travel times between consecutive stops of lines.
+  std::map<std::tuple<TransitId, TransitId, TransitId>, EdgeWeight> weights;
+  for (auto const & edge : edges)
+  {
+    if (edge.IsTransfer() || edge.GetLineId() == kInvalidTransitId)
+      continue;
+    weights.emplace(std::make_tuple(edge.GetLineId(), edge.GetStop1Id(), edge.GetStop2Id()),
+                    edge.GetWeight());
+  }
+
+  for (auto const & line : lines)
+  {
+    auto const & stopIds = line.GetStopIds();
+    if (stopIds.size() < 2)
+      continue;
+
+    Route route;
+    route.m_lineId = line.GetId();
+
+    bool isValid = true;
+    DayTime offset = 0;
+    for (size_t i = 0; i < stopIds.size(); ++i)
+    {
+      auto const stopIdx = GetStopIdx(stopIds[i]);
+      if (!stopIdx)
+      {
+        isValid = false;
+        break;
+      }
+
+      if (i != 0)
+      {
+        auto const it = weights.find(std::make_tuple(line.GetId(), stopIds[i - 1], stopIds[i]));
+        if (it == weights.cend())
+        {
+          isValid = false;
+          break;
+        }
+        offset += it->second;
+      }
+
+      route.m_stopIdxs.push_back(*stopIdx);
+      route.m_offsets.push_back(offset);
+    }
+
+    if (!isValid)
+    {
+      LOG(LWARNING, ("Line", line.GetId(), "has unknown stops or edges, it is skipped."));
+      continue;
+    }
+
+    route.m_departures = GetDepartures(line.GetSchedule(), serviceDay);
+    if (!route.m_departures.empty())
+      m_routes.push_back(std::move(route));
+  }
+
+  m_stopRoutes.resize(m_stopIds.size());
+  for (uint32_t routeIdx = 0; routeIdx < m_routes.size(); ++routeIdx)
+  {
+    auto const & stopIdxs = m_routes[routeIdx].m_stopIdxs;
+    for (uint32_t pos = 0; pos < stopIdxs.size(); ++pos)
+      m_stopRoutes[stopIdxs[pos]].push_back({routeIdx, pos});
+  }
+}
+
+void Timetable::AddFootpaths(std::vector<Stop> const & stops,
+                             std::vector<Transfer> const & transfers, Params const & params,
+                             WalkTimeFn const & walkTimeFn)
+{
+  std::set<std::pair<uint32_t, uint32_t>> stopPairs;
+  auto const addPair = [&stopPairs](uint32_t stopIdx1, uint32_t stopIdx2) {
+    if (stopIdx1 != stopIdx2)
+      stopPairs.emplace(std::min(stopIdx1, stopIdx2), std::max(stopIdx1, stopIdx2));
+  };
+
+  for (auto const & transfer : transfers)
+  {
+    std::vector<uint32_t> stopIdxs;
+    for (auto const stopId : transfer.GetStopIds())
+    {
+      if (auto const stopIdx = GetStopIdx(stopId))
+        stopIdxs.push_back(*stopIdx);
+    }
+
+    for (size_t i = 0; i < stopIdxs.size(); ++i)
+    {
+      for (size_t j = i + 1; j < stopIdxs.size(); ++j)
+        addPair(stopIdxs[i], stopIdxs[j]);
+    }
+  }
+
+  // Close stops are found by the sweep line along x.
+  std::vector<uint32_t> order(stops.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&stops](uint32_t lhs, uint32_t rhs) {
+    return stops[lhs].GetPoint().x < stops[rhs].GetPoint().x;
+  });
+
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    auto const & point = stops[order[i]].GetPoint();
+    m2::RectD const rect =
+        mercator::RectByCenterXYAndSizeInMeters(point, params.m_maxFootpathDistanceM);
+    for (size_t j = i + 1; j < order.size(); ++j)
+    {
+      auto const & other = stops[order[j]].GetPoint();
+      if (other.x > rect.maxX())
+        break;
+
+      if (rect.IsPointInside(other) &&
+          mercator::DistanceOnEarth(point, other) <= params.m_maxFootpathDistanceM)
+      {
+        addPair(order[i], order[j]);
+      }
+    }
+  }
+
+  m_footpaths.resize(m_stopIds.size());
+  auto const addFootpath = [&](uint32_t from, uint32_t to) {
+    std::optional<DayTime> timeS;
+    if (walkTimeFn)
+    {
+      timeS = walkTimeFn(stops[from], stops[to]);
+    }
+    else
+    {
+      double const distanceM = mercator::DistanceOnEarth(stops[from].GetPoint(), stops[to].GetPoint());
+      timeS = static_cast<DayTime>(std::ceil(distanceM / params.m_pedestrianSpeedMpS));
+    }
+
+    if (timeS)
+      m_footpaths[from].push_back({to, std::max(*timeS, m_minTransferTimeS)});
+  };
+
+  for (auto const & [stopIdx1, stopIdx2] : stopPairs)
+  {
+    addFootpath(stopIdx1, stopIdx2);
+    addFootpath(stopIdx2, stopIdx1);
+  }
+}
+
+// Journey -----------------------------------------------------------------------------------------
+size_t Journey::GetTransfersNumber() const
+{
+  size_t const ridesNumber = std::count_if(m_legs.begin(), m_legs.end(), [](JourneyLeg const & leg) {
+    return leg.m_type == JourneyLeg::Type::Ride;
+  });
+  return ridesNumber == 0 ? 0 : ridesNumber - 1;
+}
+
+// RaptorRouter ------------------------------------------------------------------------------------
+RaptorRouter::RaptorRouter(Timetable const & timetable, size_t maxTransfersNumber)
+  : m_timetable(timetable)
+  // Round 0 is the access to the sources, every next round adds a ride.
+  , m_maxRoundsNumber(maxTransfersNumber + 2)
+  , m_labels(m_maxRoundsNumber, std::vector<Label>(timetable.GetStopsCount()))
+  , m_bestArrivals(timetable.GetStopsCount(), kInfDayTime)
+  , m_isMarked(timetable.GetStopsCount(), false)
+  , m_routeStartPos(timetable.GetRoutes().size(), kNoIdx)
+{
+}
+
+std::vector<Journey> RaptorRouter::FindEarliestArrival(std::vector<StopAccess> const & sources,
+                                                       std::vector<StopAccess> const & targets,
+                                                       DayTime departure)
+{
+  Reset();
+
+  std::vector<Journey> journeys;
+  Run(sources, GetTargets(targets), departure,
+      [&journeys](Journey && journey) { journeys.push_back(std::move(journey)); });
+  return journeys;
+}
+
+std::vector<Journey> RaptorRouter::FindProfile(std::vector<StopAccess> const & sources,
+                                               std::vector<StopAccess> const & targets,
+                                               DayTime from, DayTime to)
+{
+  CHECK_LESS_OR_EQUAL(from, to, ());
+  Reset();
+
+  // Only the departures from the origin which catch a trip at a source stop just in time
+  // may be optimal.
+  std::vector<DayTime> departures;
+  auto const & routes = m_timetable.GetRoutes();
+  for (auto const & source : sources)
+  {
+    auto const stopIdx = m_timetable.GetStopIdx(source.m_stopId);
+    if (!stopIdx)
+      continue;
+
+    for (auto const & routeStop : m_timetable.GetRouteStops(*stopIdx))
+    {
+      auto const & route = routes[routeStop.m_routeIdx];
+      // The last stop of a route has no departures.
+      if (routeStop.m_pos + 1 == route.m_stopIdxs.size())
+        continue;
+
+      DayTime const offset = route.m_offsets[routeStop.m_pos];
+      for (auto const departure : route.m_departures)
+      {
+        DayTime const stopDeparture = departure + offset;
+        if (stopDeparture < source.m_timeS)
+          continue;
+
+        DayTime const originDeparture = stopDeparture - source.m_timeS;
+        if (from <= originDeparture && originDeparture <= to)
+          departures.push_back(originDeparture);
+      }
+    }
+  }
+
+  base::SortUnique(departures);
+
+  auto const targetStops = GetTargets(targets);
+  std::vector<Journey> journeys;
+  // Labels are kept between the runs. So a run improves the target arrival only if
+  // the journey departing at |departure| arrives earlier than all the later ones.
+  for (auto it = departures.rbegin(); it != departures.rend(); ++it)
+  {
+    std::optional<Journey> best;
+    Run(sources, targetStops, *it, [&best](Journey && journey) { best = std::move(journey); });
+    if (best)
+      journeys.push_back(std::move(*best));
+  }
+
+  std::reverse(journeys.begin(), journeys.end());
+  return journeys;
+}
+
+void RaptorRouter::Reset()
+{
+  for (auto & labels : m_labels)
+    std::fill(labels.begin(), labels.end(), Label());
+  std::fill(m_bestArrivals.begin(), m_bestArrivals.end(), kInfDayTime);
+  m_bestTargetArrival = kInfDayTime;
+}
+
+std::vector<RaptorRouter::Target> RaptorRouter::GetTargets(
+    std::vector<StopAccess> const & targets) const
+{
+  std::vector<Target> result;
+  for (auto const & target : targets)
+  {
+    if (auto const stopIdx = m_timetable.GetStopIdx(target.m_stopId))
+      result.push_back({*stopIdx, target.m_timeS});
+  }
+  return result;
+}
+
+template <typename Fn>
+void RaptorRouter::Run(std::vector<StopAccess> const & sources, std::vector<Target> const & targets,
+                       DayTime departure, Fn && fn)
+{
+  for (auto const stopIdx : m_markedStops)
+    m_isMarked[stopIdx] = false;
+  m_markedStops.clear();
+
+  for (auto const & source : sources)
+  {
+    auto const stopIdx = m_timetable.GetStopIdx(source.m_stopId);
+    if (!stopIdx)
+      continue;
+
+    Label label;
+    label.m_arrival = departure + source.m_timeS;
+    label.m_type = Label::Type::Access;
+    UpdateLabel(0 /* round */, *stopIdx, label);
+  }
+
+  for (size_t round = 0; round < m_maxRoundsNumber && !m_markedStops.empty(); ++round)
+  {
+    if (round != 0)
+    {
+      // Round labels are the arrivals with at most |round| rides.
+      auto const & prevLabels = m_labels[round - 1];
+      auto & labels = m_labels[round];
+      for (size_t i = 0; i < labels.size(); ++i)
+      {
+        if (prevLabels[i].m_arrival < labels[i].m_arrival)
+          labels[i] = prevLabels[i];
+      }
+
+      ScanRoutes(round);
+    }
+
+    ScanFootpaths(round);
+
+    Target const * improved = nullptr;
+    for (auto const & target : targets)
+    {
+      DayTime const arrival = m_labels[round][target.m_stopIdx].m_arrival;
+      if (arrival != kInfDayTime && arrival + target.m_timeS < m_bestTargetArrival)
+      {
+        m_bestTargetArrival = arrival + target.m_timeS;
+        improved = &target;
+      }
+    }
+
+    if (improved)
+      fn(MakeJourney(round, *improved, departure));
+  }
+}
+
+void RaptorRouter::ScanRoutes(size_t round)
+{
+  auto const & routes = m_timetable.GetRoutes();
+
+  m_markedRoutes.clear();
+  for (auto const stopIdx : m_markedStops)
+  {
+    m_isMarked[stopIdx] = false;
+    for (auto const & routeStop : m_timetable.GetRouteStops(stopIdx))
+    {
+      auto & startPos = m_routeStartPos[routeStop.m_routeIdx];
+      if (startPos == kNoIdx)
+      {
+        startPos = routeStop.m_pos;
+        m_markedRoutes.push_back(routeStop.m_routeIdx);
+      }
+      else
+      {
+        startPos = std::min(startPos, routeStop.m_pos);
+      }
+    }
+  }
+  m_markedStops.clear();
+
+  auto const & prevLabels = m_labels[round - 1];
+  DayTime const minTransferTime = m_timetable.GetMinTransferTime();
+  for (auto const routeIdx : m_markedRoutes)
+  {
+    ++m_scannedRoutesCount;
+
+    auto const & route = routes[routeIdx];
+    auto const & departures = route.m_departures;
+    uint32_t const startPos = m_routeStartPos[routeIdx];
+    m_routeStartPos[routeIdx] = kNoIdx;
+
+    uint32_t tripIdx = kNoIdx;
+    uint32_t boardPos = kNoIdx;
+    for (uint32_t pos = startPos; pos < route.m_stopIdxs.size(); ++pos)
+    {
+      uint32_t const stopIdx = route.m_stopIdxs[pos];
+      DayTime const offset = route.m_offsets[pos];
+
+      if (tripIdx != kNoIdx)
+      {
+        Label label;
+        label.m_arrival = departures[tripIdx] + offset;
+        label.m_type = Label::Type::Ride;
+        label.m_fromStopIdx = route.m_stopIdxs[boardPos];
+        label.m_routeIdx = routeIdx;
+        label.m_tripIdx = tripIdx;
+        label.m_boardPos = boardPos;
+        UpdateLabel(round, stopIdx, label);
+      }
+
+      auto const & prevLabel = prevLabels[stopIdx];
+      if (prevLabel.m_arrival == kInfDayTime)
+        continue;
+
+      // A vehicle is changed at the same stop not faster than |minTransferTime|.
+      DayTime const ready =
+          prevLabel.m_arrival + (prevLabel.m_type == Label::Type::Ride ? minTransferTime : 0);
+      if (tripIdx != kNoIdx && departures[tripIdx] + offset <= ready)
+        continue;
+
+      // The earliest trip which departs from the stop not earlier than |ready|.
+      DayTime const minDeparture = ready > offset ? ready - offset : 0;
+      auto const it = std::lower_bound(departures.begin(), departures.end(), minDeparture);
+      auto const earliestTripIdx = static_cast<uint32_t>(std::distance(departures.begin(), it));
+      if (earliestTripIdx < std::min(tripIdx, static_cast<uint32_t>(departures.size())))
+      {
+        tripIdx = earliestTripIdx;
+        boardPos = pos;
+      }
+    }
+  }
+}
+
+void RaptorRouter::ScanFootpaths(size_t round)
+{
+  auto & labels = m_labels[round];
+  // Footpaths are not chained, so only the stops reached by rides (or access) are scanned.
+  size_t const markedNumber = m_markedStops.size();
+  for (size_t i = 0; i < markedNumber; ++i)
+  {
+    uint32_t const stopIdx = m_markedStops[i];
+    if (labels[stopIdx].m_type == Label::Type::Walk)
+      continue;
+
+    DayTime const arrival = labels[stopIdx].m_arrival;
+    for (auto const & footpath : m_timetable.GetFootpaths(stopIdx))
+    {
+      Label label;
+      label.m_arrival = arrival + footpath.m_timeS;
+      label.m_type = Label::Type::Walk;
+      label.m_fromStopIdx = stopIdx;
+      UpdateLabel(round, footpath.m_stopIdx, label);
+    }
+  }
+}
+
+bool RaptorRouter::UpdateLabel(size_t round, uint32_t stopIdx, Label const & label)
+{
+  // Local and target pruning.
+  if (label.m_arrival >= std::min(m_bestArrivals[stopIdx], m_bestTargetArrival))
+    return false;
+
+  m_labels[round][stopIdx] = label;
+  m_bestArrivals[stopIdx] = label.m_arrival;
+  if (!m_isMarked[stopIdx])
+  {
+    m_isMarked[stopIdx] = true;
+    m_markedStops.push_back(stopIdx);
+  }
+  return true;
+}
+
+Journey RaptorRouter::MakeJourney(size_t round, Target const & target, DayTime departure) const
+{
+  auto const & routes = m_timetable.GetRoutes();
+
+  Journey journey;
+  journey.m_departure = departure;
+  journey.m_arrival = m_labels[round][target.m_stopIdx].m_arrival + target.m_timeS;
+
+  uint32_t stopIdx = target.m_stopIdx;
+  while (true)
+  {
+    auto const & label = m_labels[round][stopIdx];
+    CHECK(label.m_type != Label::Type::None, (round, stopIdx));
+    if (label.m_type == Label::Type::Access)
+      break;
+
+    JourneyLeg leg;
+    leg.m_fromStopId = m_timetable.GetStopId(label.m_fromStopIdx);
+    leg.m_toStopId = m_timetable.GetStopId(stopIdx);
+    leg.m_arrival = label.m_arrival;
+    if (label.m_type == Label::Type::Walk)
+    {
+      leg.m_type = JourneyLeg::Type::Walk;
+      leg.m_departure = m_labels[round][label.m_fromStopIdx].m_arrival;
+    }
+    else
+    {
+      auto const & route = routes[label.m_routeIdx];
+      leg.m_type = JourneyLeg::Type::Ride;
+      leg.m_lineId = route.m_lineId;
+      leg.m_departure = route.m_departures[label.m_tripIdx] + route.m_offsets[label.m_boardPos];
+      CHECK_GREATER(round, 0, ());
+      --round;
+    }
+
+    journey.m_legs.push_back(leg);
+    stopIdx = label.m_fromStopIdx;
+  }
+
+  std::reverse(journey.m_legs.begin(), journey.m_legs.end());
+  return journey;
+}
+
+std::string DebugPrint(JourneyLeg::Type type)
+{
+  switch (type)
+  {
+  case JourneyLeg::Type::Ride: return "Ride";
+  case JourneyLeg::Type::Walk: return "Walk";
+  }
+  UNREACHABLE();
+}
+
+std::string DebugPrint(JourneyLeg const & leg)
+{
+  std::ostringstream out;
+  out << "JourneyLeg [ type: " << DebugPrint(leg.m_type) << ", line: " << leg.m_lineId
+      << ", from: " << leg.m_fromStopId << ", to: " << leg.m_toStopId
+      << ", departure: " << leg.m_departure << ", arrival: " << leg.m_arrival << " ]";
+  return out.str();
+}
+
+std::string DebugPrint(Journey const & journey)
+{
+  std::ostringstream out;
+  out << "Journey [ departure: " << journey.m_departure << ", arrival: " << journey.m_arrival
+      << ", legs: " << ::DebugPrint(journey.m_legs) << " ]";
+  return out.str();
+}
+}  // namespace experimental
+}  // namespace transit
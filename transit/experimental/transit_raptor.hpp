@@ -0,0 +1,226 @@
+#pragma once
+
+#include "transit/experimental/transit_data.hpp"
+#include "transit/experimental/transit_types_experimental.hpp"
+#include "transit/transit_entities.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace transit
+{
+namespace experimental
+{
+/// Seconds since the start of the service day.
+using DayTime = uint32_t;
+DayTime constexpr kInfDayTime = std::numeric_limits<DayTime>::max();
+
+/// Timetable of one service day prepared for RAPTOR (D. Delling, T. Pajor, R. Werneck
+/// "Round-Based Public Transit Routing").
+/// Lines are expanded into trips by their frequency intervals for the service day. All the trips
+/// of a line have the same travel times between stops (edge weights), so a line is stored as
+/// a route: the stops pattern, the offsets of the stops from the first one and the sorted
+/// departures from the first stop.
+/// Footpaths connect stops of the same transfer and the stops which are close to each other.
+class Timetable
+{
+public:
+  struct Params
+  {
+    // Stops which are closer than this distance are connected by footpaths.
+    double m_maxFootpathDistanceM = 300.0;
+    double m_pedestrianSpeedMpS = 1.2;
+    // Min time to change a vehicle. It is the min time of footpaths too.
+    DayTime m_minTransferTimeS = 60;
+  };
+
+  /// \returns the walking time from |from| to |to| in seconds or nullopt if there is no
+  /// pedestrian route between them. It allows to take footpaths from the pedestrian road graph,
+  /// the straight line distance is used by default.
+  using WalkTimeFn = std::function<std::optional<DayTime>(Stop const & from, Stop const & to)>;
+
+  struct Route
+  {
+    TransitId m_lineId = kInvalidTransitId;
+    std::vector<uint32_t> m_stopIdxs;
+    // Travel times from the first stop to the stops.
+    std::vector<DayTime> m_offsets;
+    // Sorted departures of the trips from the first stop.
+    std::vector<DayTime> m_departures;
+  };
+
+  struct RouteStop
+  {
+    uint32_t m_routeIdx = 0;
+    // Position of the stop in the route.
+    uint32_t m_pos = 0;
+  };
+
+  struct Footpath
+  {
+    uint32_t m_stopIdx = 0;
+    DayTime m_timeS = 0;
+  };
+
+  /// |serviceDay| is the start of the service day in local time.
+  Timetable(TransitData const & data, time_t serviceDay, Params const & params,
+            WalkTimeFn const & walkTimeFn = {});
+  Timetable(std::vector<Stop> const & stops, std::vector<Line> const & lines,
+            std::vector<Edge> const & edges, std::vector<Transfer> const & transfers,
+            time_t serviceDay, Params const & params, WalkTimeFn const & walkTimeFn = {});
+
+  size_t GetStopsCount() const { return m_stopIds.size(); }
+  std::optional<uint32_t> GetStopIdx(TransitId stopId) const;
+  TransitId GetStopId(uint32_t stopIdx) const;
+
+  std::vector<Route> const & GetRoutes() const { return m_routes; }
+  std::vector<RouteStop> const & GetRouteStops(uint32_t stopIdx) const;
+  std::vector<Footpath> const & GetFootpaths(uint32_t stopIdx) const;
+
+  DayTime GetMinTransferTime() const { return m_minTransferTimeS; }
+  size_t GetTripsCount() const;
+  size_t GetFootpathsCount() const;
+
+private:
+  void AddRoutes(std::vector<Line> const & lines, std::vector<Edge> const & edges,
+                 time_t serviceDay);
+  void AddFootpaths(std::vector<Stop> const & stops, std::vector<Transfer> const & transfers,
+                    Params const & params, WalkTimeFn const & walkTimeFn);
+
+  std::vector<TransitId> m_stopIds;
+  std::unordered_map<TransitId, uint32_t> m_stopIdToIdx;
+
+  std::vector<Route> m_routes;
+  std::vector<std::vector<RouteStop>> m_stopRoutes;
+  std::vector<std::vector<Footpath>> m_footpaths;
+
+  DayTime m_minTransferTimeS = 0;
+};
+
+/// Walking time between the origin (destination) and a stop.
+struct StopAccess
+{
+  TransitId m_stopId = kInvalidTransitId;
+  DayTime m_timeS = 0;
+};
+
+struct JourneyLeg
+{
+  enum class Type
+  {
+    Ride,
+    Walk
+  };
+
+  Type m_type = Type::Ride;
+  // Line of the ride leg.
+  TransitId m_lineId = kInvalidTransitId;
+  TransitId m_fromStopId = kInvalidTransitId;
+  TransitId m_toStopId = kInvalidTransitId;
+  DayTime m_departure = 0;
+  DayTime m_arrival = 0;
+};
+
+struct Journey
+{
+  size_t GetTransfersNumber() const;
+
+  // Departure from the origin and arrival at the destination including access and egress times.
+  DayTime m_departure = 0;
+  DayTime m_arrival = kInfDayTime;
+  std::vector<JourneyLeg> m_legs;
+};
+
+/// Round-based public transit router. Round k finds the earliest arrivals at the stops with
+/// k rides, so the journeys with different numbers of transfers are found at once.
+/// Profile queries are answered by rRAPTOR: the departures are scanned from the latest one and
+/// the labels are kept between them.
+/// \note The router keeps the query state, use one router per thread.
+class RaptorRouter
+{
+public:
+  RaptorRouter(Timetable const & timetable, size_t maxTransfersNumber);
+
+  /// \returns Pareto-optimal journeys by arrival time and transfers number departing from
+  /// the origin at |departure| in the order of transfers number increase.
+  std::vector<Journey> FindEarliestArrival(std::vector<StopAccess> const & sources,
+                                           std::vector<StopAccess> const & targets,
+                                           DayTime departure);
+
+  /// \returns the fastest journeys departing from the origin in [|from|, |to|] such that there
+  /// is no journey departing later and arriving not later. Journeys are sorted by departure.
+  std::vector<Journey> FindProfile(std::vector<StopAccess> const & sources,
+                                   std::vector<StopAccess> const & targets, DayTime from,
+                                   DayTime to);
+
+  /// \returns the number of route scans since the router creation.
+  uint64_t GetScannedRoutesCount() const { return m_scannedRoutesCount; }
+
+private:
+  static uint32_t constexpr kNoIdx = std::numeric_limits<uint32_t>::max();
+
+  struct Label
+  {
+    enum class Type : uint8_t
+    {
+      None,
+      Access,
+      Ride,
+      Walk
+    };
+
+    DayTime m_arrival = kInfDayTime;
+    Type m_type = Type::None;
+    // Boarding stop of the ride or the start stop of the walk.
+    uint32_t m_fromStopIdx = kNoIdx;
+    uint32_t m_routeIdx = kNoIdx;
+    uint32_t m_tripIdx = kNoIdx;
+    uint32_t m_boardPos = kNoIdx;
+  };
+
+  struct Target
+  {
+    uint32_t m_stopIdx = 0;
+    DayTime m_timeS = 0;
+  };
+
+  void Reset();
+  std::vector<Target> GetTargets(std::vector<StopAccess> const & targets) const;
+  // Runs RAPTOR rounds for |departure| on top of the current labels and calls |fn| with every
+  // improved journey.
+  template <typename Fn>
+  void Run(std::vector<StopAccess> const & sources, std::vector<Target> const & targets,
+           DayTime departure, Fn && fn);
+  void ScanRoutes(size_t round);
+  void ScanFootpaths(size_t round);
+  bool UpdateLabel(size_t round, uint32_t stopIdx, Label const & label);
+  Journey MakeJourney(size_t round, Target const & target, DayTime departure) const;
+
+  Timetable const & m_timetable;
+  size_t const m_maxRoundsNumber;
+
+  // Labels of the stops by rounds. Round 0 labels are the origin access.
+  std::vector<std::vector<Label>> m_labels;
+  std::vector<DayTime> m_bestArrivals;
+  DayTime m_bestTargetArrival = kInfDayTime;
+
+  std::vector<bool> m_isMarked;
+  std::vector<uint32_t> m_markedStops;
+  std::vector<uint32_t> m_routeStartPos;
+  std::vector<uint32_t> m_markedRoutes;
+
+  uint64_t m_scannedRoutesCount = 0;
+};
+
+std::string DebugPrint(JourneyLeg::Type type);
+std::string DebugPrint(JourneyLeg const & leg);
+std::string DebugPrint(Journey const & journey);
+}  // namespace experimental
+}  // namespace transit
@@ -0,0 +1,243 @@
+#include "transit/experimental/transit_data.hpp"
+#include "transit/experimental/transit_raptor.hpp"
+#include "transit/experimental/transit_types_experimental.hpp"
+#include "transit/transit_schedule.hpp"
+
+#include "platform/platform.hpp"
+
+#include "geometry/mercator.hpp"
+
+#include "base/assert.hpp"
+#include "base/file_name_utils.hpp"
+#include "base/logging.hpp"
+#include "base/timer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gflags/gflags.h>
+
+DEFINE_string(path_json, "",
+              "Optional. Directory with transit json files produced by gtfs_converter. "
+              "The synthetic grid feed is used if it is not set.");
+DEFINE_string(date, "", "Optional. Service day in YYYYMMDD format, today by default.");
+DEFINE_uint64(grid_size, 20, "Number of rows and columns of the synthetic grid feed.");
+DEFINE_uint64(queries, 1000, "Number of random queries.");
+DEFINE_uint64(seed, 42, "Seed of the random queries.");
+DEFINE_uint64(departure_hour, 8, "Departure hour of the earliest arrival queries.");
+DEFINE_uint64(profile_window_min, 60, "Departure window of the profile queries in minutes.");
+DEFINE_uint64(max_transfers, 5, "Max number of transfers.");
+
+namespace
+{
+using namespace transit;
+using namespace transit::experimental;
+
+time_t GetServiceDay(std::string const & date)
+{
+  std::tm tm = {};
+  if (date.empty())
+  {
+    time_t const now = time(nullptr);
+    localtime_r(&now, &tm);
+  }
+  else
+  {
+    CHECK_EQUAL(date.size(), 8, ("Bad date", date));
+    tm.tm_year = std::stoi(date.substr(0, 4)) - 1900;
+    tm.tm_mon = std::stoi(date.substr(4, 2)) - 1;
+    tm.tm_mday = std::stoi(date.substr(6));
+  }
+
+  tm.tm_hour = 0;
+  tm.tm_min = 0;
+  tm.tm_sec = 0;
+  tm.tm_isdst = -1;
+  return mktime(&tm);
+}
+
+struct Feed
+{
+  std::vector<Stop> m_stops;
+  std::vector<Line> m_lines;
+  std::vector<Edge> m_edges;
+  std::vector<Transfer> m_transfers;
+};
+
+// Metro-like grid: stops are 400 meters from each other, every row and column is served by lines
+// in both directions every 5 minutes all the day. Lines cross at the shared stops.
+Feed MakeGridFeed(uint32_t gridSize)
+{
+  CHECK_GREATER(gridSize, 1, ());
+  DayTime constexpr kEdgeTimeS = 90;
+  Frequency constexpr kHeadwayS = 300;
+  double constexpr kStepM = 400.0;
+
+  Schedule schedule;
+  schedule.SetDefaultFrequency(kHeadwayS);
+
+  Feed feed;
+  auto const getStopId = [gridSize](uint32_t row, uint32_t col) { return row * gridSize + col + 1; };
+  m2::PointD const origin = mercator::FromLatLon(55.75, 37.6);
+  double const step = mercator::RectByCenterXYAndSizeInMeters(origin, kStepM).SizeX() / 2;
+  for (uint32_t row = 0; row < gridSize; ++row)
+  {
+    for (uint32_t col = 0; col < gridSize; ++col)
+    {
+      feed.m_stops.emplace_back(getStopId(row, col), kInvalidFeatureId, kInvalidOsmId,
+                                "" /* title */, TimeTable{},
+                                origin + m2::PointD(col * step, row * step), IdList{});
+    }
+  }
+
+  TransitId lineId = 1;
+  auto const addLine = [&](IdList const & stopIds) {
+    for (size_t i = 0; i + 1 < stopIds.size(); ++i)
+    {
+      feed.m_edges.emplace_back(stopIds[i], stopIds[i + 1], kEdgeTimeS, lineId,
+                                false /* transfer */, ShapeLink());
+    }
+    feed.m_lines.emplace_back(lineId, 1 /* routeId */, ShapeLink(), "" /* title */, stopIds,
+                              schedule);
+    ++lineId;
+  };
+
+  for (uint32_t i = 0; i < gridSize; ++i)
+  {
+    IdList rowStops;
+    IdList colStops;
+    for (uint32_t j = 0; j < gridSize; ++j)
+    {
+      rowStops.push_back(getStopId(i, j));
+      colStops.push_back(getStopId(j, i));
+    }
+
+    addLine(rowStops);
+    addLine(colStops);
+    std::reverse(rowStops.begin(), rowStops.end());
+    std::reverse(colStops.begin(), colStops.end());
+    addLine(rowStops);
+    addLine(colStops);
+  }
+
+  return feed;
+}
+
+double GetPercentile(std::vector<double> values, double p)
+{
+  if (values.empty())
+    return 0.0;
+
+  std::sort(values.begin(), values.end());
+  return values[std::min(values.size() - 1, static_cast<size_t>(p * values.size()))];
+}
+
+void PrintTimes(std::string const & name, std::vector<double> const & timesMs)
+{
+  double sum = 0.0;
+  for (auto const t : timesMs)
+    sum += t;
+
+  std::cout << std::fixed << std::setprecision(3) << name << ": avg "
+            << (timesMs.empty() ? 0.0 : sum / timesMs.size()) << " ms, p50 "
+            << GetPercentile(timesMs, 0.5) << " ms, p95 " << GetPercentile(timesMs, 0.95)
+            << " ms, max " << GetPercentile(timesMs, 1.0) << " ms" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  gflags::SetUsageMessage("Benchmark of the schedule-based public transit router.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  auto const toolName = base::FileNameFromFullPath(argv[0]);
+
+  if (!FLAGS_path_json.empty() && !Platform::IsDirectory(FLAGS_path_json))
+  {
+    LOG(LWARNING, ("Directory with transit json files doesn't exist:", FLAGS_path_json));
+    gflags::ShowUsageWithFlagsRestrict(argv[0], toolName.c_str());
+    return EXIT_FAILURE;
+  }
+
+  time_t const serviceDay = GetServiceDay(FLAGS_date);
+
+  base::Timer timer;
+  TransitData data;
+  Feed feed;
+  if (FLAGS_path_json.empty())
+  {
+    feed = MakeGridFeed(static_cast<uint32_t>(FLAGS_grid_size));
+  }
+  else
+  {
+    data.DeserializeFromJson(FLAGS_path_json, OsmIdToFeatureIdsMap());
+    feed.m_stops = data.GetStops();
+    feed.m_lines = data.GetLines();
+    feed.m_edges = data.GetEdges();
+    feed.m_transfers = data.GetTransfers();
+  }
+  LOG(LINFO, ("Feed is loaded in", timer.ElapsedSeconds(), "seconds."));
+
+  timer.Reset();
+  Timetable const timetable(feed.m_stops, feed.m_lines, feed.m_edges, feed.m_transfers, serviceDay,
+                            Timetable::Params());
+  LOG(LINFO, ("Timetable is built in", timer.ElapsedSeconds(), "seconds."));
+
+  // Queries are between the stops which are served by the lines.
+  std::vector<TransitId> stopIds;
+  for (uint32_t stopIdx = 0; stopIdx < timetable.GetStopsCount(); ++stopIdx)
+  {
+    if (!timetable.GetRouteStops(stopIdx).empty())
+      stopIds.push_back(timetable.GetStopId(stopIdx));
+  }
+
+  if (stopIds.size() < 2)
+  {
+    LOG(LWARNING, ("There is no service on the day."));
+    return EXIT_FAILURE;
+  }
+
+  std::mt19937 rnd(static_cast<std::mt19937::result_type>(FLAGS_seed));
+  std::uniform_int_distribution<size_t> stopDist(0, stopIds.size() - 1);
+
+  RaptorRouter router(timetable, FLAGS_max_transfers);
+  DayTime const departure = static_cast<DayTime>(FLAGS_departure_hour * 60 * 60);
+  DayTime const window = static_cast<DayTime>(FLAGS_profile_window_min * 60);
+
+  std::vector<double> earliestArrivalTimesMs;
+  std::vector<double> profileTimesMs;
+  uint64_t foundCount = 0;
+  uint64_t profileJourneysCount = 0;
+  for (uint64_t i = 0; i < FLAGS_queries; ++i)
+  {
+    std::vector<StopAccess> const sources = {{stopIds[stopDist(rnd)], 0 /* timeS */}};
+    std::vector<StopAccess> const targets = {{stopIds[stopDist(rnd)], 0 /* timeS */}};
+
+    timer.Reset();
+    auto const journeys = router.FindEarliestArrival(sources, targets, departure);
+    earliestArrivalTimesMs.push_back(timer.ElapsedSeconds() * 1000.0);
+    if (!journeys.empty())
+      ++foundCount;
+
+    timer.Reset();
+    auto const profile = router.FindProfile(sources, targets, departure, departure + window);
+    profileTimesMs.push_back(timer.ElapsedSeconds() * 1000.0);
+    profileJourneysCount += profile.size();
+  }
+
+  std::cout << "Stops: " << timetable.GetStopsCount() << ", routes: " << timetable.GetRoutes().size()
+            << ", trips: " << timetable.GetTripsCount()
+            << ", footpaths: " << timetable.GetFootpathsCount() << std::endl;
+  std::cout << "Queries: " << FLAGS_queries << ", found: " << foundCount
+            << ", profile journeys: " << profileJourneysCount
+            << ", scanned routes: " << router.GetScannedRoutesCount() << std::endl;
+  PrintTimes("Earliest arrival", earliestArrivalTimesMs);
+  PrintTimes("Profile", profileTimesMs);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,192 @@
+#include "testing/testing.hpp"
+
+#include "transit/experimental/transit_raptor.hpp"
+#include "transit/experimental/transit_types_experimental.hpp"
+#include "transit/transit_schedule.hpp"
+
+#include "geometry/point2d.hpp"
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "3party/just_gtfs/just_gtfs.h"
+
+namespace transit_raptor_tests
+{
+using namespace ::transit;
+using namespace ::transit::experimental;
+
+DayTime constexpr kHour = 60 * 60;
+DayTime constexpr kMinute = 60;
+
+// Local midnight of 11th of November.
+time_t GetServiceDay(int year)
+{
+  std::tm tm = {};
+  tm.tm_year = year - 1900;
+  tm.tm_mon = 10;
+  tm.tm_mday = 11;
+  tm.tm_isdst = -1;
+  return mktime(&tm);
+}
+
+// Every day in 2020 from 07:00 to 09:00 with |headwayS|.
+Schedule GetSchedule(Frequency headwayS)
+{
+  gtfs::CalendarItem calendarItem;
+  calendarItem.start_date = gtfs::Date("20200101");
+  calendarItem.end_date = gtfs::Date("20201231");
+  calendarItem.monday = gtfs::CalendarAvailability::Available;
+  calendarItem.tuesday = gtfs::CalendarAvailability::Available;
+  calendarItem.wednesday = gtfs::CalendarAvailability::Available;
+  calendarItem.thursday = gtfs::CalendarAvailability::Available;
+  calendarItem.friday = gtfs::CalendarAvailability::Available;
+  calendarItem.saturday = gtfs::CalendarAvailability::Available;
+  calendarItem.sunday = gtfs::CalendarAvailability::Available;
+
+  gtfs::Frequency frequency;
+  frequency.start_time = gtfs::Time("07:00:00");
+  frequency.end_time = gtfs::Time("09:00:00");
+  frequency.headway_secs = headwayS;
+
+  Schedule schedule;
+  schedule.AddDatesInterval(calendarItem, gtfs::Frequencies{frequency});
+  return schedule;
+}
+
+Stop MakeStop(TransitId id, m2::PointD const & point)
+{
+  return Stop(id, kInvalidFeatureId, kInvalidOsmId, "" /* title */, TimeTable{}, point,
+              {} /* transferIds */);
+}
+
+Edge MakeEdge(TransitId stop1Id, TransitId stop2Id, EdgeWeight weight, TransitId lineId)
+{
+  return Edge(stop1Id, stop2Id, weight, lineId, false /* transfer */, ShapeLink());
+}
+
+// Slow line 10 goes 1 -> 2 -> 3 -> 4 every 10 minutes, each edge takes 5 minutes.
+// Express line 20 goes 5 -> 6 -> 4 every 5 minutes, each edge takes 1 minute.
+// Stops 2 and 5 are the same transfer. Other stops are more than 1 km far from each other.
+Timetable MakeTimetable(time_t serviceDay)
+{
+  std::vector<Stop> const stops = {MakeStop(1, {0.0, 0.0}),     MakeStop(2, {0.01, 0.0}),
+                                   MakeStop(3, {0.02, 0.0}),    MakeStop(4, {0.03, 0.0}),
+                                   MakeStop(5, {0.01, 0.0005}), MakeStop(6, {0.02, 0.02})};
+
+  std::vector<Line> const lines = {
+      Line(10 /* id */, 100 /* routeId */, ShapeLink(), "slow" /* title */, IdList{1, 2, 3, 4},
+           GetSchedule(10 * kMinute)),
+      Line(20 /* id */, 100 /* routeId */, ShapeLink(), "express" /* title */, IdList{5, 6, 4},
+           GetSchedule(5 * kMinute))};
+
+  std::vector<Edge> const edges = {MakeEdge(1, 2, 5 * kMinute, 10), MakeEdge(2, 3, 5 * kMinute, 10),
+                                   MakeEdge(3, 4, 5 * kMinute, 10), MakeEdge(5, 6, kMinute, 20),
+                                   MakeEdge(6, 4, kMinute, 20)};
+
+  std::vector<Transfer> const transfers = {Transfer(30 /* id */, {0.01, 0.0}, IdList{2, 5})};
+
+  return Timetable(stops, lines, edges, transfers, serviceDay, Timetable::Params());
+}
+
+UNIT_TEST(Raptor_Timetable)
+{
+  auto const timetable = MakeTimetable(GetServiceDay(2020));
+
+  TEST_EQUAL(timetable.GetStopsCount(), 6, ());
+  TEST_EQUAL(timetable.GetRoutes().size(), 2, ());
+  // 07:00 - 09:00 every 10 and 5 minutes.
+  TEST_EQUAL(timetable.GetTripsCount(), 13 + 25, ());
+  TEST_EQUAL(timetable.GetRoutes()[0].m_offsets, std::vector<DayTime>({0, 300, 600, 900}), ());
+
+  auto const stopIdx2 = timetable.GetStopIdx(2);
+  auto const stopIdx5 = timetable.GetStopIdx(5);
+  TEST(stopIdx2 && stopIdx5, ());
+  auto const & footpaths = timetable.GetFootpaths(*stopIdx2);
+  TEST_EQUAL(footpaths.size(), 1, ());
+  TEST_EQUAL(footpaths[0].m_stopIdx, *stopIdx5, ());
+  // Walking time is less than the min transfer time.
+  TEST_EQUAL(footpaths[0].m_timeS, timetable.GetMinTransferTime(), ());
+  TEST(timetable.GetFootpaths(*timetable.GetStopIdx(1)).empty(), ());
+}
+
+UNIT_TEST(Raptor_EarliestArrival)
+{
+  auto const timetable = MakeTimetable(GetServiceDay(2020));
+  RaptorRouter router(timetable, 5 /* maxTransfersNumber */);
+
+  auto const journeys =
+      router.FindEarliestArrival({{1, 0}} /* sources */, {{4, 0}} /* targets */, 7 * kHour);
+  TEST_EQUAL(journeys.size(), 2, (journeys));
+
+  // Direct ride by the slow line.
+  TEST_EQUAL(journeys[0].GetTransfersNumber(), 0, ());
+  TEST_EQUAL(journeys[0].m_arrival, 7 * kHour + 15 * kMinute, ());
+  TEST_EQUAL(journeys[0].m_legs.size(), 1, ());
+  TEST_EQUAL(journeys[0].m_legs[0].m_lineId, 10, ());
+
+  // Change to the express line at 07:06, it departs at 07:10.
+  auto const & journey = journeys[1];
+  TEST_EQUAL(journey.GetTransfersNumber(), 1, ());
+  TEST_EQUAL(journey.m_departure, 7 * kHour, ());
+  TEST_EQUAL(journey.m_arrival, 7 * kHour + 12 * kMinute, ());
+  TEST_EQUAL(journey.m_legs.size(), 3, ());
+
+  TEST_EQUAL(journey.m_legs[0].m_type, JourneyLeg::Type::Ride, ());
+  TEST_EQUAL(journey.m_legs[0].m_lineId, 10, ());
+  TEST_EQUAL(journey.m_legs[0].m_fromStopId, 1, ());
+  TEST_EQUAL(journey.m_legs[0].m_toStopId, 2, ());
+  TEST_EQUAL(journey.m_legs[0].m_arrival, 7 * kHour + 5 * kMinute, ());
+
+  TEST_EQUAL(journey.m_legs[1].m_type, JourneyLeg::Type::Walk, ());
+  TEST_EQUAL(journey.m_legs[1].m_toStopId, 5, ());
+  TEST_EQUAL(journey.m_legs[1].m_arrival, 7 * kHour + 6 * kMinute, ());
+
+  TEST_EQUAL(journey.m_legs[2].m_lineId, 20, ());
+  TEST_EQUAL(journey.m_legs[2].m_departure, 7 * kHour + 10 * kMinute, ());
+  TEST_EQUAL(journey.m_legs[2].m_toStopId, 4, ());
+
+  // Transfers are prohibited.
+  RaptorRouter directRouter(timetable, 0 /* maxTransfersNumber */);
+  auto const direct =
+      directRouter.FindEarliestArrival({{1, 0}} /* sources */, {{4, 0}} /* targets */, 7 * kHour);
+  TEST_EQUAL(direct.size(), 1, ());
+  TEST_EQUAL(direct[0].m_arrival, 7 * kHour + 15 * kMinute, ());
+
+  // Access and egress times are counted. The next trip from stop 1 departs at 07:10.
+  auto const late = router.FindEarliestArrival({{1, 2 * kMinute}} /* sources */,
+                                               {{4, kMinute}} /* targets */, 7 * kHour + kMinute);
+  TEST_EQUAL(late.back().m_arrival, 7 * kHour + 23 * kMinute, ());
+
+  // There are no trips after 09:00.
+  TEST(router.FindEarliestArrival({{1, 0}}, {{4, 0}}, 10 * kHour).empty(), ());
+}
+
+UNIT_TEST(Raptor_Profile)
+{
+  auto const timetable = MakeTimetable(GetServiceDay(2020));
+  RaptorRouter router(timetable, 5 /* maxTransfersNumber */);
+
+  auto const profile = router.FindProfile({{1, 0}} /* sources */, {{4, 0}} /* targets */,
+                                          7 * kHour, 7 * kHour + 30 * kMinute);
+  TEST_EQUAL(profile.size(), 4, (profile));
+  for (size_t i = 0; i < profile.size(); ++i)
+  {
+    DayTime const departure = 7 * kHour + static_cast<DayTime>(i) * 10 * kMinute;
+    TEST_EQUAL(profile[i].m_departure, departure, ());
+    TEST_EQUAL(profile[i].m_arrival, departure + 12 * kMinute, ());
+    TEST_EQUAL(profile[i].GetTransfersNumber(), 1, ());
+  }
+}
+
+UNIT_TEST(Raptor_NoService)
+{
+  // The lines do not run in 2021.
+  auto const timetable = MakeTimetable(GetServiceDay(2021));
+  TEST(timetable.GetRoutes().empty(), ());
+
+  RaptorRouter router(timetable, 5 /* maxTransfersNumber */);
+  TEST(router.FindEarliestArrival({{1, 0}}, {{4, 0}}, 7 * kHour).empty(), ());
+}
+}  // namespace transit_raptor_tests
@@ -230,6 +230,9 @@ public:
   Status GetStatus(time_t const & time) const;
   Frequency GetFrequency(time_t const & time) const;
   Frequency GetFrequency() const { return m_defaultFrequency; }
+  /// \returns frequency intervals of the service day of |time| or nullptr if there is no service
+  /// on this day.
+  FrequencyIntervals const * GetFrequencyIntervals(time_t const & time) const;
 
   DatesIntervals const & GetServiceIntervals() const;
   DatesExceptions const & GetServiceExceptions() const;